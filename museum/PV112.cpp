@@ -10,15 +10,24 @@
 
 #include <GL/freeglut.h>
 
+#include <cstddef>
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
 #include <memory>
 #include <sstream>
 #include <fstream>
 #include <iostream>
 
-#include "cube.inl"
-#include "sphere.inl"
-#include "teapot.inl"
-#include "rectangle.inl"
+#include "mappedfile.h"
+#include "objparser.h"
+#include "meshcache.h"
+#include "meshbuild.h"
+#include "meshtools.h"
+#include "geometrypool.h"
+#include "geometryarena.h"
+#include "vertexformat.h"
+#include "primitives.h"
 
 using namespace std;
 
@@ -198,9 +207,28 @@ PV112Geometry::PV112Geometry()
     VertexBuffers[2] = 0;
     IndexBuffer = 0;
     VAO = 0;
+    Layout = VertexLayout::Float;
+    SharedBuffers = false;
+    BaseVertex = 0;
+    BaseIndex = 0;
     Mode = GL_POINTS;
     DrawArraysCount = 0;
     DrawElementsCount = 0;
+    LODCount = 0;
+    for (int level = 0; level < MaxLODs; level++)
+    {
+        LODFirstIndex[level] = 0;
+        LODIndexCount[level] = 0;
+        LODError[level] = 0.0f;
+    }
+    PositionScale = glm::vec3(1.0f);
+    PositionOffset = glm::vec3(0.0f);
+    OctahedralNormals = false;
+    Box.Min = glm::vec3(0.0f);
+    Box.Max = glm::vec3(0.0f);
+    Sphere.Center = glm::vec3(0.0f);
+    Sphere.Radius = 0.0f;
+    Closed = false;
 }
 
 PV112Geometry::PV112Geometry(const PV112Geometry &rhs)
@@ -215,12 +243,93 @@ PV112Geometry &PV112Geometry::operator =(const PV112Geometry &rhs)
     VertexBuffers[2] = rhs.VertexBuffers[2];
     IndexBuffer = rhs.IndexBuffer;
     VAO = rhs.VAO;
+    Layout = rhs.Layout;
+    SharedBuffers = rhs.SharedBuffers;
+    BaseVertex = rhs.BaseVertex;
+    BaseIndex = rhs.BaseIndex;
     Mode = rhs.Mode;
     DrawArraysCount = rhs.DrawArraysCount;
     DrawElementsCount = rhs.DrawElementsCount;
+    LODCount = rhs.LODCount;
+    for (int level = 0; level < MaxLODs; level++)
+    {
+        LODFirstIndex[level] = rhs.LODFirstIndex[level];
+        LODIndexCount[level] = rhs.LODIndexCount[level];
+        LODError[level] = rhs.LODError[level];
+    }
+    PositionScale = rhs.PositionScale;
+    PositionOffset = rhs.PositionOffset;
+    OctahedralNormals = rhs.OctahedralNormals;
+    Box = rhs.Box;
+    Sphere = rhs.Sphere;
+    Meshlets = rhs.Meshlets;
+    Closed = rhs.Closed;
+    Submeshes = rhs.Submeshes;
+    Materials = rhs.Materials;
     return *this;
 }
 
+void ComputeBounds(const float *positions, size_t count, size_t stride, BoundingBox &out_box, BoundingSphere &out_sphere)
+{
+    out_box.Min = glm::vec3(0.0f);
+    out_box.Max = glm::vec3(0.0f);
+    for (size_t i = 0; i < count; i++)
+    {
+        const glm::vec3 position(positions[i * stride], positions[i * stride + 1], positions[i * stride + 2]);
+        out_box.Min = (i == 0) ? position : glm::min(out_box.Min, position);
+        out_box.Max = (i == 0) ? position : glm::max(out_box.Max, position);
+    }
+
+    // Compare squared distances, a single square root is enough
+    out_sphere.Center = (out_box.Min + out_box.Max) * 0.5f;
+    float max_distance2 = 0.0f;
+    for (size_t i = 0; i < count; i++)
+    {
+        const glm::vec3 offset = glm::vec3(positions[i * stride], positions[i * stride + 1], positions[i * stride + 2]) - out_sphere.Center;
+        max_distance2 = std::max(max_distance2, glm::dot(offset, offset));
+    }
+    out_sphere.Radius = std::sqrt(max_distance2);
+}
+
+BoundingBox TransformBoundingBox(const BoundingBox &box, const glm::mat4 &matrix)
+{
+    // Each coordinate of the result is a sum of the columns times the coordinates of the box, the extremes
+    // take the smaller or the larger product for each of them (Arvo)
+    BoundingBox result;
+    result.Min = glm::vec3(matrix[3]);
+    result.Max = glm::vec3(matrix[3]);
+    for (int column = 0; column < 3; column++)
+    {
+        const glm::vec3 a = glm::vec3(matrix[column]) * box.Min[column];
+        const glm::vec3 b = glm::vec3(matrix[column]) * box.Max[column];
+        result.Min += glm::min(a, b);
+        result.Max += glm::max(a, b);
+    }
+    return result;
+}
+
+BoundingSphere TransformBoundingSphere(const BoundingSphere &sphere, const glm::mat4 &matrix)
+{
+    const float scale2 = std::max(std::max(glm::dot(glm::vec3(matrix[0]), glm::vec3(matrix[0])),
+        glm::dot(glm::vec3(matrix[1]), glm::vec3(matrix[1]))), glm::dot(glm::vec3(matrix[2]), glm::vec3(matrix[2])));
+
+    BoundingSphere result;
+    result.Center = glm::vec3(matrix * glm::vec4(sphere.Center, 1.0f));
+    result.Radius = sphere.Radius * std::sqrt(scale2);
+    return result;
+}
+
+namespace
+{
+
+// Returns the offset of an index of the geometry in its index buffer, in bytes as glDrawElements takes it
+const void *IndexBufferOffset(const PV112Geometry &geom, GLsizei first_index)
+{
+    return (const void *)((size_t(geom.BaseIndex) + size_t(first_index)) * sizeof(unsigned int));
+}
+
+}
+
 void DeleteGeometry(PV112Geometry &geom)
 {
     // This is mostly an example of what should be destroyed and how. We won't be using it anywhere.
@@ -228,9 +337,13 @@ void DeleteGeometry(PV112Geometry &geom)
     // When using it, make sure the OpenGL context still exists (i.e. the main window still exists).
 
     // OpenGL silently ignores deleting objects that are 0, so this is safe even if the buffers were not created.
-    glDeleteBuffers(3, geom.VertexBuffers);
-    glDeleteBuffers(1, &geom.IndexBuffer);
-    glDeleteVertexArrays(1, &geom.VAO);
+    // The buffers of a geometry arena belong to the arena.
+    if (!geom.SharedBuffers)
+    {
+        glDeleteBuffers(3, geom.VertexBuffers);
+        glDeleteBuffers(1, &geom.IndexBuffer);
+        glDeleteVertexArrays(1, &geom.VAO);
+    }
 
     geom = PV112Geometry();        // Reset the state to 'no geometry'
 }
@@ -238,409 +351,592 @@ void DeleteGeometry(PV112Geometry &geom)
 void DrawGeometry(const PV112Geometry &geom)
 {
     if (geom.DrawArraysCount > 0)
-        glDrawArrays(geom.Mode, 0, geom.DrawArraysCount);
+        glDrawArrays(geom.Mode, geom.BaseVertex, geom.DrawArraysCount);
     if (geom.DrawElementsCount > 0)
-        glDrawElements(geom.Mode, geom.DrawElementsCount, GL_UNSIGNED_INT, nullptr);
+        glDrawElementsBaseVertex(geom.Mode, geom.DrawElementsCount, GL_UNSIGNED_INT, IndexBufferOffset(geom, 0), geom.BaseVertex);
 }
 
-//-----------------------------
-//----    BASIC OBJECTS    ----
-//-----------------------------
-
-PV112Geometry CreateCube(GLint position_location, GLint normal_location, GLint tex_coord_location)
+void DrawGeometryInstanced(const PV112Geometry &geom, GLsizei instance_count)
 {
-    PV112Geometry geometry;
+    if (geom.DrawArraysCount > 0)
+        glDrawArraysInstanced(geom.Mode, geom.BaseVertex, geom.DrawArraysCount, instance_count);
+    if (geom.DrawElementsCount > 0)
+        glDrawElementsInstancedBaseVertex(geom.Mode, geom.DrawElementsCount, GL_UNSIGNED_INT, IndexBufferOffset(geom, 0), instance_count,
+                geom.BaseVertex);
+}
 
-    // Create a single buffer for vertex data
-    glGenBuffers(1, &geometry.VertexBuffers[0]);
-    glBindBuffer(GL_ARRAY_BUFFER, geometry.VertexBuffers[0]);
-    glBufferData(GL_ARRAY_BUFFER, cube_vertices_count * sizeof(float) * 8, cube_vertices, GL_STATIC_DRAW);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+void SetVertexDecodeUniforms(const PV112Geometry &geom, GLint position_scale_location, GLint position_offset_location,
+        GLint octahedral_normal_location)
+{
+    if (position_scale_location >= 0)
+        glUniform3f(position_scale_location, geom.PositionScale.x, geom.PositionScale.y, geom.PositionScale.z);
+    if (position_offset_location >= 0)
+        glUniform3f(position_offset_location, geom.PositionOffset.x, geom.PositionOffset.y, geom.PositionOffset.z);
+    if (octahedral_normal_location >= 0)
+        glUniform1i(octahedral_normal_location, geom.OctahedralNormals ? 1 : 0);
+}
 
-    geometry.VertexBuffers[1] = 0;
-    geometry.VertexBuffers[2] = 0;
+void DrawGeometry(const PV112Geometry &geom, int lod)
+{
+    if (lod <= 0 || lod >= geom.LODCount)
+    {
+        DrawGeometry(geom);
+        return;
+    }
+    glDrawElementsBaseVertex(geom.Mode, geom.LODIndexCount[lod], GL_UNSIGNED_INT, IndexBufferOffset(geom, geom.LODFirstIndex[lod]),
+            geom.BaseVertex);
+}
 
-    // Create a buffer for indices
-    glGenBuffers(1, &geometry.IndexBuffer);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, geometry.IndexBuffer);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, cube_indices_count * sizeof(unsigned int), cube_indices, GL_STATIC_DRAW);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+void DrawSubmesh(const PV112Geometry &geom, size_t submesh, int lod)
+{
+    if (submesh >= geom.Submeshes.size())
+        return;
+    if (lod < 0 || lod >= geom.LODCount)
+        lod = 0;
+    const GeometrySubmesh &range = geom.Submeshes[submesh];
+    glDrawElementsBaseVertex(geom.Mode, range.IndexCount[lod], GL_UNSIGNED_INT, IndexBufferOffset(geom, range.FirstIndex[lod]), geom.BaseVertex);
+}
 
-    // Create a vertex array object for the geometry
-    glGenVertexArrays(1, &geometry.VAO);
+int SelectGeometryLOD(const PV112Geometry &geom, float distance, float scale, float projection_height, float max_pixels)
+{
+    // The levels are ordered from the finest, and their errors grow, take the last one that is still fine
+    const float pixels_per_unit = scale * projection_height / std::max(distance, 1e-4f);
+    int lod = 0;
+    while (lod + 1 < geom.LODCount && geom.LODError[lod + 1] * pixels_per_unit <= max_pixels)
+        lod++;
+    return lod;
+}
 
-    // Set the parameters of the geometry
-    glBindVertexArray(geometry.VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, geometry.VertexBuffers[0]);
-    if (position_location >= 0)
+GLsizei DrawGeometryMeshlets(const PV112Geometry &geom, const glm::mat4 &PVM_matrix, const glm::vec3 &eye_position)
+{
+    if (geom.Meshlets.empty())
     {
-        glEnableVertexAttribArray(position_location);
-        glVertexAttribPointer(position_location, 3, GL_FLOAT, GL_FALSE, sizeof(float) * 8, 0);
+        DrawGeometry(geom);
+        return geom.DrawElementsCount / 3;
     }
-    if (normal_location >= 0)
+
+    // Planes of the view frustum in model space, a point p is inside if dot(plane.xyz, p) + plane.w >= 0
+    // for all of them. They are sums and differences of the rows of the matrix (Gribb and Hartmann).
+    const glm::mat4 rows = glm::transpose(PVM_matrix);
+    glm::vec4 planes[6] = { rows[3] + rows[0], rows[3] - rows[0], rows[3] + rows[1], rows[3] - rows[1], rows[3] + rows[2], rows[3] - rows[2] };
+    for (glm::vec4 &plane : planes)
+        plane /= glm::length(glm::vec3(plane));
+
+    // Neighbouring visible meshlets are merged into a single range
+    std::vector<GLsizei> counts;
+    std::vector<const void *> offsets;
+    GLsizei triangles = 0;
+    size_t range_end = size_t(-1);
+    for (const Meshlet &meshlet : geom.Meshlets)
     {
-        glEnableVertexAttribArray(normal_location);
-        glVertexAttribPointer(normal_location, 3, GL_FLOAT, GL_FALSE, sizeof(float) * 8, (const void *)(sizeof(float) * 3));
+        const glm::vec4 center(meshlet.Center[0], meshlet.Center[1], meshlet.Center[2], 1.0f);
+        bool visible = !geom.Closed || !MeshletFacesAway(meshlet, eye_position);
+        for (int i = 0; visible && i < 6; i++)
+            visible = glm::dot(planes[i], center) >= -meshlet.Radius;
+        if (!visible)
+            continue;
+
+        triangles += GLsizei(meshlet.IndexCount / 3);
+        if (meshlet.FirstIndex == range_end)
+            counts.back() += GLsizei(meshlet.IndexCount);
+        else
+        {
+            counts.push_back(GLsizei(meshlet.IndexCount));
+            offsets.push_back(IndexBufferOffset(geom, GLsizei(meshlet.FirstIndex)));
+        }
+        range_end = size_t(meshlet.FirstIndex) + meshlet.IndexCount;
     }
-    if (tex_coord_location >= 0)
+
+    if (!counts.empty())
     {
-        glEnableVertexAttribArray(tex_coord_location);
-        glVertexAttribPointer(tex_coord_location, 2, GL_FLOAT, GL_FALSE, sizeof(float) * 8, (const void *)(sizeof(float) * 6));
+        std::vector<GLint> base_vertices(counts.size(), geom.BaseVertex);
+        glMultiDrawElementsBaseVertex(geom.Mode, counts.data(), GL_UNSIGNED_INT, offsets.data(), GLsizei(counts.size()),
+                base_vertices.data());
     }
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, geometry.IndexBuffer);
+    return triangles;
+}
 
-    glBindVertexArray(0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+//-----------------------------
+//----    BASIC OBJECTS    ----
+//-----------------------------
 
-    geometry.Mode = GL_TRIANGLES;
-    geometry.DrawArraysCount = 0;
-    geometry.DrawElementsCount = cube_indices_count;
+namespace
+{
 
-    return geometry;
+// SetVertexFormatAttributes of a format, the locations are those of the position, normal, and texture coordinate
+typedef void (*VertexAttributeSetter)(const GLint *locations);
+
+// The layout of a geometry is known only at run time, the attributes of each one are still set up by the
+// code the compiler generated for its format
+VertexAttributeSetter GetVertexAttributeSetter(VertexLayout layout)
+{
+    switch (layout)
+    {
+    case VertexLayout::Packed:      return SetVertexFormatAttributes<PackedVertexFormat>;
+    case VertexLayout::Quantized:   return SetVertexFormatAttributes<QuantizedVertexFormat>;
+    default:                        return SetVertexFormatAttributes<FloatVertexFormat>;
+    }
 }
 
-PV112Geometry CreateSphere(GLint position_location, GLint normal_location, GLint tex_coord_location)
+// Creates the buffers and the VAO of an indexed list of triangles. The buffers come from 'pool' if it is
+// not nullptr.
+PV112Geometry CreateIndexedGeometry(const void *vertex_data, size_t vertex_data_size, const unsigned int *indices, size_t index_count,
+        VertexAttributeSetter set_attributes, const GLint *locations, GLObjectPool *pool)
 {
     PV112Geometry geometry;
 
-    // Create a single buffer for vertex data
-    glGenBuffers(1, &geometry.VertexBuffers[0]);
-    glBindBuffer(GL_ARRAY_BUFFER, geometry.VertexBuffers[0]);
-    glBufferData(GL_ARRAY_BUFFER, sphere_vertices_count * sizeof(float) * 8, sphere_vertices, GL_STATIC_DRAW);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    // Create a single buffer for vertex data, a buffer for indices, and a vertex array object
+    if (pool != nullptr)
+    {
+        geometry.VertexBuffers[0] = pool->AcquireBuffer(GL_ARRAY_BUFFER, vertex_data_size, vertex_data);
+        geometry.IndexBuffer = pool->AcquireBuffer(GL_ELEMENT_ARRAY_BUFFER, index_count * sizeof(unsigned int), indices);
+        geometry.VAO = pool->AcquireVertexArray();
+    }
+    else
+    {
+        glGenBuffers(1, &geometry.VertexBuffers[0]);
+        glBindBuffer(GL_ARRAY_BUFFER, geometry.VertexBuffers[0]);
+        glBufferData(GL_ARRAY_BUFFER, vertex_data_size, vertex_data, GL_STATIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
 
-    geometry.VertexBuffers[1] = 0;
-    geometry.VertexBuffers[2] = 0;
+        glGenBuffers(1, &geometry.IndexBuffer);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, geometry.IndexBuffer);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, index_count * sizeof(unsigned int), indices, GL_STATIC_DRAW);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
-    // Create a buffer for indices
-    glGenBuffers(1, &geometry.IndexBuffer);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, geometry.IndexBuffer);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sphere_indices_count * sizeof(unsigned int), sphere_indices, GL_STATIC_DRAW);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        glGenVertexArrays(1, &geometry.VAO);
+    }
 
-    // Create a vertex array object for the geometry
-    glGenVertexArrays(1, &geometry.VAO);
+    geometry.VertexBuffers[1] = 0;
+    geometry.VertexBuffers[2] = 0;
 
     // Set the parameters of the geometry
     glBindVertexArray(geometry.VAO);
     glBindBuffer(GL_ARRAY_BUFFER, geometry.VertexBuffers[0]);
-    if (position_location >= 0)
-    {
-        glEnableVertexAttribArray(position_location);
-        glVertexAttribPointer(position_location, 3, GL_FLOAT, GL_FALSE, sizeof(float) * 8, 0);
-    }
-    if (normal_location >= 0)
-    {
-        glEnableVertexAttribArray(normal_location);
-        glVertexAttribPointer(normal_location, 3, GL_FLOAT, GL_FALSE, sizeof(float) * 8, (const void *)(sizeof(float) * 3));
-    }
-    if (tex_coord_location >= 0)
-    {
-        glEnableVertexAttribArray(tex_coord_location);
-        glVertexAttribPointer(tex_coord_location, 2, GL_FLOAT, GL_FALSE, sizeof(float) * 8, (const void *)(sizeof(float) * 6));
-    }
+    set_attributes(locations);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, geometry.IndexBuffer);
 
     glBindVertexArray(0);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
-    geometry.Mode = GL_TRIANGLE_STRIP;
+    geometry.Mode = GL_TRIANGLES;
     geometry.DrawArraysCount = 0;
-    geometry.DrawElementsCount = sphere_indices_count;
-
+    geometry.DrawElementsCount = GLsizei(index_count);
     return geometry;
 }
 
-PV112Geometry CreateTeapot(GLint position_location, GLint normal_location, GLint tex_coord_location)
+// The vertices of a basic object in 'layout', all of them are in the tables
+const void *GetPrimitiveVertices(const PrimitiveTables &tables, VertexLayout layout)
 {
-    PV112Geometry geometry;
+    switch (layout)
+    {
+    case VertexLayout::Packed:      return tables.PackedVertices;
+    case VertexLayout::Quantized:   return tables.QuantizedVertices;
+    default:                        return tables.Vertices;
+    }
+}
 
-    // Create a single buffer for vertex data
-    glGenBuffers(1, &geometry.VertexBuffers[0]);
-    glBindBuffer(GL_ARRAY_BUFFER, geometry.VertexBuffers[0]);
-    glBufferData(GL_ARRAY_BUFFER, teapot_vertices_count * sizeof(float) * 8, teapot_vertices, GL_STATIC_DRAW);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+// Sets the layout of a basic object, and for quantized vertices how the shader decodes them
+void SetPrimitiveLayout(PV112Geometry &geometry, const PrimitiveTables &tables, VertexLayout layout)
+{
+    geometry.Layout = layout;
+    if (layout == VertexLayout::Quantized)
+    {
+        const glm::vec3 bounds_min(tables.BoundsMin[0], tables.BoundsMin[1], tables.BoundsMin[2]);
+        const glm::vec3 bounds_max(tables.BoundsMax[0], tables.BoundsMax[1], tables.BoundsMax[2]);
+        geometry.PositionScale = bounds_max - bounds_min;
+        geometry.PositionOffset = bounds_min;
+        geometry.OctahedralNormals = true;
+    }
+}
 
-    geometry.VertexBuffers[1] = 0;
-    geometry.VertexBuffers[2] = 0;
+// Creates one of the basic objects of primitives.h. The tables are copied to OpenGL as they are, the
+// indices are already a list of triangles in the order for the vertex cache.
+PV112Geometry CreateBasicObject(const PrimitiveTables &tables, VertexLayout layout,
+        GLint position_location, GLint normal_location, GLint tex_coord_location)
+{
+    const GLint locations[] = { position_location, normal_location, tex_coord_location };
+    PV112Geometry geometry = CreateIndexedGeometry(GetPrimitiveVertices(tables, layout), tables.VertexCount * GetVertexLayoutSize(layout),
+            tables.Indices, tables.IndexCount, GetVertexAttributeSetter(layout), locations, nullptr);
+    SetPrimitiveLayout(geometry, tables, layout);
+    ComputeBounds(tables.Vertices, tables.VertexCount, 8, geometry.Box, geometry.Sphere);
+    return geometry;
+}
 
-    // Create a buffer for indices
-    glGenBuffers(1, &geometry.IndexBuffer);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, geometry.IndexBuffer);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, teapot_indices_count * sizeof(unsigned int), teapot_indices, GL_STATIC_DRAW);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
 
-    // Create a vertex array object for the geometry
-    glGenVertexArrays(1, &geometry.VAO);
+PV112Geometry CreateCube(GLint position_location, GLint normal_location, GLint tex_coord_location, VertexLayout layout)
+{
+    return CreateBasicObject(GetCubeTables(), layout, position_location, normal_location, tex_coord_location);
+}
 
-    // Set the parameters of the geometry
-    glBindVertexArray(geometry.VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, geometry.VertexBuffers[0]);
-    if (position_location >= 0)
-    {
-        glEnableVertexAttribArray(position_location);
-        glVertexAttribPointer(position_location, 3, GL_FLOAT, GL_FALSE, sizeof(float) * 8, 0);
-    }
-    if (normal_location >= 0)
+PV112Geometry CreateSphere(GLint position_location, GLint normal_location, GLint tex_coord_location, int tessellation,
+        VertexLayout layout)
+{
+    return CreateBasicObject(GetSphereTables(tessellation), layout, position_location, normal_location, tex_coord_location);
+}
+
+PV112Geometry CreateSphereLODs(GLint position_location, GLint normal_location, GLint tex_coord_location, VertexLayout layout)
+{
+    // The levels follow each other in both buffers from the finest one, the indices of each level are
+    // shifted past the vertices of the previous ones. All levels have the same bounds, so the quantized
+    // vertices of each of them decode the same way.
+    const size_t vertex_size = GetVertexLayoutSize(layout);
+    std::vector<unsigned char> vertices;
+    std::vector<unsigned int> indices;
+    GLsizei first_index[sphere_tessellation_levels], index_count[sphere_tessellation_levels];
+    float error[sphere_tessellation_levels];
+    for (int lod = 0; lod < sphere_tessellation_levels; lod++)
     {
-        glEnableVertexAttribArray(normal_location);
-        glVertexAttribPointer(normal_location, 3, GL_FLOAT, GL_FALSE, sizeof(float) * 8, (const void *)(sizeof(float) * 3));
+        const PrimitiveTables &tables = GetSphereTables(sphere_tessellation_levels - 1 - lod);
+        const unsigned char *level_vertices = static_cast<const unsigned char *>(GetPrimitiveVertices(tables, layout));
+        const unsigned int base_vertex = unsigned(vertices.size() / vertex_size);
+        first_index[lod] = GLsizei(indices.size());
+        index_count[lod] = GLsizei(tables.IndexCount);
+        error[lod] = tables.Error;
+        vertices.insert(vertices.end(), level_vertices, level_vertices + tables.VertexCount * vertex_size);
+        for (size_t i = 0; i < tables.IndexCount; i++)
+            indices.push_back(base_vertex + tables.Indices[i]);
     }
-    if (tex_coord_location >= 0)
+
+    const PrimitiveTables &finest = GetSphereTables(sphere_tessellation_levels - 1);
+    const GLint locations[] = { position_location, normal_location, tex_coord_location };
+    PV112Geometry geometry = CreateIndexedGeometry(vertices.data(), vertices.size(), indices.data(), indices.size(),
+            GetVertexAttributeSetter(layout), locations, nullptr);
+    SetPrimitiveLayout(geometry, finest, layout);
+    geometry.DrawElementsCount = index_count[0];
+    geometry.LODCount = std::min(sphere_tessellation_levels, int(PV112Geometry::MaxLODs));
+    for (int lod = 0; lod < geometry.LODCount; lod++)
     {
-        glEnableVertexAttribArray(tex_coord_location);
-        glVertexAttribPointer(tex_coord_location, 2, GL_FLOAT, GL_FALSE, sizeof(float) * 8, (const void *)(sizeof(float) * 6));
+        geometry.LODFirstIndex[lod] = first_index[lod];
+        geometry.LODIndexCount[lod] = index_count[lod];
+        geometry.LODError[lod] = error[lod];
     }
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, geometry.IndexBuffer);
-
-    glBindVertexArray(0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-
-    geometry.Mode = GL_TRIANGLE_STRIP;
-    geometry.DrawArraysCount = 0;
-    geometry.DrawElementsCount = teapot_indices_count;
-
+    // The vertices of every level are on the unit sphere, the finest one gives the bounds of all of them
+    ComputeBounds(finest.Vertices, finest.VertexCount, 8, geometry.Box, geometry.Sphere);
     return geometry;
 }
 
-PV112Geometry CreateRectangle(GLint position_location, GLint normal_location,
-  GLint tex_coord_location) {
-
-  PV112Geometry geometry;
-
-  // Create a single buffer for vertex data
-  glGenBuffers(1, &geometry.VertexBuffers[0]);
-  glBindBuffer(GL_ARRAY_BUFFER, geometry.VertexBuffers[0]);
-  glBufferData(GL_ARRAY_BUFFER, rectangle_vertices_count * sizeof(float) * 8,
-  rectangle_vertices, GL_STATIC_DRAW);
-  glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-  geometry.VertexBuffers[1] = 0;
-  geometry.VertexBuffers[2] = 0;
-
-  // Create a buffer for indices
-  glGenBuffers(1, &geometry.IndexBuffer);
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, geometry.IndexBuffer);
-  glBufferData(GL_ELEMENT_ARRAY_BUFFER, rectangle_indices_count * sizeof(unsigned int),
-  rectangle_indices, GL_STATIC_DRAW);
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-
-  // Create a vertex array object for the geometry
-  glGenVertexArrays(1, &geometry.VAO);
-
-  // Set the parameters of the geometry
-  glBindVertexArray(geometry.VAO);
-  glBindBuffer(GL_ARRAY_BUFFER, geometry.VertexBuffers[0]);
-  if (position_location >= 0)
-  {
-      glEnableVertexAttribArray(position_location);
-      glVertexAttribPointer(position_location, 3, GL_FLOAT, GL_FALSE, sizeof(float) * 8, 0);
-  }
-  if (normal_location >= 0)
-  {
-      glEnableVertexAttribArray(normal_location);
-      glVertexAttribPointer(normal_location, 3, GL_FLOAT, GL_FALSE, sizeof(float) * 8, (const void *)(sizeof(float) * 3));
-  }
-  if (tex_coord_location >= 0)
-  {
-      glEnableVertexAttribArray(tex_coord_location);
-      glVertexAttribPointer(tex_coord_location, 2, GL_FLOAT, GL_FALSE, sizeof(float) * 8, (const void *)(sizeof(float) * 6));
-  }
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, geometry.IndexBuffer);
-
-  glBindVertexArray(0);
-  glBindBuffer(GL_ARRAY_BUFFER, 0);
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+PV112Geometry CreateTeapot(GLint position_location, GLint normal_location, GLint tex_coord_location, VertexLayout layout)
+{
+    return CreateBasicObject(GetTeapotTables(), layout, position_location, normal_location, tex_coord_location);
+}
 
-  geometry.Mode = GL_TRIANGLES;
-  geometry.DrawArraysCount = 0;
-  geometry.DrawElementsCount = rectangle_indices_count;
+PV112Geometry CreateRectangle(GLint position_location, GLint normal_location,
+  GLint tex_coord_location, VertexLayout layout) {
 
-  return geometry;
+  return CreateBasicObject(GetRectangleTables(), layout, position_location, normal_location, tex_coord_location);
 }
 //--------------------------
 //----    OBJ LOADER    ----
 //--------------------------
 
-bool ParseOBJFile(const char *file_name, std::vector<glm::vec3> &out_vertices, std::vector<glm::vec3> &out_normals, std::vector<glm::vec2> &out_tex_coords)
+namespace
 {
-    // I love lambda functions :-)
-    auto error_msg = [file_name] {
-        cout << "Failed to read OBJ file " << file_name << ", its format is not supported" << endl;
-    };
 
-    struct OBJTriangle
-    {
-        int v0, v1, v2;
-        int n0, n1, n2;
-        int t0, t1, t2;
-    };
+// Sizes of the blocks of LoadOBJStreaming, the file is read 1 MB at a time and the vertices are uploaded
+// 256 KB (of floats) at a time
+const size_t obj_streaming_read_size = 1024 * 1024;
+const size_t obj_streaming_block_size = 64 * 1024;
 
-    // Prepare the arrays for the data from the file.
-    std::vector<glm::vec3> raw_vertices;        raw_vertices.reserve(1000);
-    std::vector<glm::vec3> raw_normals;            raw_normals.reserve(1000);
-    std::vector<glm::vec2> raw_tex_coords;        raw_tex_coords.reserve(1000);
-    std::vector<OBJTriangle> raw_triangles;        raw_triangles.reserve(1000);
+// Parses an OBJ file that is already mapped, prints an error message if something goes wrong
+bool ParseOBJSource(const char *file_name, const MappedFile &file, OBJData &out)
+{
+    if (!ParseOBJData(file.Data(), file.Size(), out))
+    {
+        cout << "Failed to read OBJ file " << file_name << ", its format is not supported" << endl;
+        return false;
+    }
+    return true;
+}
 
-    // Load OBJ file
-    ifstream file(file_name);
-    if (!file.is_open())
+// Maps and parses an OBJ file, prints an error message if something goes wrong
+bool ReadOBJFile(const char *file_name, OBJData &out)
+{
+    // Map the OBJ file into memory, the parser walks its bytes directly
+    MappedFile file;
+    if (!file.Open(file_name))
     {
         cout << "Cannot open OBJ file " << file_name << endl;
         return false;
     }
+    return ParseOBJSource(file_name, file, out);
+}
 
-    while (!file.fail())
+// Copies a submesh of the mesh data to the geometry
+void SetGeometrySubmesh(const MeshSubmesh &submesh, const std::string &name, GeometrySubmesh &out)
+{
+    out.Name = name;
+    out.Material = int(submesh.Material);
+    for (size_t level = 0; level < mesh_cache_max_lods; level++)
     {
-        string prefix;
-        file >> prefix;
+        out.FirstIndex[level] = GLsizei(submesh.FirstIndex[level]);
+        out.IndexCount[level] = GLsizei(submesh.IndexCount[level]);
+    }
+}
 
-        if (prefix == "v")
-        {
-            glm::vec3 v;
-            file >> v.x >> v.y >> v.z;
-            raw_vertices.push_back(v);
-            file.ignore(numeric_limits<streamsize>::max(), '\n');        // Ignore the rest of the line
-        }
-        else if (prefix == "vt")
-        {
-            glm::vec2 vt;
-            file >> vt.x >> vt.y;
-            raw_tex_coords.push_back(vt);
-            file.ignore(numeric_limits<streamsize>::max(), '\n');        // Ignore the rest of the line
-        }
-        else if (prefix == "vn")
-        {
-            glm::vec3 vn;
-            file >> vn.x >> vn.y >> vn.z;
-            raw_normals.push_back(vn);
-            file.ignore(numeric_limits<streamsize>::max(), '\n');        // Ignore the rest of the line
-        }
-        else if (prefix == "f")
-        {
-            OBJTriangle t;
-            char slash;
-
-            // And now check whether the geometry is of a correct format (that it contains only triangles,
-            // and all vertices have their position, normal, and texture coordinate set).
-
-            // Read the first vertex
-            file >> ws;        if (!isdigit(file.peek()))    {    error_msg();        return false;    }
-            file >> t.v0;
-            file >> ws;        if (file.peek() != '/')        {    error_msg();        return false;    }
-            file >> slash;
-            file >> ws;        if (!isdigit(file.peek()))    {    error_msg();        return false;    }
-            file >> t.t0;
-            file >> ws;        if (file.peek() != '/')        {    error_msg();        return false;    }
-            file >> slash;
-            file >> ws;        if (!isdigit(file.peek()))    {    error_msg();        return false;    }
-            file >> t.n0;
-
-            // Read the second vertex
-            file >> ws;        if (!isdigit(file.peek()))    {    error_msg();        return false;    }
-            file >> t.v1;
-            file >> ws;        if (file.peek() != '/')        {    error_msg();        return false;    }
-            file >> slash;
-            file >> ws;        if (!isdigit(file.peek()))    {    error_msg();        return false;    }
-            file >> t.t1;
-            file >> ws;        if (file.peek() != '/')        {    error_msg();        return false;    }
-            file >> slash;
-            file >> ws;        if (!isdigit(file.peek()))    {    error_msg();        return false;    }
-            file >> t.n1;
-
-            // Read the third vertex
-            file >> ws;        if (!isdigit(file.peek()))    {    error_msg();        return false;    }
-            file >> t.v2;
-            file >> ws;        if (file.peek() != '/')        {    error_msg();        return false;    }
-            file >> slash;
-            file >> ws;        if (!isdigit(file.peek()))    {    error_msg();        return false;    }
-            file >> t.t2;
-            file >> ws;        if (file.peek() != '/')        {    error_msg();        return false;    }
-            file >> slash;
-            file >> ws;        if (!isdigit(file.peek()))    {    error_msg();        return false;    }
-            file >> t.n2;
-
-            // Check that this polygon has only three vertices (we support triangles only).
-            // It also skips all white spaces, effectively ignoring the rest of the line (if empty).
-            file >> ws;        if (isdigit(file.peek()))    {    error_msg();        return false;    }
-
-            // Subtract one, OBJ indexes from 1, not from 0
-            t.v0--;        t.v1--;        t.v2--;
-            t.n0--;        t.n1--;        t.n2--;
-            t.t0--;        t.t1--;        t.t2--;
-
-            raw_triangles.push_back(t);
-        }
-        else
-        {
-            // Ignore other cases
-            file.ignore(numeric_limits<streamsize>::max(), '\n');        // Ignore the rest of the line
-        }
+// Parses a mapped OBJ file into the mesh the cache stores, see BuildOBJMesh
+bool ParseOBJMesh(const char *file_name, const MappedFile &file, MeshData &out)
+{
+    OBJData raw;
+    if (!ParseOBJSource(file_name, file, raw))
+        return false;
+
+    if (!BuildOBJMesh(raw, out))
+    {
+        // Invalid out-of-range indices
+        cout << "Failed to read OBJ file " << file_name << ", its format is not supported" << endl;
+        return false;
     }
-    file.close();
+    return true;
+}
+
+}
+
+bool ParseOBJFile(const char *file_name, std::vector<glm::vec3> &out_vertices, std::vector<glm::vec3> &out_normals, std::vector<glm::vec2> &out_tex_coords)
+{
+    OBJData raw;
+    if (!ReadOBJFile(file_name, raw))
+        return false;
 
     // Indices in OBJ file cannot be used, we need to convert the geometry in a way we could draw it
     // with glDrawArrays.
-    out_vertices.clear();        out_vertices.reserve(raw_triangles.size() * 3);
-    out_normals.clear();        out_normals.reserve(raw_triangles.size() * 3);
-    out_tex_coords.clear();        out_tex_coords.reserve(raw_triangles.size() * 3);
-    for (size_t i = 0; i < raw_triangles.size(); i++)
-    {
-        if ((raw_triangles[i].v0 >= int(raw_vertices.size())) ||
-                (raw_triangles[i].v1 >= int(raw_vertices.size())) ||
-                (raw_triangles[i].v2 >= int(raw_vertices.size())) ||
-                (raw_triangles[i].n0 >= int(raw_normals.size())) ||
-                (raw_triangles[i].n1 >= int(raw_normals.size())) ||
-                (raw_triangles[i].n2 >= int(raw_normals.size())) ||
-                (raw_triangles[i].t0 >= int(raw_tex_coords.size())) ||
-                (raw_triangles[i].t1 >= int(raw_tex_coords.size())) ||
-                (raw_triangles[i].t2 >= int(raw_tex_coords.size())))
+    if (!ExpandOBJTriangles(raw, out_vertices, out_normals, out_tex_coords))
+    {
+        // Invalid out-of-range indices
+        cout << "Failed to read OBJ file " << file_name << ", its format is not supported" << endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool ParseOBJFile(const char *file_name, std::vector<glm::vec3> &out_vertices, std::vector<glm::vec3> &out_normals, std::vector<glm::vec2> &out_tex_coords,
+        std::vector<unsigned int> &out_indices)
+{
+    OBJData raw;
+    if (!ReadOBJFile(file_name, raw))
+        return false;
+
+    // OBJ files index positions, normals, and texture coordinates separately, OpenGL needs a single
+    // index per vertex. Every distinct combination becomes one vertex.
+    if (!IndexOBJTriangles(raw, out_vertices, out_normals, out_tex_coords, out_indices))
+    {
+        // Invalid out-of-range indices
+        cout << "Failed to read OBJ file " << file_name << ", its format is not supported" << endl;
+        return false;
+    }
+
+    return true;
+}
+
+OBJGeometryData::OBJGeometryData()
+    : Layout(VertexLayout::Float), VertexData(nullptr), VertexDataSize(0), Indices(nullptr), IndexCount(0),
+    PositionScale(1.0f), PositionOffset(0.0f), OctahedralNormals(false), Closed(false)
+{
+    Box.Min = glm::vec3(0.0f);
+    Box.Max = glm::vec3(0.0f);
+    Sphere.Center = glm::vec3(0.0f);
+    Sphere.Radius = 0.0f;
+}
+
+bool ReadOBJGeometry(const char *file_name, VertexLayout layout, OBJGeometryData &out)
+{
+    MappedFile source;
+    if (!source.Open(file_name))
+    {
+        cout << "Cannot open OBJ file " << file_name << endl;
+        return false;
+    }
+
+    // The binary cache next to the OBJ file contains exactly what the parser would produce. When it was
+    // created from this very file, its mapped data go to OpenGL directly and the text is not parsed at all.
+    const SourceStamp source_stamp = GetSourceStamp(source);
+    const std::string cache_name = GetMeshCacheFileName(file_name);
+
+    const float *vertices;
+    size_t vertex_count;
+    if (out.Cache.Open(cache_name.c_str(), source_stamp))
+    {
+        vertices = out.Cache.Vertices();
+        vertex_count = out.Cache.VertexCount();
+        out.Indices = out.Cache.Indices();
+        out.IndexCount = out.Cache.IndexCount();
+        out.LODs.assign(&out.Cache.LOD(0), &out.Cache.LOD(0) + out.Cache.LODCount());
+        out.Meshlets.assign(out.Cache.Meshlets(), out.Cache.Meshlets() + out.Cache.MeshletCount());
+        out.Closed = out.Cache.Closed();
+        out.Submeshes.resize(out.Cache.SubmeshCount());
+        for (size_t i = 0; i < out.Submeshes.size(); i++)
+            SetGeometrySubmesh(out.Cache.Submesh(i), out.Cache.SubmeshName(i), out.Submeshes[i]);
+        for (size_t i = 0; i < out.Cache.MaterialCount(); i++)
+            out.Materials.push_back(out.Cache.MaterialName(i));
+    }
+    else
+    {
+        MeshData &parsed = out.Parsed;
+        if (!ParseOBJMesh(file_name, source, parsed))
         {
-            // Invalid out-of-range indices
-            error_msg();
-            return false;
+            return false;        // The error message was already printed
         }
-
-        out_vertices.push_back(raw_vertices[raw_triangles[i].v0]);
-        out_vertices.push_back(raw_vertices[raw_triangles[i].v1]);
-        out_vertices.push_back(raw_vertices[raw_triangles[i].v2]);
-        out_normals.push_back(raw_normals[raw_triangles[i].n0]);
-        out_normals.push_back(raw_normals[raw_triangles[i].n1]);
-        out_normals.push_back(raw_normals[raw_triangles[i].n2]);
-        out_tex_coords.push_back(raw_tex_coords[raw_triangles[i].t0]);
-        out_tex_coords.push_back(raw_tex_coords[raw_triangles[i].t1]);
-        out_tex_coords.push_back(raw_tex_coords[raw_triangles[i].t2]);
+        vertices = parsed.Vertices.data();
+        vertex_count = parsed.Vertices.size() / mesh_cache_vertex_floats;
+        out.Indices = parsed.Indices.data();
+        out.IndexCount = parsed.Indices.size();
+        out.LODs = parsed.LODs;
+        out.Meshlets = parsed.Meshlets;
+        out.Closed = parsed.Closed;
+        out.Submeshes.resize(parsed.Submeshes.size());
+        for (size_t i = 0; i < out.Submeshes.size(); i++)
+            SetGeometrySubmesh(parsed.Submeshes[i], parsed.SubmeshNames[i], out.Submeshes[i]);
+        out.Materials = parsed.Materials;
+
+        // Not being able to write the cache is not an error, the file is parsed again next time
+        if (!WriteMeshCache(cache_name.c_str(), source_stamp, parsed))
+            cout << "Cannot write mesh cache " << cache_name << endl;
     }
+    source.Close();
 
+    ComputeBounds(vertices, vertex_count, mesh_cache_vertex_floats, out.Box, out.Sphere);
+
+    // The packed and quantized vertices are converted here, the cache always has the floats
+    out.Layout = layout;
+    if (layout == VertexLayout::Packed)
+    {
+        out.PackedVertices.resize(vertex_count);
+        PackVertices(vertices, vertex_count, out.PackedVertices.data());
+        out.VertexData = out.PackedVertices.data();
+        out.VertexDataSize = vertex_count * sizeof(PackedVertex);
+    }
+    else if (layout == VertexLayout::Quantized)
+    {
+        const glm::vec3 bounds_min = out.Box.Min, bounds_max = out.Box.Max;
+        out.QuantizedVertices.resize(vertex_count);
+        QuantizeVertices(vertices, vertex_count, bounds_min, bounds_max, out.QuantizedVertices.data());
+        out.VertexData = out.QuantizedVertices.data();
+        out.VertexDataSize = vertex_count * sizeof(QuantizedVertex);
+
+        // The shader computes offset + normalized * scale
+        out.PositionScale = bounds_max - bounds_min;
+        out.PositionOffset = bounds_min;
+        out.OctahedralNormals = true;
+    }
+    else
+    {
+        out.VertexData = vertices;
+        out.VertexDataSize = vertex_count * sizeof(float) * 8;
+    }
     return true;
 }
 
-PV112Geometry LoadOBJ(const char *file_name, GLint position_location, GLint normal_location, GLint tex_coord_location)
+size_t GetVertexLayoutSize(VertexLayout layout)
+{
+    switch (layout)
+    {
+    case VertexLayout::Packed:      return PackedVertexFormat::stride;
+    case VertexLayout::Quantized:   return QuantizedVertexFormat::stride;
+    default:                        return FloatVertexFormat::stride;
+    }
+}
+
+void SetVertexAttributes(VertexLayout layout, GLint position_location, GLint normal_location, GLint tex_coord_location)
+{
+    const GLint locations[] = { position_location, normal_location, tex_coord_location };
+    GetVertexAttributeSetter(layout)(locations);
+}
+
+PV112Geometry CreateOBJGeometry(const OBJGeometryData &data, GLint position_location, GLint normal_location, GLint tex_coord_location,
+        GLObjectPool *pool, GeometryArena *arena)
 {
     PV112Geometry geometry;
+    if (data.LODs.empty())
+        return geometry;
+
+    // The data are uploaded once, into the arena if there is room
+    if (arena == nullptr || !arena->Add(data.Layout, data.VertexData, data.VertexDataSize, data.Indices, data.IndexCount, geometry))
+    {
+        const GLint locations[] = { position_location, normal_location, tex_coord_location };
+        geometry = CreateIndexedGeometry(data.VertexData, data.VertexDataSize, data.Indices, data.IndexCount,
+                GetVertexAttributeSetter(data.Layout), locations, pool);
+    }
+
+    geometry.Layout = data.Layout;
+    geometry.DrawElementsCount = GLsizei(data.LODs[0].IndexCount);
+
+    // The simplified levels follow the full geometry in the index buffer
+    geometry.LODCount = int(std::min(data.LODs.size(), size_t(PV112Geometry::MaxLODs)));
+    for (int level = 0; level < geometry.LODCount; level++)
+    {
+        geometry.LODFirstIndex[level] = GLsizei(data.LODs[level].FirstIndex);
+        geometry.LODIndexCount[level] = GLsizei(data.LODs[level].IndexCount);
+        geometry.LODError[level] = data.LODs[level].Error;
+    }
+    geometry.Meshlets = data.Meshlets;
+    geometry.Closed = data.Closed;
+    geometry.Submeshes = data.Submeshes;
+    geometry.Materials = data.Materials;
+    geometry.Box = data.Box;
+    geometry.Sphere = data.Sphere;
+    geometry.PositionScale = data.PositionScale;
+    geometry.PositionOffset = data.PositionOffset;
+    geometry.OctahedralNormals = data.OctahedralNormals;
+
+    return geometry;
+}
+
+PV112Geometry LoadOBJ(const char *file_name, GLint position_location, GLint normal_location, GLint tex_coord_location,
+        VertexLayout layout)
+{
+    OBJGeometryData data;
+    if (!ReadOBJGeometry(file_name, layout, data))
+        return PV112Geometry();        // Return empty geometry, the error message was already printed
+    return CreateOBJGeometry(data, position_location, normal_location, tex_coord_location);
+}
 
-    std::vector<glm::vec3> vertices;
-    std::vector<glm::vec3> normals;
-    std::vector<glm::vec2> tex_coords;
-    if (!ParseOBJFile(file_name, vertices, normals, tex_coords))
+PV112Geometry LoadOBJStreaming(const char *file_name, GLint position_location, GLint normal_location, GLint tex_coord_location)
+{
+    FILE *file = fopen(file_name, "rb");
+    if (file == nullptr)
     {
-        return geometry;        // Return empty geometry, the error message was already printed
+        cout << "Cannot open OBJ file " << file_name << endl;
+        return PV112Geometry();
     }
+    OBJData raw;
+    const bool parsed = ParseOBJStream(file, obj_streaming_read_size, raw);
+    fclose(file);
+    if (!parsed)
+    {
+        cout << "Failed to read OBJ file " << file_name << ", its format is not supported" << endl;
+        return PV112Geometry();
+    }
+
+    PV112Geometry geometry;
+    const size_t vertex_count = raw.Triangles.size() * 3;
+    const size_t vertex_bytes = sizeof(float) * obj_block_vertex_floats;
 
-    // Create buffers for vertex data
-    glGenBuffers(3, geometry.VertexBuffers);
+    // Allocate the whole buffer, and fill it a block at a time
+    glGenBuffers(1, &geometry.VertexBuffers[0]);
     glBindBuffer(GL_ARRAY_BUFFER, geometry.VertexBuffers[0]);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float) * 3, vertices.data(), GL_STATIC_DRAW);
-    glBindBuffer(GL_ARRAY_BUFFER, geometry.VertexBuffers[1]);
-    glBufferData(GL_ARRAY_BUFFER, normals.size() * sizeof(float) * 3, normals.data(), GL_STATIC_DRAW);
-    glBindBuffer(GL_ARRAY_BUFFER, geometry.VertexBuffers[2]);
-    glBufferData(GL_ARRAY_BUFFER, tex_coords.size() * sizeof(float) * 2, tex_coords.data(), GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, vertex_count * vertex_bytes, nullptr, GL_STATIC_DRAW);
+
+    std::vector<float> block(obj_streaming_block_size);
+    const bool ok = ExpandOBJTrianglesInBlocks(raw, block.data(), block.size(),
+            [vertex_bytes](const float *vertices, size_t first_vertex, size_t count)
+    {
+        glBufferSubData(GL_ARRAY_BUFFER, first_vertex * vertex_bytes, count * vertex_bytes, vertices);
+        return true;
+    });
     glBindBuffer(GL_ARRAY_BUFFER, 0);
+    if (!ok)
+    {
+        // Invalid out-of-range indices
+        cout << "Failed to read OBJ file " << file_name << ", its format is not supported" << endl;
+        DeleteGeometry(geometry);
+        return geometry;
+    }
 
-    // No indices
+    geometry.VertexBuffers[1] = 0;
+    geometry.VertexBuffers[2] = 0;
     geometry.IndexBuffer = 0;
 
     // Create a vertex array object for the geometry
@@ -648,32 +944,20 @@ PV112Geometry LoadOBJ(const char *file_name, GLint position_location, GLint norm
 
     // Set the parameters of the geometry
     glBindVertexArray(geometry.VAO);
-    if (position_location >= 0)
-    {
-        glBindBuffer(GL_ARRAY_BUFFER, geometry.VertexBuffers[0]);
-        glEnableVertexAttribArray(position_location);
-        glVertexAttribPointer(position_location, 3, GL_FLOAT, GL_FALSE, 0, 0);
-    }
-    if (normal_location >= 0)
-    {
-        glBindBuffer(GL_ARRAY_BUFFER, geometry.VertexBuffers[1]);
-        glEnableVertexAttribArray(normal_location);
-        glVertexAttribPointer(normal_location, 3, GL_FLOAT, GL_FALSE, 0, 0);
-    }
-    if (tex_coord_location >= 0)
-    {
-        glBindBuffer(GL_ARRAY_BUFFER, geometry.VertexBuffers[2]);
-        glEnableVertexAttribArray(tex_coord_location);
-        glVertexAttribPointer(tex_coord_location, 2, GL_FLOAT, GL_FALSE, 0, 0);
-    }
+    glBindBuffer(GL_ARRAY_BUFFER, geometry.VertexBuffers[0]);
+    SetVertexAttributes(VertexLayout::Float, position_location, normal_location, tex_coord_location);
 
     glBindVertexArray(0);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 
     geometry.Mode = GL_TRIANGLES;
-    geometry.DrawArraysCount = vertices.size();
+    geometry.DrawArraysCount = GLsizei(vertex_count);
     geometry.DrawElementsCount = 0;
 
+    // The expanded vertices are gone, the bounds of all positions in the file contain them
+    if (!raw.Vertices.empty())
+        ComputeBounds(&raw.Vertices[0].x, raw.Vertices.size(), 3, geometry.Box, geometry.Sphere);
+
     return geometry;
 }
 
@@ -10,6 +10,10 @@
 
 #include <glm/glm.hpp>
 
+#include "meshtools.h"
+#include "meshbuild.h"
+#include "primitives.h"
+
 namespace PV112
 {
 
@@ -58,6 +62,44 @@ GLuint CreateAndLinkProgram(const char *vertex_shader, const char *fragment_shad
 //----    SIMPLE PV112 GEOMETRY CLASS    ----
 //-------------------------------------------
 
+/// Axis-aligned box, all points p with Min <= p <= Max.
+struct BoundingBox
+{
+    glm::vec3 Min;
+    glm::vec3 Max;
+};
+
+/// Sphere, all points closer than Radius to Center.
+struct BoundingSphere
+{
+    glm::vec3 Center;
+    float Radius;
+};
+
+/// Formats of the vertex data of loaded geometries, the vertices are always interleaved in a single buffer.
+///     - Float .. 3 floats of position, 3 floats of normal, 2 floats of texture coordinate (32 bytes),
+///                the same layout the basic objects use
+///     - Packed .. 3 floats of position, the normal in GL_INT_2_10_10_10_REV, and the texture coordinate
+///                in GL_HALF_FLOAT (20 bytes). The shaders need no change, OpenGL converts the values.
+///     - Quantized .. the position in 16-bit integers relative to the bounding box of the geometry, the
+///                normal in the octahedral encoding in two 16-bit integers, and the texture coordinate in
+///                GL_HALF_FLOAT (16 bytes). The vertex shader decodes the position and the normal, see
+///                SetVertexDecodeUniforms.
+enum class VertexLayout { Float, Packed, Quantized };
+
+/// A part of a geometry with its own material, for example an object of an OBJ file with several objects.
+/// The submeshes of a geometry share its buffers and VAO, see DrawSubmesh.
+struct GeometrySubmesh
+{
+    // Name of the object or group in the file
+    std::string Name;
+    // Index to the materials of the geometry, the application decides how to draw each of them
+    int Material;
+    // Range of the index buffer of each level of detail of the geometry, empty for the missing levels
+    GLsizei FirstIndex[mesh_cache_max_lods];
+    GLsizei IndexCount[mesh_cache_max_lods];
+};
+
 /// This is a VERY SIMPLE class to contain all buffers and vertex array objects for geometries of
 /// PV112 lectures. It is not a perfect, brilliant, smart, or whatever implementation of a geometry.
 ///
@@ -65,9 +107,11 @@ GLuint CreateAndLinkProgram(const char *vertex_shader, const char *fragment_shad
 /// as a struct. This design was chosen because OpenGL is more C-like, so I wanted the class and all
 /// functions that work with it to be more C-like too.
 ///
-/// When drawing the geometry, bind its VAO and call the draw command. The whole geometry is always
-/// drawn using a single draw call. Use glDrawArrays if DrawArraysCount > 0, or use glDrawElements
-/// if DrawElementsCount > 0.
+/// When drawing the geometry, bind its VAO and call DrawGeometry (or DrawSubmesh, DrawGeometryInstanced),
+/// which issues the draw command. The whole geometry is always drawn using a single draw call, glDrawArrays
+/// from BaseVertex if DrawArraysCount > 0, or glDrawElementsBaseVertex if DrawElementsCount > 0. A geometry
+/// in a GeometryArena shares its buffers with other geometries, its indices start at BaseIndex and refer to
+/// the vertices from BaseVertex, so a plain glDrawArrays or glDrawElements would draw another geometry.
 class PV112Geometry
 {
 public:
@@ -83,6 +127,9 @@ public:
     //
     // To make it short, all OpenGL objects must be destroyed BEFORE the main window is closed
     // (or left alive, as in our case).
+    //
+    // A geometry that is loaded and unloaded while the application runs can be owned by a
+    // GeometryHandle instead (see geometrypool.h), which gives its objects back when it is reset.
 
     // Up to three buffers with the data of the geometry (positions, normals, texture coordinates).
     // If the data is only in one buffer, other buffers are 0
@@ -94,20 +141,115 @@ public:
     // Vertex Array Object with the geometry
     GLuint VAO;
 
+    // Format of the vertex data, VertexLayout::Float unless another one was requested
+    VertexLayout Layout;
+
+    // True if the buffers and the VAO belong to a GeometryArena and are shared with other geometries, see
+    // geometryarena.h. The vertices of the geometry then start at BaseVertex and its indices (all index
+    // ranges below are relative to them) at BaseIndex. Both are 0 for a geometry with its own buffers.
+    bool SharedBuffers;
+    GLint BaseVertex;
+    GLsizei BaseIndex;
+
     // Type of the primitives to be drawn
     GLenum Mode;
     // Number of vertices to be drawn using glDrawArrays
     GLsizei DrawArraysCount;
     // Number of vertices to be drawn using glDrawElements
     GLsizei DrawElementsCount;
+
+    // Levels of detail of the geometries loaded by LoadOBJ and of CreateSphereLODs, simplified versions of
+    // the geometry in the same buffers (see DrawGeometry with 'lod' and SelectGeometryLOD). Level 0 is the
+    // whole geometry, other geometries have no levels (LODCount is 0). The limit is the one of the mesh
+    // cache, the submeshes store their ranges for that many levels.
+    static const int MaxLODs = int(mesh_cache_max_lods);
+    int LODCount;
+    // First index and number of indices of each level in the index buffer
+    GLsizei LODFirstIndex[MaxLODs];
+    GLsizei LODIndexCount[MaxLODs];
+    // Largest distance between the surface of each level and the whole geometry, in model space units
+    float LODError[MaxLODs];
+
+    // How vertex.glsl decodes the vertices, see SetVertexDecodeUniforms. The positions in the buffer are
+    // multiplied by PositionScale and PositionOffset is added, the normals may be octahedral-encoded.
+    glm::vec3 PositionScale;
+    glm::vec3 PositionOffset;
+    bool OctahedralNormals;
+
+    // Bounds of the vertex positions in model space, computed when the geometry is created (see
+    // TransformBoundingBox and TransformBoundingSphere). They are zero for an empty geometry.
+    BoundingBox Box;
+    BoundingSphere Sphere;
+
+    // Meshlets of level 0 of the geometries loaded by LoadOBJ, ranges of its indices with bounds that allow
+    // skipping those that cannot be visible (see DrawGeometryMeshlets). Other geometries have none.
+    std::vector<Meshlet> Meshlets;
+    // True for the geometries loaded by LoadOBJ whose levels all enclose a volume (see IsMeshClosed), their
+    // back faces are never seen and can be culled. False for open models and for other geometries.
+    bool Closed;
+
+    // Parts of the geometries loaded by LoadOBJ, split by the o, g, and usemtl records of the file. Every
+    // geometry loaded by LoadOBJ has at least one, other geometries have none. The materials are the names
+    // of the usemtl records, in the order of their first use.
+    std::vector<GeometrySubmesh> Submeshes;
+    std::vector<std::string> Materials;
 };
 
-/// Deletes OpenGL objects of the geometry.
+/// Computes the bounds of 'count' positions, each 'stride' floats after the previous one. The sphere is
+/// centered in the box, which is not the smallest sphere, but close to it for most models.
+void ComputeBounds(const float *positions, size_t count, size_t stride, BoundingBox &out_box, BoundingSphere &out_sphere);
+
+/// Returns the axis-aligned box around 'box' transformed by an affine 'matrix', usually to world space.
+BoundingBox TransformBoundingBox(const BoundingBox &box, const glm::mat4 &matrix);
+
+/// Returns a sphere around 'sphere' transformed by an affine 'matrix'. The radius is scaled by the largest
+/// scale of the matrix, so the sphere is exact only if the scale is uniform.
+BoundingSphere TransformBoundingSphere(const BoundingSphere &sphere, const glm::mat4 &matrix);
+
+/// Deletes OpenGL objects of the geometry. A geometry in a GeometryArena is only reset, its buffers are
+/// shared, use GeometryArena::Remove to free its space.
 void DeleteGeometry(PV112Geometry &geom);
 
 /// Chooses glDrawArrays or glDrawElements to draw the geometry.
 void DrawGeometry(const PV112Geometry &geom);
 
+/// Draws the whole geometry 'instance_count' times in one draw, the vertex shader tells the instances apart by
+/// gl_InstanceID.
+void DrawGeometryInstanced(const PV112Geometry &geom, GLsizei instance_count);
+
+/// Sets the uniforms of the vertex shader that decode the vertices of the geometry: 'position_scale' and
+/// 'position_offset' (vec3) and 'octahedral_normal' (bool), see VertexLayout::Quantized. Geometries in other
+/// layouts set the values that leave the vertices as they are, so call it before drawing any geometry
+/// after a quantized one. Locations that are -1 are ignored.
+void SetVertexDecodeUniforms(const PV112Geometry &geom, GLint position_scale_location, GLint position_offset_location,
+        GLint octahedral_normal_location);
+
+/// Draws a level of detail of the geometry, the whole geometry if it does not have such level.
+void DrawGeometry(const PV112Geometry &geom, int lod);
+
+/// Draws a submesh of the geometry at a level of detail, the level 0 if the geometry does not have such
+/// level. Bind the VAO of the geometry first, and set the material of the submesh.
+void DrawSubmesh(const PV112Geometry &geom, size_t submesh, int lod = 0);
+
+/// Chooses the coarsest level of detail of the geometry whose error, projected on the screen, is at most
+/// 'max_pixels' pixels.
+///
+/// 'distance' is the distance between the eye and the geometry in world space, 'scale' is the scale of its
+/// model matrix, and 'projection_height' is the height of the viewport in pixels divided by 2*tan(fovy/2).
+int SelectGeometryLOD(const PV112Geometry &geom, float distance, float scale, float projection_height, float max_pixels = 1.0f);
+
+/// Draws level 0 of the geometry without the meshlets that are outside the view frustum or whose triangles
+/// all face away from the eye, in a single glMultiDrawElements. Skipping the back-facing ones changes the
+/// image only where back faces would be seen, enable GL_CULL_FACE to have the same result for all triangles.
+/// The back-facing meshlets are skipped only if the geometry is Closed, the back faces of an open one may be
+/// seen through its openings. A geometry without meshlets is drawn whole.
+///
+/// 'PVM_matrix' transforms the geometry to clip space and 'eye_position' is the eye in model space
+/// (the inverse of the model matrix times the eye position in world space).
+///
+/// Returns the number of drawn triangles.
+GLsizei DrawGeometryMeshlets(const PV112Geometry &geom, const glm::mat4 &PVM_matrix, const glm::vec3 &eye_position);
+
 //-----------------------------
 //----    BASIC OBJECTS    ----
 //-----------------------------
@@ -117,14 +259,28 @@ void DrawGeometry(const PV112Geometry &geom);
 ///
 /// 'position_location', 'normal_location', and 'tex_coord_location' are locations of vertex attributes,
 /// obtained by glGetAttribLocation. Use -1 if not necessary.
-PV112Geometry CreateCube(GLint position_location, GLint normal_location = -1, GLint tex_coord_location = -1);
+///
+/// The vertices and indices of the basic objects are computed at compile time in all formats of
+/// VertexLayout (see primitives.h), 'layout' selects the one copied to OpenGL.
+PV112Geometry CreateCube(GLint position_location, GLint normal_location = -1, GLint tex_coord_location = -1,
+        VertexLayout layout = VertexLayout::Float);
 
 /// Creates a simple sphere object. The center of the sphere is in (0,0,0) and its radius is 1
 /// (positions of its vertices are from -1 to 1).
 ///
+/// The sphere has the given tessellation level, from 0 to sphere_tessellation_levels - 1, see
+/// GetSphereTables.
+///
 /// 'position_location', 'normal_location', and 'tex_coord_location' are locations of vertex attributes,
 /// obtained by glGetAttribLocation. Use -1 if not necessary.
-PV112Geometry CreateSphere(GLint position_location, GLint normal_location = -1, GLint tex_coord_location = -1);
+PV112Geometry CreateSphere(GLint position_location, GLint normal_location = -1, GLint tex_coord_location = -1,
+        int tessellation = default_sphere_tessellation, VertexLayout layout = VertexLayout::Float);
+
+/// Creates a sphere like CreateSphere with all tessellation levels in its buffers, as levels of detail
+/// (see PV112Geometry::LODCount): level of detail 0 is the finest tessellation. The errors are those of
+/// the unit sphere, so SelectGeometryLOD chooses a coarser sphere for a smaller or farther one.
+PV112Geometry CreateSphereLODs(GLint position_location, GLint normal_location = -1, GLint tex_coord_location = -1,
+        VertexLayout layout = VertexLayout::Float);
 
 /// Creates a simple teapot object. The center of the bottom of its body is roughly in (0,0,0) and
 /// the radius of the body is roughly 1. Its handle is in -X direction, its spout is in +X direction,
@@ -132,9 +288,11 @@ PV112Geometry CreateSphere(GLint position_location, GLint normal_location = -1,
 ///
 /// 'position_location', 'normal_location', and 'tex_coord_location' are locations of vertex attributes,
 /// obtained by glGetAttribLocation. Use -1 if not necessary.
-PV112Geometry CreateTeapot(GLint position_location, GLint normal_location = -1, GLint tex_coord_location = -1);
+PV112Geometry CreateTeapot(GLint position_location, GLint normal_location = -1, GLint tex_coord_location = -1,
+        VertexLayout layout = VertexLayout::Float);
 
-PV112Geometry CreateRectangle(GLint position_location, GLint normal_location = -1, GLint tex_coord_location = -1);
+PV112Geometry CreateRectangle(GLint position_location, GLint normal_location = -1, GLint tex_coord_location = -1,
+        VertexLayout layout = VertexLayout::Float);
 //--------------------------
 //----    OBJ LOADER    ----
 //--------------------------
@@ -151,11 +309,95 @@ PV112Geometry CreateRectangle(GLint position_location, GLint normal_location = -
 /// If something goes wrong, error messsage is printed and this function returns false.
 bool ParseOBJFile(const char *file_name, std::vector<glm::vec3> &out_vertices, std::vector<glm::vec3> &out_normals, std::vector<glm::vec2> &out_tex_coords);
 
-/// Loads an OBJ file and creates a corresponding PV112Geometry object.
+/// Parses an OBJ file like the function above, but the vertices shared by several triangles are stored
+/// only once. 'out_indices' contains three indices per triangle (use glDrawElements with GL_TRIANGLES).
+bool ParseOBJFile(const char *file_name, std::vector<glm::vec3> &out_vertices, std::vector<glm::vec3> &out_normals, std::vector<glm::vec2> &out_tex_coords,
+        std::vector<unsigned int> &out_indices);
+
+/// Returns the size of a single vertex in 'layout', in bytes.
+size_t GetVertexLayoutSize(VertexLayout layout);
+
+/// Sets the vertex attributes of the bound VAO for interleaved vertices in 'layout', read from the buffer
+/// bound to GL_ARRAY_BUFFER from its beginning. Locations that are -1 are left out.
+void SetVertexAttributes(VertexLayout layout, GLint position_location, GLint normal_location, GLint tex_coord_location);
+
+/// Loads an OBJ file and creates a corresponding PV112Geometry object. The geometry is indexed, each
+/// distinct vertex is stored (and transformed by the vertex shader) only once.
+///
+/// The parsed geometry is saved to a binary .pvmesh file next to the OBJ file, and the next time the
+/// same OBJ file is loaded, the data is taken from there without parsing (see meshcache.h).
+///
+/// Detailed geometries get simplified levels of detail, see PV112Geometry::LODCount and meshbuild.h.
 ///
 /// 'position_location', 'normal_location', and 'tex_coord_location' are locations of vertex attributes,
 /// obtained by glGetAttribLocation. Use -1 if not necessary.
-PV112Geometry LoadOBJ(const char *file_name, GLint position_location, GLint normal_location = -1, GLint tex_coord_location = -1);
+///
+/// 'layout' selects the format of the vertex data, see VertexLayout.
+PV112Geometry LoadOBJ(const char *file_name, GLint position_location, GLint normal_location = -1, GLint tex_coord_location = -1,
+        VertexLayout layout = VertexLayout::Float);
+
+/// Loads an OBJ file without the peak of memory of LoadOBJ, for very large models that are loaded once.
+/// The file is read and parsed in blocks (ParseOBJStream) instead of being mapped whole, and the triangles
+/// are expanded into a small staging block, which is copied to the vertex buffer with glBufferSubData
+/// whenever it is full. The geometry is not indexed (use glDrawArrays), has no levels of detail nor
+/// submeshes, and is not cached.
+///
+/// At the peak, the process needs memory for the records of the file and the two blocks, instead of the
+/// whole file, the records, and all the expanded or indexed vertices; see tools/objmemory.
+PV112Geometry LoadOBJStreaming(const char *file_name, GLint position_location, GLint normal_location = -1, GLint tex_coord_location = -1);
+
+class GLObjectPool;
+class GeometryArena;
+
+/// Data of an OBJ model ready to be copied to OpenGL buffers, see ReadOBJGeometry.
+class OBJGeometryData
+{
+public:
+    OBJGeometryData();
+
+    VertexLayout Layout;
+    // Content of the vertex buffer and the index buffer (all levels of detail)
+    const void *VertexData;
+    size_t VertexDataSize;
+    const unsigned int *Indices;
+    size_t IndexCount;
+    std::vector<MeshLOD> LODs;
+    std::vector<Meshlet> Meshlets;
+    std::vector<GeometrySubmesh> Submeshes;
+    std::vector<std::string> Materials;
+    // See PV112Geometry
+    BoundingBox Box;
+    BoundingSphere Sphere;
+    glm::vec3 PositionScale;
+    glm::vec3 PositionOffset;
+    bool OctahedralNormals;
+    bool Closed;
+
+    // The pointers above point into one of these, either the mapped cache or the parsed mesh, and into
+    // the converted vertices
+    MeshCache Cache;
+    MeshData Parsed;
+    std::vector<PackedVertex> PackedVertices;
+    std::vector<QuantizedVertex> QuantizedVertices;
+
+private:
+    OBJGeometryData(const OBJGeometryData &);
+    OBJGeometryData &operator =(const OBJGeometryData &);
+};
+
+/// LoadOBJ in two steps, so that the slow part can run on another thread (see assetloader.h).
+///
+/// ReadOBJGeometry does everything that does not need OpenGL: it reads the cache or parses the file (and
+/// writes the cache), and converts the vertices to 'layout'. It can be called from any thread. Returns
+/// false and prints an error message if the file cannot be read.
+///
+/// CreateOBJGeometry creates the OpenGL objects, on the thread with the OpenGL context. With an 'arena', the
+/// vertices and indices are written straight into its buffers and its VAO is used (with the attribute
+/// locations of the arena). A model that does not fit in the arena gets buffers of its own, with a 'pool',
+/// the buffers and the VAO released to it are used first.
+bool ReadOBJGeometry(const char *file_name, VertexLayout layout, OBJGeometryData &out);
+PV112Geometry CreateOBJGeometry(const OBJGeometryData &data, GLint position_location, GLint normal_location = -1, GLint tex_coord_location = -1,
+        GLObjectPool *pool = nullptr, GeometryArena *arena = nullptr);
 
 
 enum class Moving { FORWARD, BACKWARD, LEFT, RIGHT };
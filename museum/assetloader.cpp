@@ -0,0 +1,135 @@
+#include "assetloader.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <algorithm>
+#include <utility>
+
+namespace PV112
+{
+
+AssetLoader::AssetLoader(unsigned thread_count)
+    : pending(0), stopping(false)
+{
+    for (unsigned i = 0; i < std::max(1u, thread_count); i++)
+    {
+        workers.push_back(std::thread(&AssetLoader::WorkerMain, this));
+    }
+}
+
+AssetLoader::~AssetLoader()
+{
+    Stop();
+}
+
+void AssetLoader::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        read_queue.clear();
+    }
+    read_queued.notify_all();
+    for (size_t i = 0; i < workers.size(); i++)
+    {
+        workers[i].join();
+    }
+    workers.clear();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    upload_queue.clear();
+    pending = 0;
+}
+
+void AssetLoader::Load(const ReadStep &read)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        read_queue.push_back(read);
+        pending++;
+    }
+    read_queued.notify_one();
+}
+
+size_t AssetLoader::Update(double budget_seconds)
+{
+    const auto start = std::chrono::steady_clock::now();
+    size_t uploaded = 0;
+    while (true)
+    {
+        UploadStep upload;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (upload_queue.empty())
+                break;
+            upload = upload_queue.front();
+            upload_queue.pop_front();
+        }
+
+        upload();
+        uploaded++;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending--;
+        }
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        if (elapsed.count() >= budget_seconds)
+            break;
+    }
+    return uploaded;
+}
+
+size_t AssetLoader::PendingCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return pending;
+}
+
+void AssetLoader::WorkerMain()
+{
+    while (true)
+    {
+        ReadStep read;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            read_queued.wait(lock, [this] { return stopping || !read_queue.empty(); });
+            if (stopping)
+                return;
+            read = read_queue.front();
+            read_queue.pop_front();
+        }
+
+        UploadStep upload = read();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (upload)
+            upload_queue.push_back(upload);
+        else
+            pending--;        // Nothing to upload, the asset is done
+    }
+}
+
+void LoadOBJAsync(AssetLoader &loader, GeometryHandle &target, const char *file_name, GLint position_location,
+        GLint normal_location, GLint tex_coord_location, VertexLayout layout, GLObjectPool *pool, GeometryArena *arena)
+{
+    GeometryHandle *const target_pointer = &target;
+    const std::string name = file_name;
+    loader.Load([=]() -> AssetLoader::UploadStep
+    {
+        // OBJGeometryData cannot be copied, the upload step shares it
+        std::shared_ptr<OBJGeometryData> data = std::make_shared<OBJGeometryData>();
+        if (!ReadOBJGeometry(name.c_str(), layout, *data))
+            return AssetLoader::UploadStep();
+
+        return [=]()
+        {
+            PV112Geometry geometry = CreateOBJGeometry(*data, position_location, normal_location, tex_coord_location, pool, arena);
+            target_pointer->Reset(std::move(geometry), pool, arena);
+        };
+    });
+}
+
+}
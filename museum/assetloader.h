@@ -0,0 +1,86 @@
+#pragma once
+#ifndef INCLUDED_ASSETLOADER_H
+#define INCLUDED_ASSETLOADER_H
+
+#include <cstddef>
+#include <functional>
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "PV112.h"
+#include "geometryarena.h"
+#include "geometrypool.h"
+
+namespace PV112
+{
+
+/// Loads assets in the background, so that the application can draw frames while they are loading.
+///
+/// Each asset is loaded in two steps. The read step (parsing, decoding, everything without OpenGL) runs
+/// on a worker thread. It returns the upload step, which creates the OpenGL objects and runs on the thread
+/// with the OpenGL context when it calls Update, usually once per frame. Until then, the application draws
+/// a placeholder instead of the asset.
+///
+/// The loader must be used only from the thread with the OpenGL context (except the read steps, which
+/// run on the workers).
+class AssetLoader
+{
+public:
+    /// The step that creates the OpenGL objects of an asset
+    typedef std::function<void()> UploadStep;
+    /// The step that reads an asset and returns its upload step (an empty function if there is nothing
+    /// to upload, for example when the file cannot be read)
+    typedef std::function<UploadStep()> ReadStep;
+
+    /// Starts 'thread_count' worker threads (at least one).
+    explicit AssetLoader(unsigned thread_count = 2);
+
+    /// Stops the workers like Stop.
+    ~AssetLoader();
+
+    /// Waits until the workers finish the read steps they are running, and drops the rest. The upload
+    /// steps are dropped without being called, the OpenGL context may not exist anymore. Call it before
+    /// the objects the read steps write to are destroyed; Load must not be called after it.
+    void Stop();
+
+    /// Queues an asset, the read steps start in the order they are queued.
+    void Load(const ReadStep &read);
+
+    /// Calls the upload steps of the assets that are read, until 'budget_seconds' pass. At least one upload
+    /// step is called if any is ready, a single step is never split, so a large asset may take longer.
+    /// Returns the number of uploaded assets.
+    size_t Update(double budget_seconds);
+
+    /// Returns the number of assets that are not uploaded yet.
+    size_t PendingCount() const;
+
+private:
+    AssetLoader(const AssetLoader &);
+    AssetLoader &operator =(const AssetLoader &);
+
+    void WorkerMain();
+
+    std::vector<std::thread> workers;
+    mutable std::mutex mutex;
+    std::condition_variable read_queued;
+    std::deque<ReadStep> read_queue;
+    std::deque<UploadStep> upload_queue;
+    size_t pending;
+    bool stopping;
+};
+
+/// Loads an OBJ file like LoadOBJ, but in the background. 'target' gets the loaded geometry when it is
+/// uploaded, and gives back the geometry it had until then; it is left as it is if the file cannot be read.
+/// Draw a placeholder while 'target' is empty. 'target' must exist until the upload. If 'arena' is not
+/// null, the geometry is written into it when there is room, otherwise its buffers come from 'pool' if it
+/// is not null (see CreateOBJGeometry).
+void LoadOBJAsync(AssetLoader &loader, GeometryHandle &target, const char *file_name, GLint position_location,
+        GLint normal_location = -1, GLint tex_coord_location = -1, VertexLayout layout = VertexLayout::Float,
+        GLObjectPool *pool = nullptr, GeometryArena *arena = nullptr);
+
+}
+
+#endif	// INCLUDED_ASSETLOADER_H
@@ -0,0 +1,399 @@
+#pragma once
+#ifndef INCLUDED_CONSTEXPRTABLES_H
+#define INCLUDED_CONSTEXPRTABLES_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "meshtools.h"
+
+namespace PV112
+{
+
+/// Array that can be returned from a constexpr function. A namespace-scope constexpr ConstArray is
+/// computed by the compiler and stored in read-only data, 'Data' can be passed to glBufferData directly.
+template <typename T, size_t N>
+struct ConstArray
+{
+    T Data[N];
+
+    constexpr size_t Size() const { return N; }
+    constexpr const T &operator [](size_t index) const { return Data[index]; }
+};
+
+namespace detail
+{
+
+template <size_t... Indices>
+struct IndexSequence
+{
+};
+
+template <typename First, typename Second>
+struct ConcatIndexSequences;
+
+template <size_t... First, size_t... Second>
+struct ConcatIndexSequences<IndexSequence<First...>, IndexSequence<Second...>>
+{
+    typedef IndexSequence<First..., (sizeof...(First) + Second)...> Type;
+};
+
+// 0, 1, ..., N - 1, built by halves so that long tables do not hit the limit of nested templates
+template <size_t N>
+struct MakeIndexSequence
+{
+    typedef typename ConcatIndexSequences<typename MakeIndexSequence<N / 2>::Type,
+            typename MakeIndexSequence<N - N / 2>::Type>::Type Type;
+};
+
+template <>
+struct MakeIndexSequence<0>
+{
+    typedef IndexSequence<> Type;
+};
+
+template <>
+struct MakeIndexSequence<1>
+{
+    typedef IndexSequence<0> Type;
+};
+
+template <typename Generator, size_t... Indices>
+constexpr ConstArray<typename Generator::ValueType, sizeof...(Indices)> GenerateTable(IndexSequence<Indices...>)
+{
+    return {{ Generator::Value(Indices)... }};
+}
+
+}
+
+/// Returns the table of Generator::Value(0) ... Generator::Value(N - 1). The generator is a type with
+/// a ValueType and a static constexpr function Value(size_t index).
+template <typename Generator, size_t N>
+constexpr ConstArray<typename Generator::ValueType, N> GenerateTable()
+{
+    return detail::GenerateTable<Generator>(typename detail::MakeIndexSequence<N>::Type());
+}
+
+//----------------------------------------
+//----    MATH FOR CONSTANT TABLES    ----
+//----------------------------------------
+
+// The functions below give exactly the same results as their counterparts in meshtools.h (the float
+// arithmetic is the same), they only avoid library calls, which cannot be evaluated by the compiler.
+
+constexpr double const_pi = 3.14159265358979323846;
+
+constexpr float ConstAbs(float x)
+{
+    return x < 0.0f ? -x : x;
+}
+
+constexpr float ConstMin(float x, float y)
+{
+    return y < x ? y : x;
+}
+
+constexpr float ConstMax(float x, float y)
+{
+    return y > x ? y : x;
+}
+
+constexpr float ConstClamp(float x, float low, float high)
+{
+    return x < low ? low : (x > high ? high : x);
+}
+
+/// std::floor for values that fit to int64_t
+constexpr double ConstFloor(double x)
+{
+    return double(int64_t(x)) > x ? double(int64_t(x) - 1) : double(int64_t(x));
+}
+
+namespace detail
+{
+
+// Taylor series of sin and cos around 0, enough terms for |x| <= pi/4 in double precision
+constexpr double SinSeries(double x, double term, int n)
+{
+    return n > 27 ? term : term + SinSeries(x, -term * x * x / double((n + 1) * (n + 2)), n + 2);
+}
+
+constexpr double CosSeries(double x, double term, int n)
+{
+    return n > 26 ? term : term + CosSeries(x, -term * x * x / double((n + 1) * (n + 2)), n + 2);
+}
+
+// sin(r + quadrant * pi/2) for |r| <= pi/4
+constexpr double SinQuadrant(double r, int64_t quadrant)
+{
+    return quadrant % 4 == 0 ? SinSeries(r, r, 1) :
+            quadrant % 4 == 1 ? CosSeries(r, 1.0, 0) :
+            quadrant % 4 == 2 ? -SinSeries(r, r, 1) : -CosSeries(r, 1.0, 0);
+}
+
+constexpr int64_t NearestQuadrant(double x)
+{
+    return int64_t(ConstFloor(x / (const_pi / 2.0) + 0.5));
+}
+
+}
+
+/// sin and cos of non-negative angles
+constexpr double ConstSin(double x)
+{
+    return detail::SinQuadrant(x - double(detail::NearestQuadrant(x)) * (const_pi / 2.0), detail::NearestQuadrant(x));
+}
+
+constexpr double ConstCos(double x)
+{
+    return detail::SinQuadrant(x - double(detail::NearestQuadrant(x)) * (const_pi / 2.0), detail::NearestQuadrant(x) + 1);
+}
+
+namespace detail
+{
+
+constexpr double Power2(int exponent)
+{
+    return exponent == 0 ? 1.0 : (exponent > 0 ? 2.0 * Power2(exponent - 1) : 0.5 * Power2(exponent + 1));
+}
+
+// Exponent e of a positive finite value with 2^e <= x < 2^(e + 1), starting from a guess
+constexpr int Exponent(double x, int guess)
+{
+    return x >= Power2(guess + 1) ? Exponent(x, guess + 1) : (x < Power2(guess) ? Exponent(x, guess - 1) : guess);
+}
+
+// Rounds a non-negative value to the nearest integer, ties to even
+constexpr uint32_t RoundToEven(double x)
+{
+    return x - ConstFloor(x) > 0.5 || (x - ConstFloor(x) == 0.5 && uint32_t(ConstFloor(x)) % 2 == 1) ?
+            uint32_t(ConstFloor(x)) + 1 : uint32_t(ConstFloor(x));
+}
+
+// The half of a positive finite value, 'x' times 2^(10 - e) is exact in double
+constexpr uint16_t PositiveFloatToHalf(double x, int exponent)
+{
+    return exponent >= 16 ? uint16_t(0x7C00u) :
+            exponent >= -14 ? uint16_t((uint32_t(exponent + 15) << 10) + RoundToEven(x * Power2(10 - exponent)) - 1024u) :
+            exponent >= -25 ? uint16_t(RoundToEven(x * Power2(24))) : uint16_t(0);
+}
+
+}
+
+/// FloatToHalf of a finite value, except that -0 becomes +0
+constexpr uint16_t ConstFloatToHalf(float value)
+{
+    return value < 0.0f ? uint16_t(0x8000u | ConstFloatToHalf(-value)) :
+            value == 0.0f ? uint16_t(0) : detail::PositiveFloatToHalf(value, detail::Exponent(value, 0));
+}
+
+/// PackNormal
+constexpr uint32_t ConstPackNormal(float x, float y, float z)
+{
+    return (uint32_t(int(ConstFloor(ConstClamp(x, -1.0f, 1.0f) * 511.0f + 0.5f))) & 0x3FFu) |
+            ((uint32_t(int(ConstFloor(ConstClamp(y, -1.0f, 1.0f) * 511.0f + 0.5f))) & 0x3FFu) << 10) |
+            ((uint32_t(int(ConstFloor(ConstClamp(z, -1.0f, 1.0f) * 511.0f + 0.5f))) & 0x3FFu) << 20);
+}
+
+namespace detail
+{
+
+constexpr int16_t OctahedralComponent(float value)
+{
+    return int16_t(ConstFloor(ConstClamp(value, -1.0f, 1.0f) * 32767.0f + 0.5f));
+}
+
+// A coordinate on the octahedron, the lower half is folded over the upper one
+constexpr float OctahedralCoordinate(float coordinate, float other, float z)
+{
+    return z < 0.0f ? (1.0f - ConstAbs(other)) * (coordinate >= 0.0f ? 1.0f : -1.0f) : coordinate;
+}
+
+constexpr int16_t EncodeOctahedral(float x, float y, float z, float length, int component)
+{
+    return !(length > 0.0f) ? int16_t(0) :
+            component == 0 ? OctahedralComponent(OctahedralCoordinate(x / length, y / length, z)) :
+            OctahedralComponent(OctahedralCoordinate(y / length, x / length, z));
+}
+
+}
+
+/// One component (0 or 1) of EncodeOctahedral
+constexpr int16_t ConstEncodeOctahedral(float x, float y, float z, int component)
+{
+    return detail::EncodeOctahedral(x, y, z, ConstAbs(x) + ConstAbs(y) + ConstAbs(z), component);
+}
+
+//------------------------------------
+//----    VERTEX FORMAT TABLES    ----
+//------------------------------------
+
+/// Generators of the packed and quantized vertices of a table of float vertices (8 floats per vertex).
+/// 'Source' has a static constexpr function Get(size_t index) with the floats, and bounds of the
+/// positions BoundsMin(axis) and BoundsMax(axis), see ConstBoundsMin.
+template <typename Source>
+struct PackedVertexGenerator
+{
+    typedef PackedVertex ValueType;
+
+    static constexpr PackedVertex Value(size_t vertex)
+    {
+        return PackedVertex
+        {
+            { Source::Get(vertex * 8 + 0), Source::Get(vertex * 8 + 1), Source::Get(vertex * 8 + 2) },
+            ConstPackNormal(Source::Get(vertex * 8 + 3), Source::Get(vertex * 8 + 4), Source::Get(vertex * 8 + 5)),
+            { ConstFloatToHalf(Source::Get(vertex * 8 + 6)), ConstFloatToHalf(Source::Get(vertex * 8 + 7)) }
+        };
+    }
+};
+
+template <typename Source>
+struct QuantizedVertexGenerator
+{
+    typedef QuantizedVertex ValueType;
+
+    // QuantizeVertices, an axis on which the mesh is flat gets all zeros
+    static constexpr float Scale(int axis)
+    {
+        return Source::BoundsMax(axis) - Source::BoundsMin(axis) > 0.0f ? 65535.0f / (Source::BoundsMax(axis) - Source::BoundsMin(axis)) : 0.0f;
+    }
+
+    static constexpr uint16_t Position(size_t vertex, int axis)
+    {
+        return uint16_t(ConstClamp(float(ConstFloor((Source::Get(vertex * 8 + axis) - Source::BoundsMin(axis)) * Scale(axis) + 0.5f)),
+                0.0f, 65535.0f));
+    }
+
+    static constexpr QuantizedVertex Value(size_t vertex)
+    {
+        return QuantizedVertex
+        {
+            { Position(vertex, 0), Position(vertex, 1), Position(vertex, 2), 0 },
+            {
+                ConstEncodeOctahedral(Source::Get(vertex * 8 + 3), Source::Get(vertex * 8 + 4), Source::Get(vertex * 8 + 5), 0),
+                ConstEncodeOctahedral(Source::Get(vertex * 8 + 3), Source::Get(vertex * 8 + 4), Source::Get(vertex * 8 + 5), 1)
+            },
+            { ConstFloatToHalf(Source::Get(vertex * 8 + 6)), ConstFloatToHalf(Source::Get(vertex * 8 + 7)) }
+        };
+    }
+};
+
+/// Smallest and largest coordinate 'axis' of 'count' float vertices of 'Source' from 'first', split by
+/// halves to keep the recursion shallow
+template <typename Source>
+constexpr float ConstBoundsMin(int axis, size_t first, size_t count)
+{
+    return count == 1 ? Source::Get(first * 8 + axis) :
+            ConstMin(ConstBoundsMin<Source>(axis, first, count / 2), ConstBoundsMin<Source>(axis, first + count / 2, count - count / 2));
+}
+
+template <typename Source>
+constexpr float ConstBoundsMax(int axis, size_t first, size_t count)
+{
+    return count == 1 ? Source::Get(first * 8 + axis) :
+            ConstMax(ConstBoundsMax<Source>(axis, first, count / 2), ConstBoundsMax<Source>(axis, first + count / 2, count - count / 2));
+}
+
+//--------------------------------------
+//----    TRIANGLE STRIP TO LIST    ----
+//--------------------------------------
+
+/// Converts a triangle strip to a list of triangles like TriangleStripToList. 'Strip' has a static
+/// constexpr function Get(size_t index) with the indices of the strip, 'IndexCount' of them.
+///
+/// Without loops, the position of a triangle in the list cannot be found by counting the dropped ones
+/// before it, that would take time quadratic in the length of the strip. The strip is therefore split
+/// into blocks, KeptBefore(block) (a table, see StripBlockGenerator) is the number of triangles in the
+/// blocks before it. The list is then generated by StripListGenerator, the kept triangles are found by a
+/// binary search over the blocks and a scan of a single block.
+template <typename Strip, size_t IndexCount>
+struct StripTriangles
+{
+    static constexpr size_t block_size = 32;
+
+    static constexpr unsigned int Get(size_t index)
+    {
+        return Strip::Get(index);
+    }
+
+    static constexpr size_t TriangleCount()
+    {
+        return IndexCount < 3 ? 0 : IndexCount - 2;
+    }
+
+    static constexpr size_t BlockCount()
+    {
+        return (TriangleCount() + block_size - 1) / block_size;
+    }
+
+    // The degenerate triangles that join several strips into one are dropped
+    static constexpr bool IsKept(size_t triangle)
+    {
+        return triangle < TriangleCount() && Strip::Get(triangle) != Strip::Get(triangle + 1) &&
+                Strip::Get(triangle + 1) != Strip::Get(triangle + 2) && Strip::Get(triangle) != Strip::Get(triangle + 2);
+    }
+
+    // Number of the kept triangles in a range, split by halves to keep the recursion shallow
+    static constexpr size_t CountKept(size_t first, size_t count)
+    {
+        return count == 0 ? 0 : (count == 1 ? (IsKept(first) ? 1 : 0) : CountKept(first, count / 2) + CountKept(first + count / 2, count - count / 2));
+    }
+
+    static constexpr size_t KeptCount()
+    {
+        return CountKept(0, TriangleCount());
+    }
+};
+
+template <typename Triangles>
+struct StripBlockGenerator
+{
+    typedef uint32_t ValueType;
+
+    static constexpr uint32_t Value(size_t block)
+    {
+        return uint32_t(Triangles::CountKept(0, block * Triangles::block_size));
+    }
+};
+
+/// 'Blocks' is StripTriangles with the table of StripBlockGenerator as a static constexpr function
+/// KeptBefore(size_t block).
+template <typename Blocks>
+struct StripListGenerator
+{
+    typedef unsigned int ValueType;
+
+    // The last block with at most 'kept' triangles before it, between 'low' and 'high' (exclusive)
+    static constexpr size_t FindBlock(size_t kept, size_t low, size_t high)
+    {
+        return high - low <= 1 ? low :
+                (Blocks::KeptBefore((low + high) / 2) <= kept ? FindBlock(kept, (low + high) / 2, high) : FindBlock(kept, low, (low + high) / 2));
+    }
+
+    // The kept triangle that is 'skip' kept triangles after 'triangle'
+    static constexpr size_t FindKept(size_t triangle, size_t skip)
+    {
+        return Blocks::IsKept(triangle) ? (skip == 0 ? triangle : FindKept(triangle + 1, skip - 1)) : FindKept(triangle + 1, skip);
+    }
+
+    static constexpr size_t StripTriangle(size_t kept)
+    {
+        return FindKept(FindBlock(kept, 0, Blocks::BlockCount()) * Blocks::block_size,
+                kept - Blocks::KeptBefore(FindBlock(kept, 0, Blocks::BlockCount())));
+    }
+
+    // Every other triangle of a strip has the opposite order of vertices
+    static constexpr unsigned int Corner(size_t triangle, size_t corner)
+    {
+        return Blocks::Get(triangle + (corner == 2 ? 2 : (triangle % 2 == 1 ? 1 - corner : corner)));
+    }
+
+    static constexpr unsigned int Value(size_t index)
+    {
+        return Corner(StripTriangle(index / 3), index % 3);
+    }
+};
+
+}
+
+#endif	// INCLUDED_CONSTEXPRTABLES_H
@@ -5,6 +5,7 @@ out vec4 final_color;
 in vec3 VS_normal_ws;
 in vec3 VS_position_ws;
 in vec2 VS_tex_coord;
+flat in int VS_layer;
 
 uniform vec3 material_ambient_color;
 uniform vec3 material_diffuse_color;
@@ -19,6 +20,9 @@ uniform vec3 light_specular_color;
 uniform vec3 eye_position;
 
 uniform sampler2D my_tex;
+// Set for the instances of a texture array, VS_layer selects their layer
+uniform sampler2DArray my_tex_array;
+uniform bool use_tex_array = false;
 
 uniform int procedural_tex_type;
 
@@ -138,7 +142,8 @@ vec3 get_marble_color() {
 
 void main()
 {
-    vec4 tex_color_alpha = texture(my_tex, VS_tex_coord.xy);
+    vec4 tex_color_alpha = use_tex_array ? texture(my_tex_array, vec3(VS_tex_coord.xy, float(VS_layer)))
+      : texture(my_tex, VS_tex_coord.xy);
     vec3 tex_color = tex_color_alpha.rgb;
     float alpha = tex_color_alpha.a;
 
@@ -0,0 +1,295 @@
+#include "geometryarena.h"
+#include "geometrypool.h"
+
+namespace PV112
+{
+
+//-------------------------------
+//----    RANGE ALLOCATOR    ----
+//-------------------------------
+
+RangeAllocator::RangeAllocator(size_t capacity)
+{
+    Reset(capacity);
+}
+
+void RangeAllocator::Reset(size_t new_capacity)
+{
+    free_ranges.clear();
+    used_ranges.clear();
+    capacity = new_capacity;
+    used_count = 0;
+    if (capacity > 0)
+        free_ranges[0] = capacity;
+}
+
+size_t RangeAllocator::Allocate(size_t count)
+{
+    if (count == 0)
+        return invalid;
+
+    // The ranges are few (one per geometry), a linear search is fine
+    for (std::map<size_t, size_t>::iterator it = free_ranges.begin(); it != free_ranges.end(); ++it)
+    {
+        if (it->second < count)
+            continue;
+
+        const size_t first = it->first;
+        const size_t rest = it->second - count;
+        free_ranges.erase(it);
+        if (rest > 0)
+            free_ranges[first + count] = rest;
+        used_ranges[first] = count;
+        used_count += count;
+        return first;
+    }
+    return invalid;
+}
+
+void RangeAllocator::Free(size_t first)
+{
+    std::map<size_t, size_t>::iterator used = used_ranges.find(first);
+    if (used == used_ranges.end())
+        return;
+    size_t count = used->second;
+    used_ranges.erase(used);
+    used_count -= count;
+
+    // Merge with the free range that follows, and with the one that precedes
+    std::map<size_t, size_t>::iterator next = free_ranges.find(first + count);
+    if (next != free_ranges.end())
+    {
+        count += next->second;
+        free_ranges.erase(next);
+    }
+    std::map<size_t, size_t>::iterator inserted = free_ranges.insert(std::make_pair(first, count)).first;
+    if (inserted != free_ranges.begin())
+    {
+        std::map<size_t, size_t>::iterator previous = inserted;
+        --previous;
+        if (previous->first + previous->second == first)
+        {
+            previous->second += count;
+            free_ranges.erase(inserted);
+        }
+    }
+}
+
+size_t RangeAllocator::Capacity() const
+{
+    return capacity;
+}
+
+size_t RangeAllocator::UsedCount() const
+{
+    return used_count;
+}
+
+//------------------------------
+//----    GEOMETRY ARENA    ----
+//------------------------------
+
+GeometryArena::GeometryArena()
+    : index_buffer(0), vertex_capacity(0), position_location(-1), normal_location(-1), tex_coord_location(-1)
+{
+    for (int i = 0; i < layout_count; i++)
+    {
+        layouts[i].VertexBuffer = 0;
+        layouts[i].VAO = 0;
+    }
+}
+
+bool GeometryArena::Create(size_t new_vertex_capacity, size_t index_capacity, GLint new_position_location,
+        GLint new_normal_location, GLint new_tex_coord_location)
+{
+    if (index_buffer != 0)
+        return false;
+
+    glGenBuffers(1, &index_buffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, index_buffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, index_capacity * sizeof(unsigned int), nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    indices.Reset(index_capacity);
+
+    vertex_capacity = new_vertex_capacity;
+    position_location = new_position_location;
+    normal_location = new_normal_location;
+    tex_coord_location = new_tex_coord_location;
+    return true;
+}
+
+void GeometryArena::Destroy()
+{
+    for (int i = 0; i < layout_count; i++)
+    {
+        glDeleteBuffers(1, &layouts[i].VertexBuffer);
+        glDeleteVertexArrays(1, &layouts[i].VAO);
+        layouts[i].VertexBuffer = 0;
+        layouts[i].VAO = 0;
+        layouts[i].Vertices.Reset(0);
+    }
+    glDeleteBuffers(1, &index_buffer);
+    index_buffer = 0;
+    indices.Reset(0);
+}
+
+void GeometryArena::CreateLayout(VertexLayout layout)
+{
+    LayoutBuffers &buffers = layouts[int(layout)];
+    const size_t vertex_size = GetVertexLayoutSize(layout);
+
+    glGenBuffers(1, &buffers.VertexBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, buffers.VertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, vertex_capacity / vertex_size * vertex_size, nullptr, GL_STATIC_DRAW);
+    buffers.Vertices.Reset(vertex_capacity / vertex_size);
+
+    // The attributes point to the beginning of the buffer, the draw calls add the base vertex
+    glGenVertexArrays(1, &buffers.VAO);
+    glBindVertexArray(buffers.VAO);
+    SetVertexAttributes(layout, position_location, normal_location, tex_coord_location);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, index_buffer);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+bool GeometryArena::AllocateRanges(VertexLayout layout, size_t vertex_count, size_t index_count, size_t &first_vertex,
+        size_t &first_index)
+{
+    LayoutBuffers &buffers = layouts[int(layout)];
+    if (buffers.VAO == 0)
+        CreateLayout(layout);
+
+    first_vertex = buffers.Vertices.Allocate(vertex_count);
+    if (first_vertex == RangeAllocator::invalid)
+        return false;
+    first_index = indices.Allocate(index_count);
+    if (first_index == RangeAllocator::invalid)
+    {
+        buffers.Vertices.Free(first_vertex);
+        return false;
+    }
+    return true;
+}
+
+bool GeometryArena::Add(PV112Geometry &geom, GLObjectPool *pool)
+{
+    if (index_buffer == 0 || geom.SharedBuffers || geom.IndexBuffer == 0 || geom.VertexBuffers[0] == 0 ||
+            geom.VertexBuffers[1] != 0 || geom.VertexBuffers[2] != 0)
+        return false;
+
+    // The sizes of the data are those of the buffers of the geometry, the index buffer contains all levels
+    // of detail
+    GLint vertex_bytes = 0, index_bytes = 0;
+    glBindBuffer(GL_COPY_READ_BUFFER, geom.VertexBuffers[0]);
+    glGetBufferParameteriv(GL_COPY_READ_BUFFER, GL_BUFFER_SIZE, &vertex_bytes);
+    glBindBuffer(GL_COPY_READ_BUFFER, geom.IndexBuffer);
+    glGetBufferParameteriv(GL_COPY_READ_BUFFER, GL_BUFFER_SIZE, &index_bytes);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+    const size_t vertex_size = GetVertexLayoutSize(geom.Layout);
+    const size_t vertex_count = size_t(vertex_bytes) / vertex_size;
+    const size_t index_count = size_t(index_bytes) / sizeof(unsigned int);
+    size_t first_vertex, first_index;
+    if (!AllocateRanges(geom.Layout, vertex_count, index_count, first_vertex, first_index))
+        return false;
+
+    const LayoutBuffers &buffers = layouts[int(geom.Layout)];
+    glBindBuffer(GL_COPY_READ_BUFFER, geom.VertexBuffers[0]);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffers.VertexBuffer);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, first_vertex * vertex_size, vertex_count * vertex_size);
+    glBindBuffer(GL_COPY_READ_BUFFER, geom.IndexBuffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, index_buffer);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, first_index * sizeof(unsigned int), index_count * sizeof(unsigned int));
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    // OpenGL finishes the copies before the buffers are really deleted or filled with other data
+    if (pool != nullptr)
+    {
+        pool->ReleaseBuffer(geom.VertexBuffers[0]);
+        pool->ReleaseBuffer(geom.IndexBuffer);
+        pool->ReleaseVertexArray(geom.VAO);
+    }
+    else
+    {
+        glDeleteBuffers(1, &geom.VertexBuffers[0]);
+        glDeleteBuffers(1, &geom.IndexBuffer);
+        glDeleteVertexArrays(1, &geom.VAO);
+    }
+
+    geom.VertexBuffers[0] = buffers.VertexBuffer;
+    geom.IndexBuffer = index_buffer;
+    geom.VAO = buffers.VAO;
+    geom.SharedBuffers = true;
+    geom.BaseVertex = GLint(first_vertex);
+    geom.BaseIndex = GLsizei(first_index);
+    return true;
+}
+
+bool GeometryArena::Add(VertexLayout layout, const void *vertex_data, size_t vertex_data_size, const unsigned int *index_data,
+        size_t index_count, PV112Geometry &out)
+{
+    if (index_buffer == 0)
+        return false;
+
+    const size_t vertex_size = GetVertexLayoutSize(layout);
+    const size_t vertex_count = vertex_data_size / vertex_size;
+    size_t first_vertex, first_index;
+    if (!AllocateRanges(layout, vertex_count, index_count, first_vertex, first_index))
+        return false;
+
+    const LayoutBuffers &buffers = layouts[int(layout)];
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffers.VertexBuffer);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, first_vertex * vertex_size, vertex_count * vertex_size, vertex_data);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, index_buffer);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, first_index * sizeof(unsigned int), index_count * sizeof(unsigned int), index_data);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    out.Layout = layout;
+    out.VertexBuffers[0] = buffers.VertexBuffer;
+    out.VertexBuffers[1] = 0;
+    out.VertexBuffers[2] = 0;
+    out.IndexBuffer = index_buffer;
+    out.VAO = buffers.VAO;
+    out.SharedBuffers = true;
+    out.BaseVertex = GLint(first_vertex);
+    out.BaseIndex = GLsizei(first_index);
+    out.Mode = GL_TRIANGLES;
+    out.DrawArraysCount = 0;
+    out.DrawElementsCount = GLsizei(index_count);
+    return true;
+}
+
+void GeometryArena::Remove(PV112Geometry &geom)
+{
+    if (!geom.SharedBuffers || index_buffer == 0 || geom.IndexBuffer != index_buffer)
+        return;
+
+    layouts[int(geom.Layout)].Vertices.Free(size_t(geom.BaseVertex));
+    indices.Free(size_t(geom.BaseIndex));
+    geom = PV112Geometry();
+}
+
+GLuint GeometryArena::VAO(VertexLayout layout) const
+{
+    return layouts[int(layout)].VAO;
+}
+
+size_t GeometryArena::UsedVertexBytes(VertexLayout layout) const
+{
+    return layouts[int(layout)].Vertices.UsedCount() * GetVertexLayoutSize(layout);
+}
+
+size_t GeometryArena::UsedIndexCount() const
+{
+    return indices.UsedCount();
+}
+
+size_t GeometryArena::IndexCapacity() const
+{
+    return indices.Capacity();
+}
+
+}
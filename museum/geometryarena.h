@@ -0,0 +1,126 @@
+#pragma once
+#ifndef INCLUDED_GEOMETRYARENA_H
+#define INCLUDED_GEOMETRYARENA_H
+
+#include <cstddef>
+#include <map>
+
+#include "PV112.h"
+
+namespace PV112
+{
+
+/// Hands out ranges of a fixed number of units, for example vertices or indices of a large buffer shared
+/// by many objects. The first free range that is large enough is used, and a freed range merges with the
+/// free ranges next to it.
+class RangeAllocator
+{
+public:
+    /// Returned by Allocate when there is no room
+    static const size_t invalid = size_t(-1);
+
+    explicit RangeAllocator(size_t capacity = 0);
+
+    /// Frees all ranges and changes the capacity.
+    void Reset(size_t capacity);
+
+    /// Returns the first unit of a free range of 'count' units (at least one), or 'invalid'.
+    size_t Allocate(size_t count);
+
+    /// Frees a range returned by Allocate, other values are ignored.
+    void Free(size_t first);
+
+    size_t Capacity() const;
+    size_t UsedCount() const;
+
+private:
+    // First unit -> number of units
+    std::map<size_t, size_t> free_ranges;
+    std::map<size_t, size_t> used_ranges;
+    size_t capacity;
+    size_t used_count;
+};
+
+/// A few large buffers shared by many geometries, so that they can be drawn one after another without
+/// binding another VAO. There is one vertex buffer and one VAO for each VertexLayout (created when a
+/// geometry in that layout is added first), and one index buffer for all of them.
+///
+/// A geometry in the arena keeps its index ranges, and records where its vertices and indices start
+/// (PV112Geometry::BaseVertex and BaseIndex). The draw functions of PV112.h use glDrawElementsBaseVertex,
+/// so they work for the geometries with their own buffers and for those in an arena alike.
+///
+/// Like PV112Geometry, the arena does not delete its OpenGL objects by itself, call Destroy while the
+/// OpenGL context exists.
+class GeometryArena
+{
+public:
+    GeometryArena();
+
+    /// Creates the index buffer with room for 'index_capacity' indices. Every vertex buffer will have
+    /// 'vertex_capacity' bytes. The VAOs read the attributes from the given locations, so all geometries
+    /// in the arena must use them. Returns false if the arena already exists.
+    bool Create(size_t vertex_capacity, size_t index_capacity, GLint position_location, GLint normal_location = -1,
+            GLint tex_coord_location = -1);
+
+    /// Deletes the buffers and the VAOs, the geometries in the arena cannot be drawn anymore.
+    void Destroy();
+
+    /// Moves an indexed geometry with all its vertices in a single buffer (like those of LoadOBJ and the
+    /// basic objects) into the arena. Its data is copied by OpenGL (glCopyBufferSubData), and its own
+    /// buffers and VAO are given back to 'pool', or deleted if it is null.
+    ///
+    /// Returns false and leaves the geometry as it is if it is not such a geometry, it is already in an
+    /// arena, or there is not enough room.
+    bool Add(PV112Geometry &geom, GLObjectPool *pool = nullptr);
+
+    /// Writes the vertices (in 'layout') and the indices of a list of triangles from memory straight into
+    /// the arena with glBufferSubData, without buffers of their own. 'out' gets the buffers and the VAO of
+    /// the arena, BaseVertex and BaseIndex, and draws all indices; the rest of it is left as it is.
+    ///
+    /// Returns false and leaves 'out' as it is if there is not enough room.
+    bool Add(VertexLayout layout, const void *vertex_data, size_t vertex_data_size, const unsigned int *index_data,
+            size_t index_count, PV112Geometry &out);
+
+    /// Frees the space of a geometry added to this arena and resets the geometry. Copies of the geometry
+    /// must not be drawn anymore.
+    void Remove(PV112Geometry &geom);
+
+    /// Returns the VAO shared by the geometries in 'layout', 0 if there is none yet.
+    GLuint VAO(VertexLayout layout) const;
+
+    /// Used and total space, in bytes of the vertex buffer of 'layout' and in indices.
+    size_t UsedVertexBytes(VertexLayout layout) const;
+    size_t UsedIndexCount() const;
+    size_t IndexCapacity() const;
+
+private:
+    GeometryArena(const GeometryArena &);
+    GeometryArena &operator =(const GeometryArena &);
+
+    // Buffers of a single vertex layout, the allocator counts vertices
+    struct LayoutBuffers
+    {
+        GLuint VertexBuffer;
+        GLuint VAO;
+        RangeAllocator Vertices;
+    };
+
+    void CreateLayout(VertexLayout layout);
+
+    // Allocates the ranges of a geometry, creating the buffers of its layout if needed. Returns false if
+    // there is not enough room for both.
+    bool AllocateRanges(VertexLayout layout, size_t vertex_count, size_t index_count, size_t &first_vertex, size_t &first_index);
+
+    static const int layout_count = 3;
+    LayoutBuffers layouts[layout_count];
+    GLuint index_buffer;
+    RangeAllocator indices;
+    size_t vertex_capacity;
+    GLint position_location;
+    GLint normal_location;
+    GLint tex_coord_location;
+};
+
+}
+
+#endif	// INCLUDED_GEOMETRYARENA_H
@@ -0,0 +1,241 @@
+#include "geometrypool.h"
+
+#include <iterator>
+
+#include "geometryarena.h"
+
+namespace PV112
+{
+
+//------------------------------
+//----    GL OBJECT POOL    ----
+//------------------------------
+
+GLObjectPool::GLObjectPool(size_t new_max_pooled_bytes)
+    : pooled_bytes(0), max_pooled_bytes(new_max_pooled_bytes)
+{
+}
+
+GLuint GLObjectPool::AcquireBuffer(GLenum target, size_t size, const void *data)
+{
+    // A buffer of the same size keeps its storage, only the data are replaced. The most recently released
+    // buffers are the most likely to match a model that is loaded again.
+    for (std::deque<PooledBuffer>::reverse_iterator it = buffers.rbegin(); it != buffers.rend(); ++it)
+    {
+        if (it->Size != size)
+            continue;
+
+        const GLuint buffer = it->Name;
+        pooled_bytes -= it->Size;
+        buffers.erase(std::next(it).base());
+
+        glBindBuffer(target, buffer);
+        if (data != nullptr)
+            glBufferSubData(target, 0, size, data);
+        glBindBuffer(target, 0);
+        return buffer;
+    }
+
+    // Otherwise the oldest name gets new storage
+    GLuint buffer = 0;
+    if (!buffers.empty())
+    {
+        buffer = buffers.front().Name;
+        pooled_bytes -= buffers.front().Size;
+        buffers.pop_front();
+    }
+    else
+    {
+        glGenBuffers(1, &buffer);
+    }
+    glBindBuffer(target, buffer);
+    glBufferData(target, size, data, GL_STATIC_DRAW);
+    glBindBuffer(target, 0);
+    return buffer;
+}
+
+GLuint GLObjectPool::AcquireVertexArray()
+{
+    GLuint vao = 0;
+    if (!vertex_arrays.empty())
+    {
+        vao = vertex_arrays.back();
+        vertex_arrays.pop_back();
+    }
+    else
+    {
+        glGenVertexArrays(1, &vao);
+    }
+    return vao;
+}
+
+void GLObjectPool::ReleaseBuffer(GLuint buffer)
+{
+    if (buffer == 0)
+        return;
+
+    GLint size = 0;
+    glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+    glGetBufferParameteriv(GL_COPY_READ_BUFFER, GL_BUFFER_SIZE, &size);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+    PooledBuffer pooled;
+    pooled.Name = buffer;
+    pooled.Size = size_t(size);
+    buffers.push_back(pooled);
+    pooled_bytes += pooled.Size;
+    Trim(max_pooled_bytes);
+}
+
+void GLObjectPool::ReleaseVertexArray(GLuint vao)
+{
+    if (vao == 0)
+        return;
+
+    // The next geometry may use other attributes, none of the old ones may stay enabled
+    GLint max_attributes = 0;
+    glGetIntegerv(GL_MAX_VERTEX_ATTRIBS, &max_attributes);
+    glBindVertexArray(vao);
+    for (GLint i = 0; i < max_attributes; i++)
+        glDisableVertexAttribArray(GLuint(i));
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+
+    vertex_arrays.push_back(vao);
+}
+
+void GLObjectPool::Release(PV112Geometry &geom)
+{
+    if (!geom.SharedBuffers)
+    {
+        ReleaseVertexArray(geom.VAO);
+        for (int i = 0; i < 3; i++)
+            ReleaseBuffer(geom.VertexBuffers[i]);
+        ReleaseBuffer(geom.IndexBuffer);
+    }
+    geom = PV112Geometry();
+}
+
+void GLObjectPool::Trim(size_t max_bytes)
+{
+    while (pooled_bytes > max_bytes)
+    {
+        glDeleteBuffers(1, &buffers.front().Name);
+        pooled_bytes -= buffers.front().Size;
+        buffers.pop_front();
+    }
+}
+
+void GLObjectPool::Clear()
+{
+    for (size_t i = 0; i < buffers.size(); i++)
+        glDeleteBuffers(1, &buffers[i].Name);
+    buffers.clear();
+    pooled_bytes = 0;
+
+    if (!vertex_arrays.empty())
+        glDeleteVertexArrays(GLsizei(vertex_arrays.size()), vertex_arrays.data());
+    vertex_arrays.clear();
+}
+
+size_t GLObjectPool::PooledBytes() const
+{
+    return pooled_bytes;
+}
+
+size_t GLObjectPool::PooledBufferCount() const
+{
+    return buffers.size();
+}
+
+//-------------------------------
+//----    GEOMETRY HANDLE    ----
+//-------------------------------
+
+GeometryHandle::GeometryHandle()
+    : pool(nullptr), arena(nullptr)
+{
+}
+
+GeometryHandle::GeometryHandle(PV112Geometry &&geom, GLObjectPool *new_pool, GeometryArena *new_arena)
+    : geometry(geom), pool(new_pool), arena(new_arena)
+{
+    geom = PV112Geometry();
+}
+
+GeometryHandle::GeometryHandle(GeometryHandle &&rhs)
+    : geometry(rhs.geometry), pool(rhs.pool), arena(rhs.arena)
+{
+    rhs.Release();
+}
+
+GeometryHandle &GeometryHandle::operator =(GeometryHandle &&rhs)
+{
+    if (this != &rhs)
+    {
+        GLObjectPool *const rhs_pool = rhs.pool;
+        GeometryArena *const rhs_arena = rhs.arena;
+        Reset(rhs.Release(), rhs_pool, rhs_arena);
+    }
+    return *this;
+}
+
+GeometryHandle::~GeometryHandle()
+{
+    Reset();
+}
+
+void GeometryHandle::Reset()
+{
+    Reset(PV112Geometry());
+}
+
+void GeometryHandle::Reset(PV112Geometry &&geom, GLObjectPool *new_pool, GeometryArena *new_arena)
+{
+    // An empty handle does not call OpenGL at all, it may be destroyed without a context
+    if (geometry.VAO != 0)
+    {
+        if (geometry.SharedBuffers && arena != nullptr)
+            arena->Remove(geometry);
+        else if (pool != nullptr)
+            pool->Release(geometry);
+        else
+            DeleteGeometry(geometry);
+    }
+
+    geometry = geom;
+    pool = new_pool;
+    arena = new_arena;
+    geom = PV112Geometry();
+}
+
+PV112Geometry GeometryHandle::Release()
+{
+    PV112Geometry released = geometry;
+    geometry = PV112Geometry();
+    pool = nullptr;
+    arena = nullptr;
+    return released;
+}
+
+bool GeometryHandle::Empty() const
+{
+    return geometry.VAO == 0;
+}
+
+const PV112Geometry &GeometryHandle::Get() const
+{
+    return geometry;
+}
+
+const PV112Geometry &GeometryHandle::operator *() const
+{
+    return geometry;
+}
+
+const PV112Geometry *GeometryHandle::operator ->() const
+{
+    return &geometry;
+}
+
+}
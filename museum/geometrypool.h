@@ -0,0 +1,118 @@
+#pragma once
+#ifndef INCLUDED_GEOMETRYPOOL_H
+#define INCLUDED_GEOMETRYPOOL_H
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+#include "PV112.h"
+
+namespace PV112
+{
+
+class GeometryArena;
+
+/// Keeps the buffers and VAOs of released geometries instead of deleting them, and gives them to the
+/// geometries created next. A model that is unloaded and loaded again (or replaced by one of the same
+/// size) gets back the same buffers, so OpenGL neither allocates new storage nor frees the old one.
+///
+/// A pooled buffer is given only for exactly the size it has, so that GL_BUFFER_SIZE of a buffer is
+/// always the size of its data (GeometryArena::Add relies on that). For other sizes, only the name of a
+/// pooled buffer is reused and its storage is replaced by glBufferData.
+///
+/// The pool keeps at most 'max_pooled_bytes' of buffer storage, the buffers released the earliest are
+/// deleted first. Like PV112Geometry, the pool does not delete its objects by itself, call Clear while
+/// the OpenGL context exists.
+class GLObjectPool
+{
+public:
+    explicit GLObjectPool(size_t max_pooled_bytes = 64 * 1024 * 1024);
+
+    /// Returns a buffer with 'size' bytes of 'data' (may be nullptr), a pooled one if there is any. The
+    /// buffer is not left bound to 'target'.
+    GLuint AcquireBuffer(GLenum target, size_t size, const void *data);
+
+    /// Returns a VAO without any enabled attribute and without an index buffer.
+    GLuint AcquireVertexArray();
+
+    /// Puts a buffer or a VAO to the pool. Zero is ignored.
+    void ReleaseBuffer(GLuint buffer);
+    void ReleaseVertexArray(GLuint vao);
+
+    /// Puts the buffers and the VAO of a geometry to the pool and resets the geometry. A geometry in
+    /// a GeometryArena is only reset, remove it from the arena to free its space.
+    void Release(PV112Geometry &geom);
+
+    /// Deletes the pooled objects until at most 'max_bytes' of storage is left.
+    void Trim(size_t max_bytes);
+
+    /// Deletes all pooled objects.
+    void Clear();
+
+    size_t PooledBytes() const;
+    size_t PooledBufferCount() const;
+
+private:
+    GLObjectPool(const GLObjectPool &);
+    GLObjectPool &operator =(const GLObjectPool &);
+
+    struct PooledBuffer
+    {
+        GLuint Name;
+        size_t Size;
+    };
+
+    // In the order of release, the oldest first
+    std::deque<PooledBuffer> buffers;
+    std::vector<GLuint> vertex_arrays;
+    size_t pooled_bytes;
+    size_t max_pooled_bytes;
+};
+
+/// Owns the OpenGL objects of a geometry. Unlike PV112Geometry, a handle cannot be copied, only moved,
+/// and it gives the objects back when it is destroyed or reset: to the arena (if the geometry was added
+/// to one), to the pool (if it has one), or it deletes them.
+///
+/// A handle takes only a geometry that nobody else uses, a temporary like the result of CreateOBJGeometry
+/// or a geometry passed with std::move. A handle made from a copy of a geometry that is still drawn (for
+/// example a placeholder) would give back the objects of the original.
+///
+/// The destructor calls OpenGL, so a handle must not outlive the OpenGL context (see the note in
+/// PV112Geometry). Global handles should be reset before the main window is closed.
+class GeometryHandle
+{
+public:
+    GeometryHandle();
+    explicit GeometryHandle(PV112Geometry &&geom, GLObjectPool *pool = nullptr, GeometryArena *arena = nullptr);
+    GeometryHandle(GeometryHandle &&rhs);
+    GeometryHandle &operator =(GeometryHandle &&rhs);
+    ~GeometryHandle();
+
+    /// Gives back the objects of the current geometry, the handle becomes empty.
+    void Reset();
+    /// Gives back the objects of the current geometry and takes a new one.
+    void Reset(PV112Geometry &&geom, GLObjectPool *pool = nullptr, GeometryArena *arena = nullptr);
+
+    /// Returns the geometry without giving back its objects, the handle becomes empty.
+    PV112Geometry Release();
+
+    /// Returns true if the handle has no geometry, for example before a model is loaded.
+    bool Empty() const;
+
+    const PV112Geometry &Get() const;
+    const PV112Geometry &operator *() const;
+    const PV112Geometry *operator ->() const;
+
+private:
+    GeometryHandle(const GeometryHandle &);
+    GeometryHandle &operator =(const GeometryHandle &);
+
+    PV112Geometry geometry;
+    GLObjectPool *pool;
+    GeometryArena *arena;
+};
+
+}
+
+#endif	// INCLUDED_GEOMETRYPOOL_H
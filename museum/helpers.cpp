@@ -1,10 +1,40 @@
 #include "helpers.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "imagedecode.h"
+#include "mappedfile.h"
+#include "parallel.h"
+#include "texturecache.h"
 
 using namespace std;
 
-bool LoadAndSetTexture(const maybewchar *filename, GLenum target)
+namespace {
+
+// DevIL keeps the bound image and the errors in global state
+std::mutex devil_mutex;
+
+// Reads the whole file, the decoders of imagedecode.h take the data from memory
+bool ReadFileData(const maybewchar *filename, std::vector<unsigned char> &data)
+{
+  std::ifstream file(filename, std::ios::binary);
+  if (!file)
+    return false;
+  data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  return !file.bad();
+}
+
+// Decodes the formats the thread-safe decoders do not support, one image at a time
+bool DecodeTextureDevIL(const maybewchar *filename, TextureImage &image)
 {
+  std::lock_guard<std::mutex> lock(devil_mutex);
+
   // Create IL image
   ILuint IL_tex;
   ilGenImages(1, &IL_tex);
@@ -52,10 +82,14 @@ bool LoadAndSetTexture(const maybewchar *filename, GLenum target)
       return false;
   }
 
-  // Set the data to OpenGL (assumes texture object is already bound)
-  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-  glTexImage2D(target, 0, internal_format, img_width, img_height, 0, format,
-          type, ilGetData());
+  // Copy the pixels out of DevIL, they are uploaded later
+  image.width = img_width;
+  image.height = img_height;
+  image.internal_format = internal_format;
+  image.format = format;
+  image.type = type;
+  const ILubyte *data = ilGetData();
+  image.data.assign(data, data + ilGetInteger(IL_IMAGE_SIZE_OF_DATA));
 
   // Unset and delete IL texture
   ilBindImage(0);
@@ -64,6 +98,353 @@ bool LoadAndSetTexture(const maybewchar *filename, GLenum target)
   return true;
 }
 
+// PNG, JPEG, and TGA files are decoded without any lock, the threads of the asset loader decode them
+// all at once
+bool DecodeTextureData(const maybewchar *filename, const unsigned char *file_data, size_t file_size, TextureImage &image)
+{
+  PV112::DecodedImage decoded;
+  if (PV112::DecodeImage(file_data, file_size, decoded))
+  {
+    image.width = decoded.Width;
+    image.height = decoded.Height;
+    image.internal_format = decoded.Channels == 4 ? GL_RGBA : GL_RGB;
+    image.format = decoded.Channels == 4 ? GL_RGBA : GL_RGB;
+    image.type = GL_UNSIGNED_BYTE;
+    image.data.swap(decoded.Pixels);
+    return true;
+  }
+
+  return DecodeTextureDevIL(filename, image);
+}
+
+// The caches take narrow file names, the names of the textures are ASCII
+std::string NarrowFileName(const maybewchar *filename)
+{
+  std::string name;
+  for (; *filename; filename++)
+    name.push_back(char(*filename));
+  return name;
+}
+
+// Loads the compressed texture from the cache next to the image, or compresses the image and writes the
+// cache. Returns false if the image should be uploaded uncompressed, 'image' has its pixels then (or it is
+// empty if the file cannot be read).
+bool LoadCompressedTexture(const maybewchar *filename, PV112::TextureCache &cache, PV112::CompressedTexture &compressed,
+    TextureImage &image)
+{
+  const std::string source_name = NarrowFileName(filename);
+  PV112::MappedFile source;
+  if (!source.Open(source_name.c_str()))
+  {
+    DecodeTexture(filename, image);
+    return false;
+  }
+
+  const PV112::SourceStamp source_stamp = PV112::GetSourceStamp(source);
+  const std::string cache_name = PV112::GetTextureCacheFileName(source_name.c_str());
+  if (cache.Open(cache_name.c_str(), source_stamp))
+    return true;
+
+  const unsigned char *file_data = reinterpret_cast<const unsigned char *>(source.Data());
+  if (!DecodeTextureData(filename, file_data, source.Size(), image) || image.type != GL_UNSIGNED_BYTE ||
+      (image.format != GL_RGB && image.format != GL_RGBA))
+    return false;
+
+  PV112::CompressTexture(image.data.data(), image.width, image.height, image.format == GL_RGBA ? 4 : 3, compressed);
+  if (!PV112::WriteTextureCache(cache_name.c_str(), source_stamp, compressed))
+    cout << "Cannot write texture cache " << cache_name << endl;
+  return true;
+}
+
+// Decodes an image and resizes it to the size of the layers of a texture array, only 8-bit RGB and RGBA
+// images can be resized
+bool LoadTextureLayer(const maybewchar *filename, const PV112::MappedFile &source, int width, int height, TextureImage &image)
+{
+  TextureImage decoded;
+  if (!DecodeTextureData(filename, reinterpret_cast<const unsigned char *>(source.Data()), source.Size(), decoded))
+    return false;
+  if (decoded.type != GL_UNSIGNED_BYTE || (decoded.format != GL_RGB && decoded.format != GL_RGBA))
+  {
+    cerr << "Texture " << filename << " has unsupported format for a texture array\n";
+    return false;
+  }
+
+  image.width = width;
+  image.height = height;
+  image.internal_format = decoded.internal_format;
+  image.format = decoded.format;
+  image.type = decoded.type;
+  PV112::ResizeImage(decoded.data.data(), decoded.width, decoded.height, decoded.format == GL_RGBA ? 4 : 3, width, height, image.data);
+  return true;
+}
+
+// Copies the levels out of the mapping of the cache
+void CopyCompressedTexture(const PV112::TextureCache &cache, PV112::CompressedTexture &out)
+{
+  out.Format = cache.Format();
+  out.Levels = cache.Levels();
+  out.Data.clear();
+  for (size_t level = 0; level < out.Levels.size(); level++)
+  {
+    const unsigned char *data = cache.Data() + out.Levels[level].Offset;
+    out.Levels[level].Offset = out.Data.size();
+    out.Data.insert(out.Data.end(), data, data + out.Levels[level].Size);
+  }
+}
+
+// The layers of a texture array, either all compressed to the same format, or all uncompressed with the
+// same format and their mip levels
+struct TextureArrayImage
+{
+  bool compressed;
+  std::vector<PV112::CompressedTexture> compressed_layers;
+  std::vector<TextureImage> layers;
+};
+
+// Loads the layers of a texture array. The compressed layers are cached like the textures of
+// LoadCompressedTexture, but resized, so they have their own cache files. A single layer with alpha makes
+// the whole array BC3.
+bool LoadTextureArray(const std::vector<std::basic_string<maybewchar> > &filenames, int width, int height, bool compress,
+    TextureArrayImage &out)
+{
+  const size_t count = filenames.size();
+  std::unique_ptr<PV112::MappedFile[]> sources(new PV112::MappedFile[count]);
+  std::vector<PV112::SourceStamp> source_stamps(count);
+  std::vector<std::string> cache_names(count);
+  for (size_t i = 0; i < count; i++)
+  {
+    const std::string source_name = NarrowFileName(filenames[i].c_str());
+    if (!sources[i].Open(source_name.c_str()))
+    {
+      cerr << "Couldn't load texture: " << filenames[i].c_str() << endl;
+      return false;
+    }
+    source_stamps[i] = PV112::GetSourceStamp(sources[i]);
+    cache_names[i] = PV112::GetTextureCacheFileName(source_name.c_str(), width, height);
+  }
+
+  out.compressed = compress;
+  out.layers.resize(count);
+  bool alpha = false;
+  if (!compress)
+  {
+    for (size_t i = 0; i < count; i++)
+    {
+      if (!LoadTextureLayer(filenames[i].c_str(), sources[i], width, height, out.layers[i]))
+        return false;
+      alpha = alpha || out.layers[i].format == GL_RGBA;
+    }
+
+    // All layers have the format of the array
+    for (size_t i = 0; i < count; i++)
+    {
+      TextureImage &layer = out.layers[i];
+      if (alpha && layer.format == GL_RGB)
+      {
+        std::vector<unsigned char> rgba(size_t(width) * height * 4, 255);
+        for (size_t pixel = 0; pixel < size_t(width) * height; pixel++)
+          std::copy(&layer.data[pixel * 3], &layer.data[pixel * 3] + 3, &rgba[pixel * 4]);
+        layer.data.swap(rgba);
+        layer.internal_format = GL_RGBA;
+        layer.format = GL_RGBA;
+      }
+      PV112::GenerateMipLevels(layer.data.data(), width, height, layer.format == GL_RGBA ? 4 : 3, layer.mip_levels);
+    }
+    return true;
+  }
+
+  out.compressed_layers.resize(count);
+  std::vector<bool> cached(count, false), decoded(count, false);
+  for (size_t i = 0; i < count; i++)
+  {
+    PV112::TextureCache cache;
+    if (cache.Open(cache_names[i].c_str(), source_stamps[i]) && cache.Width() == width && cache.Height() == height)
+    {
+      CopyCompressedTexture(cache, out.compressed_layers[i]);
+      cached[i] = true;
+      alpha = alpha || cache.Format() == PV112::BlockFormat::BC3;
+    }
+    else
+    {
+      if (!LoadTextureLayer(filenames[i].c_str(), sources[i], width, height, out.layers[i]))
+        return false;
+      decoded[i] = true;
+      const int channels = out.layers[i].format == GL_RGBA ? 4 : 3;
+      alpha = alpha || PV112::ChooseBlockFormat(out.layers[i].data.data(), width, height, channels) == PV112::BlockFormat::BC3;
+    }
+  }
+
+  // Cached layers of another format are compressed again
+  const PV112::BlockFormat format = alpha ? PV112::BlockFormat::BC3 : PV112::BlockFormat::BC1;
+  for (size_t i = 0; i < count; i++)
+  {
+    if (cached[i] && out.compressed_layers[i].Format == format)
+      continue;
+    if (!decoded[i] && !LoadTextureLayer(filenames[i].c_str(), sources[i], width, height, out.layers[i]))
+      return false;
+
+    TextureImage &layer = out.layers[i];
+    PV112::CompressTexture(layer.data.data(), width, height, layer.format == GL_RGBA ? 4 : 3, format, out.compressed_layers[i]);
+    if (!PV112::WriteTextureCache(cache_names[i].c_str(), source_stamps[i], out.compressed_layers[i]))
+      cout << "Cannot write texture cache " << cache_names[i] << endl;
+    layer = TextureImage();
+  }
+  return true;
+}
+
+// Sets all levels of the bound texture array, 'level_data' points to the layers of every level one after
+// another
+void SetTextureArrayImage(const TextureArrayImage &image, const std::vector<const unsigned char *> &level_data)
+{
+  const GLsizei layer_count = GLsizei(image.layers.size());
+  if (image.compressed)
+  {
+    const PV112::CompressedTexture &first = image.compressed_layers[0];
+    const GLenum internal_format = first.Format == PV112::BlockFormat::BC3 ? GL_COMPRESSED_RGBA_S3TC_DXT5_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+    for (size_t level = 0; level < level_data.size(); level++)
+    {
+      size_t level_size = 0;
+      for (const PV112::CompressedTexture &layer : image.compressed_layers)
+        level_size += layer.Levels[level].Size;
+      glCompressedTexImage3D(GL_TEXTURE_2D_ARRAY, GLint(level), internal_format, first.Levels[level].Width, first.Levels[level].Height,
+          layer_count, 0, GLsizei(level_size), level_data[level]);
+    }
+    return;
+  }
+
+  const TextureImage &first = image.layers[0];
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  int width = first.width, height = first.height;
+  for (size_t level = 0; level < level_data.size(); level++)
+  {
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, GLint(level), first.internal_format, width, height, layer_count, 0, first.format,
+        first.type, level_data[level]);
+    width = width > 1 ? width / 2 : 1;
+    height = height > 1 ? height / 2 : 1;
+  }
+}
+
+// Moves the pixels of a texture array to 'levels' in the order of SetTextureArrayImage, all layers of a level
+// and then the next level. Only the sizes of the layers stay in 'image'.
+void TakeTextureArrayLevels(TextureArrayImage &image, std::vector<std::vector<unsigned char> > &levels)
+{
+  levels.clear();
+  if (image.compressed)
+  {
+    levels.resize(image.compressed_layers[0].Levels.size());
+    for (size_t level = 0; level < levels.size(); level++)
+    {
+      for (const PV112::CompressedTexture &layer : image.compressed_layers)
+      {
+        const unsigned char *data = layer.Data.data() + layer.Levels[level].Offset;
+        levels[level].insert(levels[level].end(), data, data + layer.Levels[level].Size);
+      }
+    }
+    for (PV112::CompressedTexture &layer : image.compressed_layers)
+      std::vector<unsigned char>().swap(layer.Data);
+    return;
+  }
+
+  levels.resize(image.layers[0].mip_levels.size() + 1);
+  for (size_t level = 0; level < levels.size(); level++)
+  {
+    for (const TextureImage &layer : image.layers)
+    {
+      const std::vector<unsigned char> &data = level == 0 ? layer.data : layer.mip_levels[level - 1];
+      levels[level].insert(levels[level].end(), data.begin(), data.end());
+    }
+  }
+  for (TextureImage &layer : image.layers)
+  {
+    std::vector<unsigned char>().swap(layer.data);
+    layer.mip_levels.clear();
+  }
+}
+
+// Sets the levels of the bound texture object to the image and its mip levels in 'levels'
+void SetTextureLevels(const TextureImage &image, const std::vector<const unsigned char *> &levels, GLenum target)
+{
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  int width = image.width, height = image.height;
+  for (size_t level = 0; level < levels.size(); level++)
+  {
+    glTexImage2D(target, GLint(level), image.internal_format, width, height, 0, image.format, image.type, levels[level]);
+    width = width > 1 ? width / 2 : 1;
+    height = height > 1 ? height / 2 : 1;
+  }
+}
+
+// A part of a texture that is uploaded by a single call, usually a level
+struct PixelRange
+{
+  const unsigned char *data;
+  size_t size;
+};
+
+// Copies the ranges one after another to a staging buffer of the streamer, and stores where each of them
+// starts in the buffer. Returns null if there is no streamer or the ranges do not fit in its buffers, they
+// have to be uploaded from memory then.
+PV112::TextureStreamer::StagingBuffer *StageTexture(PV112::TextureStreamer *streamer, const std::vector<PixelRange> &ranges,
+    std::vector<size_t> &offsets)
+{
+  if (streamer == nullptr)
+    return nullptr;
+
+  size_t size = 0;
+  offsets.clear();
+  for (const PixelRange &range : ranges)
+  {
+    offsets.push_back(size);
+    size += range.size;
+  }
+
+  PV112::TextureStreamer::StagingBuffer *staging = streamer->Acquire(size);
+  if (staging == nullptr)
+    return nullptr;
+  for (size_t i = 0; i < ranges.size(); i++)
+    memcpy(staging->Data + offsets[i], ranges[i].data, ranges[i].size);
+  return staging;
+}
+
+}
+
+bool DecodeTexture(const maybewchar *filename, TextureImage &image)
+{
+  std::vector<unsigned char> file_data;
+  if (!ReadFileData(filename, file_data))
+    return DecodeTextureDevIL(filename, image);
+  return DecodeTextureData(filename, file_data.data(), file_data.size(), image);
+}
+
+void SetTextureImage(const TextureImage &image, GLenum target)
+{
+  // Set the data to OpenGL (assumes texture object is already bound)
+  std::vector<const unsigned char *> levels(1, image.data.data());
+  for (size_t level = 0; level < image.mip_levels.size(); level++)
+    levels.push_back(image.mip_levels[level].data());
+  SetTextureLevels(image, levels, target);
+}
+
+void SetCompressedTextureImage(PV112::BlockFormat format, const std::vector<PV112::CompressedLevel> &levels,
+    const unsigned char *data, GLenum target)
+{
+  const GLenum internal_format = format == PV112::BlockFormat::BC3 ? GL_COMPRESSED_RGBA_S3TC_DXT5_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+  for (size_t level = 0; level < levels.size(); level++)
+  {
+    glCompressedTexImage2D(target, GLint(level), internal_format, levels[level].Width, levels[level].Height, 0,
+        GLsizei(levels[level].Size), data + levels[level].Offset);
+  }
+}
+
+bool LoadAndSetTexture(const maybewchar *filename, GLenum target)
+{
+  TextureImage image;
+  if (!DecodeTexture(filename, image))
+    return false;
+  SetTextureImage(image, target);
+  return true;
+}
+
 GLuint CreateAndLoadTexture(const maybewchar *filename)
 {
   // Create OpenGL texture object
@@ -83,6 +464,162 @@ GLuint CreateAndLoadTexture(const maybewchar *filename)
   return tex_obj;
 }
 
+GLuint CreateAndLoadTextureAsync(PV112::AssetLoader &loader, const maybewchar *filename, PV112::TextureStreamer *streamer)
+{
+  GLuint tex_obj;
+  glGenTextures(1, &tex_obj);
+  glBindTexture(GL_TEXTURE_2D, tex_obj);
+  const unsigned char white[4] = { 255, 255, 255, 255 };
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, white);
+  glBindTexture(GL_TEXTURE_2D, 0);
+
+  const std::basic_string<maybewchar> name = filename;
+  loader.Load([=]() -> PV112::AssetLoader::UploadStep {
+    // The workers load textures side by side, compressing and filtering one does not start more threads
+    const PV112::SerialScope serial;
+    std::shared_ptr<TextureImage> image = std::make_shared<TextureImage>();
+
+    // The cache stays mapped until the upload, a freshly compressed texture is kept in memory
+    if (GLEW_EXT_texture_compression_s3tc)
+    {
+      std::shared_ptr<PV112::TextureCache> cache = std::make_shared<PV112::TextureCache>();
+      std::shared_ptr<PV112::CompressedTexture> compressed = std::make_shared<PV112::CompressedTexture>();
+      if (LoadCompressedTexture(name.c_str(), *cache, *compressed, *image))
+      {
+        const bool cached = !cache->Levels().empty();
+        const PV112::BlockFormat format = cached ? cache->Format() : compressed->Format;
+        std::vector<PV112::CompressedLevel> levels = cached ? cache->Levels() : compressed->Levels;
+        const unsigned char *data = cached ? cache->Data() : compressed->Data.data();
+
+        // The levels in a staging buffer do not need the cache anymore
+        std::vector<PixelRange> ranges;
+        for (const PV112::CompressedLevel &level : levels)
+          ranges.push_back(PixelRange{ data + level.Offset, level.Size });
+        std::vector<size_t> offsets;
+        PV112::TextureStreamer::StagingBuffer *staging = StageTexture(streamer, ranges, offsets);
+        if (staging != nullptr)
+        {
+          for (size_t level = 0; level < levels.size(); level++)
+            levels[level].Offset = offsets[level];
+          return [=]() {
+            streamer->Submit(staging, [&](const unsigned char *staged) {
+              glBindTexture(GL_TEXTURE_2D, tex_obj);
+              SetCompressedTextureImage(format, levels, staged, GL_TEXTURE_2D);
+              glBindTexture(GL_TEXTURE_2D, 0);
+            });
+          };
+        }
+
+        return [=]() {
+          glBindTexture(GL_TEXTURE_2D, tex_obj);
+          if (cache->Levels().empty())
+            SetCompressedTextureImage(compressed->Format, compressed->Levels, compressed->Data.data(), GL_TEXTURE_2D);
+          else
+            SetCompressedTextureImage(cache->Format(), cache->Levels(), cache->Data(), GL_TEXTURE_2D);
+          glBindTexture(GL_TEXTURE_2D, 0);
+        };
+      }
+      if (image->data.empty())
+        return PV112::AssetLoader::UploadStep();
+    }
+    else if (!DecodeTexture(name.c_str(), *image))
+      return PV112::AssetLoader::UploadStep();
+
+    // DevIL may return other formats, the driver makes their mipmaps
+    if (image->type == GL_UNSIGNED_BYTE && (image->format == GL_RGB || image->format == GL_RGBA))
+    {
+      PV112::GenerateMipLevels(image->data.data(), image->width, image->height, image->format == GL_RGBA ? 4 : 3,
+          image->mip_levels);
+    }
+
+    std::vector<PixelRange> ranges(1, PixelRange{ image->data.data(), image->data.size() });
+    for (const std::vector<unsigned char> &level : image->mip_levels)
+      ranges.push_back(PixelRange{ level.data(), level.size() });
+    std::vector<size_t> offsets;
+    PV112::TextureStreamer::StagingBuffer *staging = StageTexture(streamer, ranges, offsets);
+    if (staging != nullptr)
+    {
+      std::vector<unsigned char>().swap(image->data);
+      image->mip_levels.clear();
+      return [=]() {
+        streamer->Submit(staging, [&](const unsigned char *staged) {
+          std::vector<const unsigned char *> levels;
+          for (size_t offset : offsets)
+            levels.push_back(staged + offset);
+          glBindTexture(GL_TEXTURE_2D, tex_obj);
+          SetTextureLevels(*image, levels, GL_TEXTURE_2D);
+          if (levels.size() == 1)
+            glGenerateMipmap(GL_TEXTURE_2D);
+          glBindTexture(GL_TEXTURE_2D, 0);
+        });
+      };
+    }
+
+    return [=]() {
+      glBindTexture(GL_TEXTURE_2D, tex_obj);
+      SetTextureImage(*image, GL_TEXTURE_2D);
+      if (image->mip_levels.empty())
+        glGenerateMipmap(GL_TEXTURE_2D);
+      glBindTexture(GL_TEXTURE_2D, 0);
+    };
+  });
+  return tex_obj;
+}
+
+GLuint CreateAndLoadTextureArrayAsync(PV112::AssetLoader &loader, const std::vector<const maybewchar *> &filenames,
+    int width, int height, PV112::TextureStreamer *streamer)
+{
+  GLuint tex_obj;
+  glGenTextures(1, &tex_obj);
+  glBindTexture(GL_TEXTURE_2D_ARRAY, tex_obj);
+  const std::vector<unsigned char> white(filenames.size() * 4, 255);
+  glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA, 1, 1, GLsizei(filenames.size()), 0, GL_RGBA, GL_UNSIGNED_BYTE, white.data());
+  glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+  const std::vector<std::basic_string<maybewchar> > names(filenames.begin(), filenames.end());
+  loader.Load([=]() -> PV112::AssetLoader::UploadStep {
+    // Like the textures of CreateAndLoadTextureAsync, the layers are resized and compressed on this thread
+    const PV112::SerialScope serial;
+    std::shared_ptr<TextureArrayImage> image = std::make_shared<TextureArrayImage>();
+    if (names.empty() || !LoadTextureArray(names, width, height, GLEW_EXT_texture_compression_s3tc != 0, *image))
+      return PV112::AssetLoader::UploadStep();
+
+    // The layers of a level are put together here, so the upload step only passes them on
+    std::shared_ptr<std::vector<std::vector<unsigned char> > > levels = std::make_shared<std::vector<std::vector<unsigned char> > >();
+    TakeTextureArrayLevels(*image, *levels);
+
+    std::vector<PixelRange> ranges;
+    for (const std::vector<unsigned char> &level : *levels)
+      ranges.push_back(PixelRange{ level.data(), level.size() });
+    std::vector<size_t> offsets;
+    PV112::TextureStreamer::StagingBuffer *staging = StageTexture(streamer, ranges, offsets);
+    if (staging != nullptr)
+    {
+      levels->clear();
+      return [=]() {
+        streamer->Submit(staging, [&](const unsigned char *staged) {
+          std::vector<const unsigned char *> level_data;
+          for (size_t offset : offsets)
+            level_data.push_back(staged + offset);
+          glBindTexture(GL_TEXTURE_2D_ARRAY, tex_obj);
+          SetTextureArrayImage(*image, level_data);
+          glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+        });
+      };
+    }
+
+    return [=]() {
+      std::vector<const unsigned char *> level_data;
+      for (const std::vector<unsigned char> &level : *levels)
+        level_data.push_back(level.data());
+      glBindTexture(GL_TEXTURE_2D_ARRAY, tex_obj);
+      SetTextureArrayImage(*image, level_data);
+      glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    };
+  });
+  return tex_obj;
+}
+
 glm::mat3 getNormalMatrix(const glm::mat4& matrix) {
   return glm::inverse(glm::transpose(glm::mat3(matrix)));
 }
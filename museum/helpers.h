@@ -24,8 +24,62 @@ typedef char maybewchar;
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
+#include <vector>
+
+#include "assetloader.h"
+#include "texturecompress.h"
+#include "texturestreamer.h"
+
+// Pixels of a decoded image and the parameters of glTexImage2D for them
+struct TextureImage
+{
+  int width;
+  int height;
+  GLint internal_format;
+  GLenum format;
+  GLenum type;
+  std::vector<unsigned char> data;
+  // Levels 1 and below of the mip chain, made on the CPU; empty if glGenerateMipmap should make them
+  std::vector<std::vector<unsigned char> > mip_levels;
+};
+
+// Decodes an image file. Unlike the other texture functions, it can be called from any thread. PNG, JPEG,
+// and TGA files are decoded by imagedecode.h in parallel, other formats by DevIL, which is not thread-safe,
+// so the threads decode those one image at a time.
+bool DecodeTexture(const maybewchar *filename, TextureImage &image);
+// Sets the image of the bound texture object, and its smaller levels if the image has them
+void SetTextureImage(const TextureImage &image, GLenum target);
+// Sets all levels of the bound texture object to block compressed images, 'data' + the offset of a level
+// points to its blocks
+void SetCompressedTextureImage(PV112::BlockFormat format, const std::vector<PV112::CompressedLevel> &levels,
+    const unsigned char *data, GLenum target);
+
 bool LoadAndSetTexture(const maybewchar *filename, GLenum target);
 GLuint CreateAndLoadTexture(const maybewchar *filename);
+
+// Creates a texture object with a single white texel right away and loads the file in the background.
+// Its parameters can be set immediately, they stay when the image arrives with all its mipmaps. The texture
+// stays white if the file cannot be loaded.
+//
+// The mipmaps of RGB and RGBA images are filtered on the loader threads by PV112::DownsampleImage, not by
+// the driver; each image by the one thread that loads it, like the compression (see PV112::SerialScope).
+// If the driver supports S3TC, the images are compressed to BC1 or BC3 (with alpha) with their whole mip
+// chain, and stored in a .ktx cache next to the image. Later runs upload the cached levels without
+// decoding the image again.
+//
+// With a 'streamer', the loader thread copies the levels to one of its staging buffers, and the upload step
+// only starts the copy from the buffer to the texture; the texture is complete once the streamer's fence is
+// signaled. Textures larger than the staging buffers are uploaded from memory.
+GLuint CreateAndLoadTextureAsync(PV112::AssetLoader &loader, const maybewchar *filename,
+    PV112::TextureStreamer *streamer = nullptr);
+// Creates a texture array with a white texel in every layer right away, and loads the files into its layers
+// in the background like CreateAndLoadTextureAsync. Every image is resized to 'width' x 'height', the
+// geometry it is drawn on restores its proportions, so images of different sizes share one texture object
+// and can be drawn with a single instanced draw. The layers are compressed and cached like the textures of
+// CreateAndLoadTextureAsync, in files with the size in the name, and streamed through the 'streamer' the
+// same way. The array stays white if any file cannot be loaded.
+GLuint CreateAndLoadTextureArrayAsync(PV112::AssetLoader &loader, const std::vector<const maybewchar *> &filenames,
+    int width, int height, PV112::TextureStreamer *streamer = nullptr);
 glm::mat3 getNormalMatrix(const glm::mat4& matrix);
 
 #endif
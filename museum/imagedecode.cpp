@@ -0,0 +1,248 @@
+#include "imagedecode.h"
+
+#include <algorithm>
+#include <csetjmp>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#include <png.h>
+#include <jpeglib.h>
+
+#if defined(_WIN32)
+#pragma comment(lib, "libpng16.lib")
+#pragma comment(lib, "jpeg.lib")
+#endif
+
+using namespace std;
+
+namespace PV112
+{
+
+DecodedImage::DecodedImage()
+    : Width(0), Height(0), Channels(0)
+{
+}
+
+namespace
+{
+
+//-------------------
+//----    PNG    ----
+//-------------------
+
+bool IsPNG(const unsigned char *data, size_t size)
+{
+    static const unsigned char signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    return size >= sizeof(signature) && memcmp(data, signature, sizeof(signature)) == 0;
+}
+
+bool DecodePNG(const unsigned char *data, size_t size, DecodedImage &out)
+{
+    // The simplified API of libpng keeps all its state in 'image'
+    png_image image;
+    memset(&image, 0, sizeof(image));
+    image.version = PNG_IMAGE_VERSION;
+    if (!png_image_begin_read_from_memory(&image, data, size))
+    {
+        cout << "Cannot decode PNG image: " << image.message << endl;
+        return false;
+    }
+
+    // Gray images and palettes are expanded, 16-bit channels are reduced to 8 bits
+    const bool alpha = (image.format & PNG_FORMAT_FLAG_ALPHA) != 0;
+    image.format = alpha ? PNG_FORMAT_RGBA : PNG_FORMAT_RGB;
+
+    out.Width = int(image.width);
+    out.Height = int(image.height);
+    out.Channels = alpha ? 4 : 3;
+    out.Pixels.resize(PNG_IMAGE_SIZE(image));
+
+    // A negative stride stores the rows from the bottom one
+    const png_int_32 stride = png_int_32(PNG_IMAGE_ROW_STRIDE(image));
+    if (!png_image_finish_read(&image, nullptr, out.Pixels.data(), -stride, nullptr))
+    {
+        cout << "Cannot decode PNG image: " << image.message << endl;
+        png_image_free(&image);
+        return false;
+    }
+    return true;
+}
+
+//--------------------
+//----    JPEG    ----
+//--------------------
+
+bool IsJPEG(const unsigned char *data, size_t size)
+{
+    return size >= 3 && data[0] == 0xFF && data[1] == 0xD8 && data[2] == 0xFF;
+}
+
+// libjpeg calls exit() on errors by default, the decoder jumps back instead
+struct JPEGErrorManager
+{
+    jpeg_error_mgr Manager;
+    jmp_buf Jump;
+};
+
+void JPEGErrorExit(j_common_ptr info)
+{
+    JPEGErrorManager *errors = reinterpret_cast<JPEGErrorManager *>(info->err);
+    char message[JMSG_LENGTH_MAX];
+    (*info->err->format_message)(info, message);
+    cout << "Cannot decode JPEG image: " << message << endl;
+    longjmp(errors->Jump, 1);
+}
+
+// Warnings about corrupt data are not worth a message per image, libjpeg still decodes the rest
+void JPEGOutputMessage(j_common_ptr)
+{
+}
+
+// No object with a destructor may live in this function, longjmp would skip it
+bool DecodeJPEG(const unsigned char *data, size_t size, DecodedImage &out)
+{
+    jpeg_decompress_struct info;
+    JPEGErrorManager errors;
+    info.err = jpeg_std_error(&errors.Manager);
+    errors.Manager.error_exit = JPEGErrorExit;
+    errors.Manager.output_message = JPEGOutputMessage;
+    if (setjmp(errors.Jump))
+    {
+        jpeg_destroy_decompress(&info);
+        return false;
+    }
+
+    jpeg_create_decompress(&info);
+    jpeg_mem_src(&info, const_cast<unsigned char *>(data), static_cast<unsigned long>(size));
+    jpeg_read_header(&info, TRUE);
+
+    // libjpeg converts gray and YCbCr to RGB, but not CMYK
+    if (info.jpeg_color_space == JCS_CMYK || info.jpeg_color_space == JCS_YCCK)
+    {
+        jpeg_destroy_decompress(&info);
+        return false;
+    }
+    info.out_color_space = JCS_RGB;
+    jpeg_start_decompress(&info);
+
+    out.Width = int(info.output_width);
+    out.Height = int(info.output_height);
+    out.Channels = 3;
+    out.Pixels.resize(size_t(info.output_width) * info.output_height * 3);
+
+    // The file has the top row first
+    const size_t stride = size_t(info.output_width) * 3;
+    while (info.output_scanline < info.output_height)
+    {
+        JSAMPROW row = &out.Pixels[(info.output_height - 1 - info.output_scanline) * stride];
+        jpeg_read_scanlines(&info, &row, 1);
+    }
+
+    jpeg_finish_decompress(&info);
+    jpeg_destroy_decompress(&info);
+    return true;
+}
+
+//-------------------
+//----    TGA    ----
+//-------------------
+
+const size_t tga_header_size = 18;
+
+unsigned ReadLittleEndian16(const unsigned char *data)
+{
+    return unsigned(data[0]) | (unsigned(data[1]) << 8);
+}
+
+// TGA has no signature, the header must describe an image the decoder supports: true-color, uncompressed
+// or run-length encoded, with 24 or 32 bits per pixel and no color map
+bool IsSupportedTGA(const unsigned char *data, size_t size)
+{
+    return size >= tga_header_size && data[1] == 0 && (data[2] == 2 || data[2] == 10) && (data[16] == 24 || data[16] == 32) &&
+            ReadLittleEndian16(data + 12) > 0 && ReadLittleEndian16(data + 14) > 0;
+}
+
+bool DecodeTGA(const unsigned char *data, size_t size, DecodedImage &out)
+{
+    const unsigned width = ReadLittleEndian16(data + 12);
+    const unsigned height = ReadLittleEndian16(data + 14);
+    const unsigned channels = data[16] / 8;
+    const bool run_length = data[2] == 10;
+    // Bit 5 of the descriptor is set if the first row is the top one, bit 4 if the first column is the right one
+    const bool top_first = (data[17] & 0x20) != 0;
+    const bool right_first = (data[17] & 0x10) != 0;
+
+    const unsigned char *source = data + tga_header_size + data[0];
+    const unsigned char *const end = data + size;
+    if (source > end)
+    {
+        cout << "Cannot decode TGA image: the header is truncated" << endl;
+        return false;
+    }
+
+    out.Width = int(width);
+    out.Height = int(height);
+    out.Channels = int(channels);
+    out.Pixels.resize(size_t(width) * height * channels);
+
+    // The pixels are in the BGR(A) order, in packets of 'count' pixels, either 'count' literal pixels or one
+    // pixel repeated (the run-length encoded ones)
+    const size_t pixel_count = size_t(width) * height;
+    size_t pixel = 0;
+    while (pixel < pixel_count)
+    {
+        size_t count = pixel_count - pixel;
+        bool repeated = false;
+        if (run_length)
+        {
+            if (source >= end)
+                break;
+            count = std::min(count, size_t(*source & 0x7F) + 1);
+            repeated = (*source & 0x80) != 0;
+            source++;
+        }
+        if (size_t(end - source) < (repeated ? 1 : count) * channels)
+            break;
+
+        for (size_t i = 0; i < count; i++, pixel++)
+        {
+            const size_t row = pixel / width, column = pixel % width;
+            const size_t y = top_first ? height - 1 - row : row;
+            const size_t x = right_first ? width - 1 - column : column;
+            unsigned char *target = &out.Pixels[(y * width + x) * channels];
+            target[0] = source[2];
+            target[1] = source[1];
+            target[2] = source[0];
+            if (channels == 4)
+                target[3] = source[3];
+            if (!repeated)
+                source += channels;
+        }
+        if (repeated)
+            source += channels;
+    }
+
+    if (pixel < pixel_count)
+    {
+        cout << "Cannot decode TGA image: the data are truncated" << endl;
+        return false;
+    }
+    return true;
+}
+
+}
+
+bool DecodeImage(const unsigned char *data, size_t size, DecodedImage &out)
+{
+    if (IsPNG(data, size))
+        return DecodePNG(data, size, out);
+    if (IsJPEG(data, size))
+        return DecodeJPEG(data, size, out);
+    if (IsSupportedTGA(data, size))
+        return DecodeTGA(data, size, out);
+    return false;
+}
+
+}
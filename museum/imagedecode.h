@@ -0,0 +1,34 @@
+#pragma once
+#ifndef INCLUDED_IMAGEDECODE_H
+#define INCLUDED_IMAGEDECODE_H
+
+#include <cstddef>
+#include <vector>
+
+namespace PV112
+{
+
+/// Pixels of a decoded image, 8 bits per channel in the RGB or RGBA order. The rows go from the bottom one
+/// up, the origin of OpenGL textures, and have no padding.
+struct DecodedImage
+{
+    int Width;
+    int Height;
+    // 3 (RGB) or 4 (RGBA)
+    int Channels;
+    std::vector<unsigned char> Pixels;
+
+    DecodedImage();
+};
+
+/// Decodes a PNG, JPEG, or TGA file in memory. The format is recognized by the data, not by the name of
+/// the file.
+///
+/// Unlike DevIL, the decoders keep no global state, any number of threads may decode images at once.
+/// Returns false if the data are not in one of the formats or use a variant the decoders do not support
+/// (for example a CMYK JPEG or a TGA with a color map), the caller may try another decoder then.
+bool DecodeImage(const unsigned char *data, size_t size, DecodedImage &out);
+
+}
+
+#endif	// INCLUDED_IMAGEDECODE_H
@@ -131,6 +131,78 @@ void LocationStorage::setProceduralTexType(const GLint& location) {
   tex_procedural_type = location;
 }
 
+GLint LocationStorage::getPositionScaleLocation() const {
+  return position_scale_loc;
+}
+
+void LocationStorage::setPositionScaleLocation(const GLint& location) {
+  position_scale_loc = location;
+}
+
+GLint LocationStorage::getPositionOffsetLocation() const {
+  return position_offset_loc;
+}
+
+void LocationStorage::setPositionOffsetLocation(const GLint& location) {
+  position_offset_loc = location;
+}
+
+GLint LocationStorage::getOctahedralNormalLocation() const {
+  return octahedral_normal_loc;
+}
+
+void LocationStorage::setOctahedralNormalLocation(const GLint& location) {
+  octahedral_normal_loc = location;
+}
+
+GLint LocationStorage::getInstancedLocation() const {
+  return instanced_loc;
+}
+
+void LocationStorage::setInstancedLocation(const GLint& location) {
+  instanced_loc = location;
+}
+
+GLint LocationStorage::getPVMatrixLocation() const {
+  return PV_matrix_loc;
+}
+
+void LocationStorage::setPVMatrixLocation(const GLint& location) {
+  PV_matrix_loc = location;
+}
+
+GLint LocationStorage::getInstanceModelMatricesLocation() const {
+  return instance_model_matrices_loc;
+}
+
+void LocationStorage::setInstanceModelMatricesLocation(const GLint& location) {
+  instance_model_matrices_loc = location;
+}
+
+GLint LocationStorage::getInstanceLayersLocation() const {
+  return instance_layers_loc;
+}
+
+void LocationStorage::setInstanceLayersLocation(const GLint& location) {
+  instance_layers_loc = location;
+}
+
+GLint LocationStorage::getMyTexArrayLocation() const {
+  return tex_array_loc;
+}
+
+void LocationStorage::setMyTexArrayLocation(const GLint& location) {
+  tex_array_loc = location;
+}
+
+GLint LocationStorage::getUseTexArrayLocation() const {
+  return use_tex_array_loc;
+}
+
+void LocationStorage::setUseTexArrayLocation(const GLint& location) {
+  use_tex_array_loc = location;
+}
+
 // spotlight
 GLint LocationStorage::getSpotlightPositionLocation() const {
   return spotLight_position;
@@ -28,6 +28,17 @@ private:
 
   GLint tex_procedural_type;
 
+  GLint position_scale_loc;
+  GLint position_offset_loc;
+  GLint octahedral_normal_loc;
+
+  GLint instanced_loc;
+  GLint PV_matrix_loc;
+  GLint instance_model_matrices_loc;
+  GLint instance_layers_loc;
+  GLint tex_array_loc;
+  GLint use_tex_array_loc;
+
   GLint spotLight_position;
   GLint spotLight_direction;
   GLint spotLight_ambient;
@@ -107,6 +118,42 @@ public:
 
   void setProceduralTexType(const GLint& location);
 
+  GLint getPositionScaleLocation() const;
+
+  void setPositionScaleLocation(const GLint& location);
+
+  GLint getPositionOffsetLocation() const;
+
+  void setPositionOffsetLocation(const GLint& location);
+
+  GLint getOctahedralNormalLocation() const;
+
+  void setOctahedralNormalLocation(const GLint& location);
+
+  GLint getInstancedLocation() const;
+
+  void setInstancedLocation(const GLint& location);
+
+  GLint getPVMatrixLocation() const;
+
+  void setPVMatrixLocation(const GLint& location);
+
+  GLint getInstanceModelMatricesLocation() const;
+
+  void setInstanceModelMatricesLocation(const GLint& location);
+
+  GLint getInstanceLayersLocation() const;
+
+  void setInstanceLayersLocation(const GLint& location);
+
+  GLint getMyTexArrayLocation() const;
+
+  void setMyTexArrayLocation(const GLint& location);
+
+  GLint getUseTexArrayLocation() const;
+
+  void setUseTexArrayLocation(const GLint& location);
+
 // spotLight
   GLint getSpotlightPositionLocation() const;
 
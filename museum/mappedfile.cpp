@@ -0,0 +1,130 @@
+#include "mappedfile.h"
+
+#if defined(_WIN32)
+#define NOMINMAX      // Make Windows.h not define 'min' and 'max' macros
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace PV112
+{
+
+MappedFile::MappedFile()
+    : data(nullptr), size(0), modification_time(0)
+#if defined(_WIN32)
+    , file_handle(INVALID_HANDLE_VALUE), mapping_handle(nullptr)
+#endif
+{
+}
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+bool MappedFile::Open(const char *file_name)
+{
+    Close();
+
+#if defined(_WIN32)
+    file_handle = CreateFileA(file_name, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file_handle == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER file_size;
+    FILETIME write_time;
+    if (!GetFileSizeEx(file_handle, &file_size) || !GetFileTime(file_handle, nullptr, nullptr, &write_time))
+    {
+        Close();
+        return false;
+    }
+    modification_time = (static_cast<long long>(write_time.dwHighDateTime) << 32) | write_time.dwLowDateTime;
+    if (file_size.QuadPart == 0)
+        return true;        // Nothing to map, CreateFileMapping fails for empty files
+
+    mapping_handle = CreateFileMappingA(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping_handle == nullptr)
+    {
+        Close();
+        return false;
+    }
+    data = static_cast<const char *>(MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0));
+    if (data == nullptr)
+    {
+        Close();
+        return false;
+    }
+    size = size_t(file_size.QuadPart);
+#else
+    int fd = open(file_name, O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        close(fd);
+        return false;
+    }
+    modification_time = static_cast<long long>(st.st_mtime);
+    if (st.st_size == 0)
+    {
+        close(fd);
+        return true;        // Nothing to map, mmap fails for empty files
+    }
+
+    void *mapping = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);        // The mapping keeps its own reference to the file
+    if (mapping == MAP_FAILED)
+        return false;
+
+    // The files are always read from the beginning to the end
+    madvise(mapping, size_t(st.st_size), MADV_SEQUENTIAL);
+
+    data = static_cast<const char *>(mapping);
+    size = size_t(st.st_size);
+#endif
+    return true;
+}
+
+void MappedFile::Close()
+{
+#if defined(_WIN32)
+    if (data != nullptr)
+        UnmapViewOfFile(data);
+    if (mapping_handle != nullptr)
+        CloseHandle(mapping_handle);
+    if (file_handle != INVALID_HANDLE_VALUE)
+        CloseHandle(file_handle);
+    mapping_handle = nullptr;
+    file_handle = INVALID_HANDLE_VALUE;
+#else
+    if (data != nullptr)
+        munmap(const_cast<char *>(data), size);
+#endif
+    data = nullptr;
+    size = 0;
+    modification_time = 0;
+}
+
+const char *MappedFile::Data() const
+{
+    return data;
+}
+
+size_t MappedFile::Size() const
+{
+    return size;
+}
+
+long long MappedFile::ModificationTime() const
+{
+    return modification_time;
+}
+
+}
@@ -0,0 +1,49 @@
+#pragma once
+#ifndef INCLUDED_MAPPEDFILE_H
+#define INCLUDED_MAPPEDFILE_H
+
+#include <cstddef>
+
+namespace PV112
+{
+
+/// Read-only view of a whole file mapped into the address space of the process.
+///
+/// The bytes are NOT terminated by '\0', always use Size() to find the end of the data. An empty
+/// file is mapped successfully, Data() is nullptr and Size() is 0 in that case.
+class MappedFile
+{
+public:
+    MappedFile();
+    ~MappedFile();
+
+    /// Maps the file, returns false if it cannot be opened or mapped.
+    bool Open(const char *file_name);
+
+    /// Unmaps the file, it is safe to call it on a file that is not open.
+    void Close();
+
+    const char *Data() const;
+    size_t Size() const;
+
+    /// Time of the last modification of the file when it was opened. The units differ between
+    /// platforms, use it only to find out whether the file has changed.
+    long long ModificationTime() const;
+
+private:
+    // The mapping owns operating system resources, it must not be copied
+    MappedFile(const MappedFile &);
+    MappedFile &operator =(const MappedFile &);
+
+    const char *data;
+    size_t size;
+    long long modification_time;
+#if defined(_WIN32)
+    void *file_handle;
+    void *mapping_handle;
+#endif
+};
+
+}
+
+#endif	// INCLUDED_MAPPEDFILE_H
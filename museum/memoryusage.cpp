@@ -0,0 +1,33 @@
+#include "memoryusage.h"
+
+#if defined(_WIN32)
+#define NOMINMAX      // Make Windows.h not define 'min' and 'max' macros
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace PV112
+{
+
+size_t GetPeakMemoryUsage()
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return 0;
+    return size_t(counters.PeakWorkingSetSize);
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#if defined(__APPLE__)
+    return size_t(usage.ru_maxrss);             // Bytes on macOS
+#else
+    return size_t(usage.ru_maxrss) * 1024;      // Kilobytes on Linux
+#endif
+#endif
+}
+
+}
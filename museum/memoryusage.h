@@ -0,0 +1,16 @@
+#pragma once
+#ifndef INCLUDED_MEMORYUSAGE_H
+#define INCLUDED_MEMORYUSAGE_H
+
+#include <cstddef>
+
+namespace PV112
+{
+
+/// Returns the largest amount of physical memory the process has used so far (the peak resident set
+/// size, or the peak working set on Windows) in bytes, 0 if the system does not tell.
+size_t GetPeakMemoryUsage();
+
+}
+
+#endif	// INCLUDED_MEMORYUSAGE_H
@@ -0,0 +1,161 @@
+#include "meshbuild.h"
+
+#include <cstring>
+#include <algorithm>
+
+#include "meshtools.h"
+
+namespace PV112
+{
+
+namespace
+{
+
+// Simplified levels stop at this error, relative to the diagonal of the bounding box
+const float lod_max_relative_error = 0.05f;
+
+// A level must have at most this part of the triangles of the previous one, otherwise it is not worth it
+const float lod_min_reduction = 0.75f;
+
+}
+
+bool BuildOBJMesh(const OBJData &obj, MeshData &out)
+{
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec3> normals;
+    std::vector<glm::vec2> tex_coords;
+    std::vector<unsigned int> indices;
+    if (!IndexOBJTriangles(obj, positions, normals, tex_coords, indices))
+        return false;
+
+    // Every triangle of the OBJ file is a triangle of 'indices', so the submeshes are ranges of them. The
+    // triangles are reordered only within their submesh, each submesh is drawn by itself.
+    std::vector<OBJSubmesh> obj_submeshes;
+    GetOBJSubmeshes(obj, obj_submeshes, out.Materials);
+    if (obj_submeshes.empty())
+    {
+        OBJSubmesh empty = { std::string(), 0, 0, 0 };
+        obj_submeshes.push_back(empty);
+    }
+    out.Submeshes.resize(obj_submeshes.size());
+    out.SubmeshNames.resize(obj_submeshes.size());
+    for (size_t i = 0; i < obj_submeshes.size(); i++)
+    {
+        MeshSubmesh &submesh = out.Submeshes[i];
+        memset(&submesh, 0, sizeof(submesh));
+        submesh.Material = obj_submeshes[i].Material;
+        submesh.FirstIndex[0] = uint32_t(obj_submeshes[i].FirstTriangle * 3);
+        submesh.IndexCount[0] = uint32_t(obj_submeshes[i].TriangleCount * 3);
+        out.SubmeshNames[i] = obj_submeshes[i].Name;
+    }
+
+    // Order the triangles so that the vertex shader runs as few times as possible
+    for (const MeshSubmesh &submesh : out.Submeshes)
+        OptimizeVertexCache(indices.data() + submesh.FirstIndex[0], submesh.IndexCount[0], positions.size());
+
+    std::vector<float> &vertices = out.Vertices;
+    vertices.resize(positions.size() * mesh_cache_vertex_floats);
+    for (size_t i = 0; i < positions.size(); i++)
+    {
+        float *vertex = &vertices[i * mesh_cache_vertex_floats];
+        vertex[0] = positions[i].x;     vertex[1] = positions[i].y;     vertex[2] = positions[i].z;
+        vertex[3] = normals[i].x;       vertex[4] = normals[i].y;       vertex[5] = normals[i].z;
+        vertex[6] = tex_coords[i].x;    vertex[7] = tex_coords[i].y;
+    }
+
+    // Draw the triangles that hide others first (keeping most of the vertex cache efficiency), group
+    // them into meshlets the renderer can cull, then put the vertices in the order the triangles read them
+    out.Meshlets.clear();
+    std::vector<Meshlet> submesh_meshlets;
+    for (const MeshSubmesh &submesh : out.Submeshes)
+    {
+        unsigned int *submesh_indices = indices.data() + submesh.FirstIndex[0];
+        OptimizeOverdraw(submesh_indices, submesh.IndexCount[0], vertices.data(), positions.size(), mesh_cache_vertex_floats);
+        BuildMeshlets(submesh_indices, submesh.IndexCount[0], vertices.data(), positions.size(), mesh_cache_vertex_floats, submesh_meshlets);
+        for (Meshlet &meshlet : submesh_meshlets)
+        {
+            meshlet.FirstIndex += submesh.FirstIndex[0];
+            out.Meshlets.push_back(meshlet);
+        }
+    }
+    const size_t vertex_count = OptimizeVertexFetch(indices.data(), indices.size(), vertices.data(), positions.size(), mesh_cache_vertex_floats);
+    vertices.resize(vertex_count * mesh_cache_vertex_floats);
+
+    out.Indices = indices;
+    out.LODs.clear();
+    MeshLOD full = { 0, uint32_t(indices.size()), 0.0f };
+    out.LODs.push_back(full);
+
+    // The simplified levels use the vertices of the full mesh. Each level is simplified from the previous
+    // one, which is much faster than from the full mesh, and its error is bounded by the sum of the errors.
+    glm::vec3 bounds_min(0.0f), bounds_max(0.0f);
+    for (size_t i = 0; i < vertex_count; i++)
+    {
+        const float *vertex = &vertices[i * mesh_cache_vertex_floats];
+        const glm::vec3 position(vertex[0], vertex[1], vertex[2]);
+        bounds_min = (i == 0) ? position : glm::min(bounds_min, position);
+        bounds_max = (i == 0) ? position : glm::max(bounds_max, position);
+    }
+    const float max_error = lod_max_relative_error * glm::length(bounds_max - bounds_min);
+
+    // Every submesh is simplified by itself to its part of the triangles, so that the submeshes stay
+    // separate. A submesh that cannot be simplified any more keeps its triangles of the previous level.
+    std::vector<unsigned int> level_indices, simplified(indices.size());
+    for (size_t level = 1; level < mesh_cache_max_lods; level++)
+    {
+        const MeshLOD previous_lod = out.LODs.back();
+        float level_error = 0.0f;
+        level_indices.clear();
+        for (MeshSubmesh &submesh : out.Submeshes)
+        {
+            const unsigned int *previous = out.Indices.data() + submesh.FirstIndex[level - 1];
+            const size_t previous_count = submesh.IndexCount[level - 1];
+            const size_t target_index_count = (submesh.IndexCount[0] / 3 >> level) * 3;
+            float error = 0.0f;
+            size_t index_count = SimplifyMesh(simplified.data(), previous, previous_count, vertices.data(), vertex_count,
+                    mesh_cache_vertex_floats, target_index_count, max_error - previous_lod.Error, &error);
+            if (index_count == 0)
+            {
+                std::copy(previous, previous + previous_count, simplified.begin());
+                index_count = previous_count;
+                error = 0.0f;
+            }
+            else
+            {
+                OptimizeVertexCache(simplified.data(), index_count, vertex_count);
+            }
+
+            submesh.FirstIndex[level] = uint32_t(out.Indices.size() + level_indices.size());
+            submesh.IndexCount[level] = uint32_t(index_count);
+            level_indices.insert(level_indices.end(), simplified.begin(), simplified.begin() + index_count);
+            level_error = std::max(level_error, error);
+        }
+        if (level_indices.empty() || float(level_indices.size()) > lod_min_reduction * float(previous_lod.IndexCount))
+            break;
+
+        MeshLOD lod = { uint32_t(out.Indices.size()), uint32_t(level_indices.size()), previous_lod.Error + level_error };
+        out.Indices.insert(out.Indices.end(), level_indices.begin(), level_indices.end());
+        out.LODs.push_back(lod);
+    }
+
+    // The ranges of the levels that were left out stay empty
+    for (MeshSubmesh &submesh : out.Submeshes)
+    {
+        for (size_t level = out.LODs.size(); level < mesh_cache_max_lods; level++)
+        {
+            submesh.FirstIndex[level] = 0;
+            submesh.IndexCount[level] = 0;
+        }
+    }
+
+    // Simplifying a closed mesh may open it, each level is checked
+    out.Closed = true;
+    for (size_t level = 0; out.Closed && level < out.LODs.size(); level++)
+    {
+        out.Closed = IsMeshClosed(out.Indices.data() + out.LODs[level].FirstIndex, out.LODs[level].IndexCount, vertices.data(),
+                vertex_count, mesh_cache_vertex_floats);
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,30 @@
+#pragma once
+#ifndef INCLUDED_MESHBUILD_H
+#define INCLUDED_MESHBUILD_H
+
+#include <vector>
+
+#include "objparser.h"
+#include "meshcache.h"
+
+namespace PV112
+{
+
+/// Builds the mesh of parsed OBJ records. The vertices are deduplicated (IndexOBJTriangles), the
+/// triangles are ordered for the vertex cache and against overdraw and grouped into meshlets, and the
+/// vertices are ordered by their first use (see meshtools.h). The triangles are split into submeshes
+/// by the o, g, and usemtl records (GetOBJSubmeshes) and stay within their submesh.
+///
+/// Up to three simplified levels of detail with a half, a quarter, and an eighth of the triangles follow
+/// the full mesh (SimplifyMesh). A level is left out when the mesh cannot be simplified that much without
+/// moving its surface by more than 5 % of the size of its bounding box.
+///
+/// The mesh is marked closed if all its levels are closed (IsMeshClosed), only then can the renderer cull
+/// its back faces.
+///
+/// Returns false if some index of the OBJ records is out of range.
+bool BuildOBJMesh(const OBJData &obj, MeshData &out);
+
+}
+
+#endif	// INCLUDED_MESHBUILD_H
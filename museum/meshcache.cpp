@@ -0,0 +1,365 @@
+#include "meshcache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+
+namespace PV112
+{
+
+namespace
+{
+
+// Increase whenever the layout of the file or the content of the mesh changes
+const uint32_t mesh_cache_version = 7;
+
+const char mesh_cache_magic[8] = { 'P', 'V', 'M', 'E', 'S', 'H', '\0', '\0' };
+
+// The file starts with this header, the vertices, the indices, the meshlets, the submeshes, the offsets of
+// the names, and the names (terminated by zeros) follow it. All values are stored in the
+// byte order of the machine, a cache copied to a machine with another byte order has a wrong version.
+struct MeshCacheHeader
+{
+    char Magic[8];
+    uint32_t Version;
+    uint32_t HeaderSize;
+
+    uint64_t SourceSize;
+    int64_t SourceModificationTime;
+    uint64_t SourceHash;
+
+    uint64_t VertexOffset;
+    uint64_t VertexCount;
+    uint64_t IndexOffset;
+    uint64_t IndexCount;
+
+    float BoundsMin[3];
+    float BoundsMax[3];
+
+    uint32_t LODCount;
+    MeshLOD LODs[mesh_cache_max_lods];
+    // 1 if the mesh is closed, 0 otherwise
+    uint32_t Closed;
+
+    uint64_t MeshletOffset;
+    uint64_t MeshletCount;
+
+    uint64_t SubmeshOffset;
+    uint64_t SubmeshCount;
+    uint64_t MaterialCount;
+    // SubmeshCount + MaterialCount offsets into the strings
+    uint64_t NameOffset;
+    uint64_t StringOffset;
+    uint64_t StringSize;
+};
+
+// Data must be aligned for the vertex attributes, the indices, and the meshlets
+inline uint64_t AlignOffset(uint64_t offset)
+{
+    return (offset + 15) & ~uint64_t(15);
+}
+
+// Pads the file from 'position' to 'offset' and writes 'size' bytes of 'data' there
+bool WriteSection(FILE *file, uint64_t &position, uint64_t offset, const void *data, size_t size)
+{
+    const char padding[16] = {};
+    const size_t padding_size = size_t(offset - position);
+    position = offset + size;
+    return fwrite(padding, 1, padding_size, file) == padding_size && (size == 0 || fwrite(data, size, 1, file) == 1);
+}
+
+// Checks that 'count' items of 'item_size' bytes at 'offset' are within the file
+inline bool IsSectionValid(uint64_t offset, uint64_t count, size_t item_size, uint64_t file_size)
+{
+    return offset % 16 == 0 && offset <= file_size && count <= (file_size - offset) / item_size;
+}
+
+inline bool IsRangeValid(uint32_t first, uint32_t count, const MeshLOD &lod)
+{
+    return first >= lod.FirstIndex && count <= lod.IndexCount && first - lod.FirstIndex <= lod.IndexCount - count;
+}
+
+}
+
+std::string GetMeshCacheFileName(const char *source_file_name)
+{
+    return GetCacheFileName(source_file_name, ".pvmesh");
+}
+
+MeshCache::MeshCache()
+    : vertices(nullptr), vertex_count(0), indices(nullptr), index_count(0), lod_count(0), meshlets(nullptr), meshlet_count(0),
+    submeshes(nullptr), submesh_count(0), material_count(0), name_offsets(nullptr), strings(nullptr),
+    bounds_min(0.0f), bounds_max(0.0f), closed(false)
+{
+}
+
+bool MeshCache::Open(const char *file_name, const SourceStamp &source_stamp)
+{
+    Close();
+
+    if (!file.Open(file_name) || file.Size() < sizeof(MeshCacheHeader))
+    {
+        Close();
+        return false;
+    }
+
+    MeshCacheHeader header;
+    memcpy(&header, file.Data(), sizeof(header));
+
+    const uint64_t file_size = file.Size();
+    const bool valid = memcmp(header.Magic, mesh_cache_magic, sizeof(header.Magic)) == 0 &&
+        header.Version == mesh_cache_version &&
+        header.HeaderSize == sizeof(MeshCacheHeader) &&
+        header.SourceSize == source_stamp.Size &&
+        header.SourceModificationTime == source_stamp.ModificationTime &&
+        header.SourceHash == source_stamp.Hash &&
+        IsSectionValid(header.VertexOffset, header.VertexCount, sizeof(float) * mesh_cache_vertex_floats, file_size) &&
+        IsSectionValid(header.IndexOffset, header.IndexCount, sizeof(unsigned int), file_size) &&
+        IsSectionValid(header.MeshletOffset, header.MeshletCount, sizeof(Meshlet), file_size) &&
+        IsSectionValid(header.SubmeshOffset, header.SubmeshCount, sizeof(MeshSubmesh), file_size) &&
+        header.MaterialCount <= UINT32_MAX && header.SubmeshCount >= 1 &&
+        IsSectionValid(header.NameOffset, header.SubmeshCount + header.MaterialCount, sizeof(uint32_t), file_size) &&
+        IsSectionValid(header.StringOffset, header.StringSize, 1, file_size) &&
+        header.StringSize >= 1 && file.Data()[header.StringOffset + header.StringSize - 1] == '\0' &&
+        header.LODCount >= 1 && header.LODCount <= mesh_cache_max_lods;
+    bool valid_lods = valid;
+    for (uint32_t level = 0; valid_lods && level < header.LODCount; level++)
+    {
+        const MeshLOD &lod = header.LODs[level];
+        valid_lods = lod.FirstIndex <= header.IndexCount && lod.IndexCount <= header.IndexCount - lod.FirstIndex;
+    }
+    // The meshlets must stay within the first level, the renderer draws their ranges instead of it
+    const Meshlet *file_meshlets = reinterpret_cast<const Meshlet *>(file.Data() + header.MeshletOffset);
+    for (uint64_t i = 0; valid_lods && i < header.MeshletCount; i++)
+    {
+        valid_lods = IsRangeValid(file_meshlets[i].FirstIndex, file_meshlets[i].IndexCount, header.LODs[0]);
+    }
+    // So must the submeshes within every level, and their materials and names must exist. The strings end
+    // with a zero, so every name is terminated.
+    const MeshSubmesh *file_submeshes = reinterpret_cast<const MeshSubmesh *>(file.Data() + header.SubmeshOffset);
+    for (uint64_t i = 0; valid_lods && i < header.SubmeshCount; i++)
+    {
+        const MeshSubmesh &submesh = file_submeshes[i];
+        valid_lods = submesh.Material < header.MaterialCount;
+        for (uint32_t level = 0; valid_lods && level < header.LODCount; level++)
+            valid_lods = IsRangeValid(submesh.FirstIndex[level], submesh.IndexCount[level], header.LODs[level]);
+    }
+    const uint32_t *file_name_offsets = reinterpret_cast<const uint32_t *>(file.Data() + header.NameOffset);
+    for (uint64_t i = 0; valid_lods && i < header.SubmeshCount + header.MaterialCount; i++)
+    {
+        valid_lods = file_name_offsets[i] < header.StringSize;
+    }
+    // The indices go to OpenGL as they are, every index of a level must refer to a vertex. The meshlets
+    // and the submeshes are ranges of the levels, so their indices are checked too.
+    const unsigned int *file_indices = reinterpret_cast<const unsigned int *>(file.Data() + header.IndexOffset);
+    for (uint32_t level = 0; valid_lods && level < header.LODCount; level++)
+    {
+        const MeshLOD &lod = header.LODs[level];
+        const unsigned int *first = file_indices + lod.FirstIndex;
+        valid_lods = lod.IndexCount == 0 || *std::max_element(first, first + lod.IndexCount) < header.VertexCount;
+    }
+    if (!valid || !valid_lods)
+    {
+        Close();
+        return false;
+    }
+
+    vertices = reinterpret_cast<const float *>(file.Data() + header.VertexOffset);
+    vertex_count = size_t(header.VertexCount);
+    indices = reinterpret_cast<const unsigned int *>(file.Data() + header.IndexOffset);
+    index_count = size_t(header.IndexCount);
+    lod_count = header.LODCount;
+    std::copy(header.LODs, header.LODs + lod_count, lods);
+    meshlets = file_meshlets;
+    meshlet_count = size_t(header.MeshletCount);
+    submeshes = file_submeshes;
+    submesh_count = size_t(header.SubmeshCount);
+    material_count = size_t(header.MaterialCount);
+    name_offsets = file_name_offsets;
+    strings = file.Data() + header.StringOffset;
+    bounds_min = glm::vec3(header.BoundsMin[0], header.BoundsMin[1], header.BoundsMin[2]);
+    bounds_max = glm::vec3(header.BoundsMax[0], header.BoundsMax[1], header.BoundsMax[2]);
+    closed = header.Closed != 0;
+    return true;
+}
+
+void MeshCache::Close()
+{
+    file.Close();
+    vertices = nullptr;
+    vertex_count = 0;
+    indices = nullptr;
+    index_count = 0;
+    lod_count = 0;
+    meshlets = nullptr;
+    meshlet_count = 0;
+    submeshes = nullptr;
+    submesh_count = 0;
+    material_count = 0;
+    name_offsets = nullptr;
+    strings = nullptr;
+    bounds_min = glm::vec3(0.0f);
+    bounds_max = glm::vec3(0.0f);
+    closed = false;
+}
+
+const float *MeshCache::Vertices() const
+{
+    return vertices;
+}
+
+size_t MeshCache::VertexCount() const
+{
+    return vertex_count;
+}
+
+const unsigned int *MeshCache::Indices() const
+{
+    return indices;
+}
+
+size_t MeshCache::IndexCount() const
+{
+    return index_count;
+}
+
+size_t MeshCache::LODCount() const
+{
+    return lod_count;
+}
+
+const MeshLOD &MeshCache::LOD(size_t level) const
+{
+    return lods[level];
+}
+
+const Meshlet *MeshCache::Meshlets() const
+{
+    return meshlets;
+}
+
+size_t MeshCache::MeshletCount() const
+{
+    return meshlet_count;
+}
+
+size_t MeshCache::SubmeshCount() const
+{
+    return submesh_count;
+}
+
+const MeshSubmesh &MeshCache::Submesh(size_t index) const
+{
+    return submeshes[index];
+}
+
+const char *MeshCache::SubmeshName(size_t index) const
+{
+    return strings + name_offsets[index];
+}
+
+size_t MeshCache::MaterialCount() const
+{
+    return material_count;
+}
+
+const char *MeshCache::MaterialName(size_t index) const
+{
+    return strings + name_offsets[submesh_count + index];
+}
+
+glm::vec3 MeshCache::BoundsMin() const
+{
+    return bounds_min;
+}
+
+glm::vec3 MeshCache::BoundsMax() const
+{
+    return bounds_max;
+}
+
+bool MeshCache::Closed() const
+{
+    return closed;
+}
+
+bool WriteMeshCache(const char *file_name, const SourceStamp &source_stamp, const MeshData &mesh)
+{
+    if (mesh.LODs.size() < 1 || mesh.LODs.size() > mesh_cache_max_lods || mesh.Submeshes.empty() ||
+            mesh.SubmeshNames.size() != mesh.Submeshes.size())
+        return false;
+
+    const float *vertices = mesh.Vertices.data();
+    const size_t vertex_count = mesh.Vertices.size() / mesh_cache_vertex_floats;
+
+    // The submesh names and then the material names, each terminated by a zero
+    std::vector<uint32_t> name_offsets;
+    std::string strings;
+    for (size_t i = 0; i < mesh.SubmeshNames.size() + mesh.Materials.size(); i++)
+    {
+        const std::string &name = (i < mesh.SubmeshNames.size()) ? mesh.SubmeshNames[i] : mesh.Materials[i - mesh.SubmeshNames.size()];
+        name_offsets.push_back(uint32_t(strings.size()));
+        strings.append(name.c_str(), name.size() + 1);
+    }
+
+    MeshCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.Magic, mesh_cache_magic, sizeof(header.Magic));
+    header.Version = mesh_cache_version;
+    header.HeaderSize = sizeof(MeshCacheHeader);
+    header.SourceSize = source_stamp.Size;
+    header.SourceModificationTime = source_stamp.ModificationTime;
+    header.SourceHash = source_stamp.Hash;
+
+    const uint64_t vertex_bytes = uint64_t(vertex_count) * sizeof(float) * mesh_cache_vertex_floats;
+    const uint64_t index_bytes = sizeof(unsigned int) * mesh.Indices.size();
+    const uint64_t meshlet_bytes = sizeof(Meshlet) * mesh.Meshlets.size();
+    const uint64_t submesh_bytes = sizeof(MeshSubmesh) * mesh.Submeshes.size();
+    const uint64_t name_bytes = sizeof(uint32_t) * name_offsets.size();
+    header.VertexOffset = AlignOffset(sizeof(MeshCacheHeader));
+    header.VertexCount = vertex_count;
+    header.IndexOffset = AlignOffset(header.VertexOffset + vertex_bytes);
+    header.IndexCount = mesh.Indices.size();
+    header.MeshletOffset = AlignOffset(header.IndexOffset + index_bytes);
+    header.MeshletCount = mesh.Meshlets.size();
+    header.SubmeshOffset = AlignOffset(header.MeshletOffset + meshlet_bytes);
+    header.SubmeshCount = mesh.Submeshes.size();
+    header.MaterialCount = mesh.Materials.size();
+    header.NameOffset = AlignOffset(header.SubmeshOffset + submesh_bytes);
+    header.StringOffset = AlignOffset(header.NameOffset + name_bytes);
+    header.StringSize = strings.size();
+    header.LODCount = uint32_t(mesh.LODs.size());
+    std::copy(mesh.LODs.begin(), mesh.LODs.end(), header.LODs);
+    header.Closed = mesh.Closed ? 1 : 0;
+
+    for (int axis = 0; axis < 3; axis++)
+    {
+        header.BoundsMin[axis] = vertex_count ? vertices[axis] : 0.0f;
+        header.BoundsMax[axis] = vertex_count ? vertices[axis] : 0.0f;
+    }
+    for (size_t i = 0; i < vertex_count; i++)
+    {
+        const float *position = vertices + i * mesh_cache_vertex_floats;
+        for (int axis = 0; axis < 3; axis++)
+        {
+            header.BoundsMin[axis] = std::min(header.BoundsMin[axis], position[axis]);
+            header.BoundsMax[axis] = std::max(header.BoundsMax[axis], position[axis]);
+        }
+    }
+
+    return WriteCacheFile(file_name, [&](FILE *file)
+    {
+        uint64_t position = 0;
+        bool ok = WriteSection(file, position, 0, &header, sizeof(header));
+        ok = ok && WriteSection(file, position, header.VertexOffset, vertices, size_t(vertex_bytes));
+        ok = ok && WriteSection(file, position, header.IndexOffset, mesh.Indices.data(), size_t(index_bytes));
+        ok = ok && WriteSection(file, position, header.MeshletOffset, mesh.Meshlets.data(), size_t(meshlet_bytes));
+        ok = ok && WriteSection(file, position, header.SubmeshOffset, mesh.Submeshes.data(), size_t(submesh_bytes));
+        ok = ok && WriteSection(file, position, header.NameOffset, name_offsets.data(), size_t(name_bytes));
+        ok = ok && WriteSection(file, position, header.StringOffset, strings.data(), strings.size());
+        return ok;
+    });
+}
+
+}
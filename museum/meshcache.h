@@ -0,0 +1,146 @@
+#pragma once
+#ifndef INCLUDED_MESHCACHE_H
+#define INCLUDED_MESHCACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "mappedfile.h"
+#include "meshtools.h"
+#include "sourcestamp.h"
+
+namespace PV112
+{
+
+/// Returns the name of the cache file of a mesh, the cache is stored next to the source file with the
+/// extension replaced by .pvmesh ("./obj_files/lion.obj" -> "./obj_files/lion.pvmesh").
+std::string GetMeshCacheFileName(const char *source_file_name);
+
+/// Number of floats of a single vertex in the cache: position (3), normal (3), and texture coordinate (2),
+/// the same interleaved layout the basic objects use.
+const size_t mesh_cache_vertex_floats = 8;
+
+/// Maximum number of levels of detail of a cached mesh, including the full one.
+const size_t mesh_cache_max_lods = 4;
+
+/// A level of detail of a mesh, a range of its indices. All levels use the same vertices.
+struct MeshLOD
+{
+    uint32_t FirstIndex;
+    uint32_t IndexCount;
+    // Largest distance between the surface of this level and the full mesh, in the units of the positions
+    float Error;
+};
+
+/// A part of a mesh drawn with its own material, for example one o, g, or usemtl record of an OBJ file.
+/// Each level of detail has a range of the indices of every submesh, the ranges of the submeshes follow
+/// each other in the range of the level.
+struct MeshSubmesh
+{
+    // Index to the material names of the mesh
+    uint32_t Material;
+    uint32_t FirstIndex[mesh_cache_max_lods];
+    uint32_t IndexCount[mesh_cache_max_lods];
+};
+
+/// Indexed triangle mesh as LoadOBJ draws it and the mesh cache stores it.
+struct MeshData
+{
+    // mesh_cache_vertex_floats floats per vertex
+    std::vector<float> Vertices;
+    // Triangles of all levels of detail, one level after another
+    std::vector<unsigned int> Indices;
+    // Ranges of 'Indices' with the levels of detail, the first one is the full mesh
+    std::vector<MeshLOD> LODs;
+    // Meshlets of the full mesh, they cover the first level of detail
+    std::vector<Meshlet> Meshlets;
+    // At least one submesh, together they cover every level of detail
+    std::vector<MeshSubmesh> Submeshes;
+    std::vector<std::string> SubmeshNames;
+    std::vector<std::string> Materials;
+    // True if every level of detail is closed (see IsMeshClosed), so its back faces can be culled
+    bool Closed;
+};
+
+/// Memory-mapped .pvmesh file with an indexed triangle mesh.
+///
+/// The vertices and indices are NOT copied, the pointers point directly into the mapping and can be
+/// passed to glBufferData. They are valid until the cache is closed.
+class MeshCache
+{
+public:
+    MeshCache();
+
+    /// Maps the cache file and checks it. Returns false if the file does not exist, it was written by
+    /// another version of the program, it is damaged, or it was created from a different source file.
+    bool Open(const char *file_name, const SourceStamp &source_stamp);
+
+    void Close();
+
+    const float *Vertices() const;
+    size_t VertexCount() const;
+    const unsigned int *Indices() const;
+    size_t IndexCount() const;
+
+    /// Levels of detail, the first one is the full mesh. The index ranges are checked by Open, and so is
+    /// every index in them, it is smaller than VertexCount.
+    size_t LODCount() const;
+    const MeshLOD &LOD(size_t level) const;
+
+    /// Meshlets of the first level of detail, their index ranges are checked by Open. Points into the
+    /// mapping like the vertices.
+    const Meshlet *Meshlets() const;
+    size_t MeshletCount() const;
+
+    /// Submeshes and the names of their materials, checked by Open. The names point into the mapping.
+    size_t SubmeshCount() const;
+    const MeshSubmesh &Submesh(size_t index) const;
+    const char *SubmeshName(size_t index) const;
+    size_t MaterialCount() const;
+    const char *MaterialName(size_t index) const;
+
+    /// Axis-aligned bounding box of the positions
+    glm::vec3 BoundsMin() const;
+    glm::vec3 BoundsMax() const;
+
+    /// See MeshData::Closed
+    bool Closed() const;
+
+private:
+    // The mapping must not be copied, the pointers would point to the memory of another object
+    MeshCache(const MeshCache &);
+    MeshCache &operator =(const MeshCache &);
+
+    MappedFile file;
+    const float *vertices;
+    size_t vertex_count;
+    const unsigned int *indices;
+    size_t index_count;
+    MeshLOD lods[mesh_cache_max_lods];
+    size_t lod_count;
+    const Meshlet *meshlets;
+    size_t meshlet_count;
+    const MeshSubmesh *submeshes;
+    size_t submesh_count;
+    size_t material_count;
+    // Offsets of the submesh names and then the material names in 'strings'
+    const uint32_t *name_offsets;
+    const char *strings;
+    glm::vec3 bounds_min;
+    glm::vec3 bounds_max;
+    bool closed;
+};
+
+/// Writes a mesh to a cache file. It must have at least one and at most mesh_cache_max_lods levels of
+/// detail, and a name for every submesh. The file is replaced only when it is completely written.
+///
+/// Returns false if the file cannot be written, for example when the directory is read-only.
+bool WriteMeshCache(const char *file_name, const SourceStamp &source_stamp, const MeshData &mesh);
+
+}
+
+#endif	// INCLUDED_MESHCACHE_H
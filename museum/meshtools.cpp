@@ -0,0 +1,1175 @@
+#include "meshtools.h"
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+
+#include <glm/glm.hpp>
+
+namespace PV112
+{
+
+namespace
+{
+
+// Simulates drawing a triangle through a FIFO cache, see AnalyzeVertexCache. Returns the number of
+// vertices that had to be transformed.
+unsigned UpdateCache(const unsigned int *triangle, unsigned cache_size, std::vector<size_t> &cache_time, size_t &time)
+{
+    unsigned misses = 0;
+    for (int c = 0; c < 3; c++)
+    {
+        const unsigned v = triangle[c];
+        if (time - cache_time[v] > cache_size)
+        {
+            cache_time[v] = time;
+            time++;
+            misses++;
+        }
+    }
+    return misses;
+}
+
+// Position of a vertex of an interleaved array
+inline glm::vec3 VertexPosition(const float *vertices, size_t vertex_floats, unsigned v)
+{
+    const float *position = vertices + size_t(v) * vertex_floats;
+    return glm::vec3(position[0], position[1], position[2]);
+}
+
+}
+
+VertexCacheStats AnalyzeVertexCache(const unsigned int *indices, size_t index_count, size_t vertex_count, unsigned cache_size)
+{
+    VertexCacheStats stats;
+    stats.Transformed = 0;
+
+    // The time (in transformed vertices) each vertex entered the cache, a vertex is in the FIFO cache
+    // until 'cache_size' other vertices enter it after it
+    std::vector<size_t> cached_at(vertex_count, 0);
+    for (size_t i = 0; i < index_count; i++)
+    {
+        const unsigned v = indices[i];
+        if (v >= vertex_count)
+            continue;
+        if (cached_at[v] == 0 || stats.Transformed + 1 - cached_at[v] > cache_size)
+        {
+            stats.Transformed++;
+            cached_at[v] = stats.Transformed;
+        }
+    }
+
+    const size_t triangle_count = index_count / 3;
+    stats.ACMR = triangle_count ? float(double(stats.Transformed) / double(triangle_count)) : 0.0f;
+    stats.ATVR = vertex_count ? float(double(stats.Transformed) / double(vertex_count)) : 0.0f;
+    return stats;
+}
+
+void TriangleStripToList(const unsigned int *strip, size_t strip_count, std::vector<unsigned int> &out_indices)
+{
+    out_indices.clear();
+    for (size_t i = 0; i + 2 < strip_count; i++)
+    {
+        unsigned a = strip[i], b = strip[i + 1];
+        const unsigned c = strip[i + 2];
+        if (a == b || b == c || a == c)
+            continue;
+
+        // Every other triangle of a strip has the opposite order of vertices
+        if (i % 2 == 1)
+            std::swap(a, b);
+        out_indices.push_back(a);
+        out_indices.push_back(b);
+        out_indices.push_back(c);
+    }
+}
+
+void OptimizeVertexCache(unsigned int *indices, size_t index_count, size_t vertex_count, unsigned cache_size)
+{
+    const size_t triangle_count = index_count / 3;
+    if (triangle_count == 0)
+        return;
+
+    // Triangles adjacent to each vertex, the list of vertex v is at [first_triangle[v], first_triangle[v + 1])
+    std::vector<unsigned> live_triangles(vertex_count, 0);
+    for (size_t i = 0; i < triangle_count * 3; i++)
+    {
+        if (indices[i] >= vertex_count)
+            return;        // Invalid input, leave it as it is
+        live_triangles[indices[i]]++;
+    }
+    std::vector<size_t> first_triangle(vertex_count + 1, 0);
+    for (size_t v = 0; v < vertex_count; v++)
+        first_triangle[v + 1] = first_triangle[v] + live_triangles[v];
+    std::vector<unsigned> adjacent_triangles(triangle_count * 3);
+    {
+        std::vector<size_t> fill(first_triangle.begin(), first_triangle.end() - 1);
+        for (size_t i = 0; i < triangle_count * 3; i++)
+            adjacent_triangles[fill[indices[i]]++] = unsigned(i / 3);
+    }
+
+    std::vector<unsigned> output;
+    output.reserve(triangle_count * 3);
+    std::vector<char> emitted(triangle_count, 0);
+
+    // Time stamps of the vertices entering the cache, a vertex with stamp 'c' is in the cache while
+    // time - c < cache_size. Starting the time at cache_size + 1 makes all vertices initially missing.
+    std::vector<size_t> cache_time(vertex_count, 0);
+    size_t time = cache_size + 1;
+
+    // Recently used vertices, they are good candidates when the current fan has no way to continue
+    std::vector<unsigned> dead_end;
+    std::vector<unsigned> candidates;
+    size_t cursor = 0;        // Vertices before it have no live triangles
+
+    long long fanning = indices[0];        // The vertex whose remaining triangles are emitted next
+    while (fanning >= 0)
+    {
+        const unsigned f = unsigned(fanning);
+        candidates.clear();
+
+        for (size_t k = first_triangle[f]; k < first_triangle[f + 1]; k++)
+        {
+            const unsigned t = adjacent_triangles[k];
+            if (emitted[t])
+                continue;
+            emitted[t] = 1;
+
+            for (int c = 0; c < 3; c++)
+            {
+                const unsigned v = indices[t * 3 + c];
+                output.push_back(v);
+                dead_end.push_back(v);
+                candidates.push_back(v);
+                live_triangles[v]--;
+                if (time - cache_time[v] > cache_size)
+                {
+                    cache_time[v] = time;
+                    time++;
+                }
+            }
+        }
+
+        // Continue with the candidate that stays longest in the cache while its triangles are emitted.
+        // Candidates that would fall out of the cache meanwhile are not used at all.
+        fanning = -1;
+        long long best_priority = 0;
+        for (unsigned v : candidates)
+        {
+            if (live_triangles[v] == 0)
+                continue;
+
+            // Emitting the triangles of v adds at most 2 vertices per triangle to the cache
+            long long priority = 0;
+            if (time - cache_time[v] + 2 * live_triangles[v] <= cache_size)
+                priority = (long long)(time - cache_time[v]);
+            if (priority > best_priority)
+            {
+                best_priority = priority;
+                fanning = v;
+            }
+        }
+
+        if (fanning < 0)
+        {
+            // Dead end, try the recently used vertices first, then any vertex with a live triangle
+            while (!dead_end.empty() && fanning < 0)
+            {
+                const unsigned v = dead_end.back();
+                dead_end.pop_back();
+                if (live_triangles[v] > 0)
+                    fanning = v;
+            }
+            while (fanning < 0 && cursor < vertex_count)
+            {
+                if (live_triangles[cursor] > 0)
+                    fanning = (long long)cursor;
+                cursor++;
+            }
+        }
+    }
+
+    // Meshes that are already well ordered (such as long strips converted to lists) may be better than
+    // the result, keep the better order
+    const VertexCacheStats before = AnalyzeVertexCache(indices, triangle_count * 3, vertex_count, cache_size);
+    const VertexCacheStats after = AnalyzeVertexCache(output.data(), output.size(), vertex_count, cache_size);
+    if (after.Transformed < before.Transformed)
+        std::copy(output.begin(), output.end(), indices);
+}
+
+void OptimizeOverdraw(unsigned int *indices, size_t index_count, const float *vertices, size_t vertex_count, size_t vertex_floats,
+        float threshold, unsigned cache_size)
+{
+    const size_t triangle_count = index_count / 3;
+    if (triangle_count == 0)
+        return;
+    for (size_t i = 0; i < triangle_count * 3; i++)
+    {
+        if (indices[i] >= vertex_count)
+            return;        // Invalid input, leave it as it is
+    }
+
+    // Moving the time forward by more than the cache size empties the cache
+    std::vector<size_t> cache_time(vertex_count, 0);
+    size_t time = cache_size + 1;
+
+    // Hard boundaries, a triangle with all three vertices missing from the cache starts a new patch
+    std::vector<size_t> patches;
+    for (size_t t = 0; t < triangle_count; t++)
+    {
+        if (UpdateCache(indices + t * 3, cache_size, cache_time, time) == 3 || t == 0)
+            patches.push_back(t);
+    }
+    patches.push_back(triangle_count);
+
+    // Soft boundaries, a patch is split wherever the cache efficiency of the current cluster is already
+    // as good as that of the whole patch (times the threshold)
+    std::vector<size_t> clusters;
+    for (size_t p = 0; p + 1 < patches.size(); p++)
+    {
+        const size_t begin = patches[p], end = patches[p + 1];
+
+        time += cache_size + 1;
+        size_t patch_misses = 0;
+        for (size_t t = begin; t < end; t++)
+            patch_misses += UpdateCache(indices + t * 3, cache_size, cache_time, time);
+        const float patch_threshold = threshold * float(patch_misses) / float(end - begin);
+
+        clusters.push_back(begin);
+        time += cache_size + 1;
+        size_t misses = 0, triangles = 0;
+        for (size_t t = begin; t < end; t++)
+        {
+            misses += UpdateCache(indices + t * 3, cache_size, cache_time, time);
+            triangles++;
+            if (float(misses) <= patch_threshold * float(triangles))
+            {
+                clusters.push_back(t + 1);
+                time += cache_size + 1;
+                misses = 0;
+                triangles = 0;
+            }
+        }
+
+        // The last cluster is whatever remained, usually a few triangles with a bad cache efficiency.
+        // Merge it with the previous one (this also removes the empty cluster starting at 'end').
+        if (clusters.back() != begin)
+            clusters.pop_back();
+    }
+    clusters.push_back(triangle_count);
+
+    // Area-weighted centroid of the whole mesh, and of each cluster with its average normal
+    const size_t cluster_count = clusters.size() - 1;
+    std::vector<glm::vec3> cluster_centroids(cluster_count, glm::vec3(0.0f));
+    std::vector<glm::vec3> cluster_normals(cluster_count, glm::vec3(0.0f));
+    glm::vec3 mesh_centroid(0.0f);
+    float mesh_area = 0.0f;
+    for (size_t c = 0; c < cluster_count; c++)
+    {
+        float cluster_area = 0.0f;
+        for (size_t t = clusters[c]; t < clusters[c + 1]; t++)
+        {
+            const glm::vec3 a = VertexPosition(vertices, vertex_floats, indices[t * 3 + 0]);
+            const glm::vec3 b = VertexPosition(vertices, vertex_floats, indices[t * 3 + 1]);
+            const glm::vec3 d = VertexPosition(vertices, vertex_floats, indices[t * 3 + 2]);
+
+            // The length of the cross product is twice the area, it weights the normal already
+            const glm::vec3 normal = glm::cross(b - a, d - a);
+            const float area = glm::length(normal);
+            const glm::vec3 center = (a + b + d) / 3.0f;
+
+            cluster_centroids[c] += center * area;
+            cluster_normals[c] += normal;
+            cluster_area += area;
+        }
+
+        mesh_centroid += cluster_centroids[c];
+        mesh_area += cluster_area;
+        if (cluster_area > 0.0f)
+            cluster_centroids[c] /= cluster_area;
+    }
+    if (mesh_area > 0.0f)
+        mesh_centroid /= mesh_area;
+
+    // Clusters far from the centroid in the direction they face are more likely to hide the others
+    std::vector<float> sort_keys(cluster_count);
+    std::vector<size_t> order(cluster_count);
+    for (size_t c = 0; c < cluster_count; c++)
+    {
+        const float normal_length = glm::length(cluster_normals[c]);
+        const glm::vec3 normal = (normal_length > 0.0f) ? cluster_normals[c] / normal_length : glm::vec3(0.0f);
+        sort_keys[c] = glm::dot(cluster_centroids[c] - mesh_centroid, normal);
+        order[c] = c;
+    }
+    std::stable_sort(order.begin(), order.end(), [&sort_keys](size_t a, size_t b) { return sort_keys[a] > sort_keys[b]; });
+
+    std::vector<unsigned int> output;
+    output.reserve(triangle_count * 3);
+    for (size_t c : order)
+        output.insert(output.end(), indices + clusters[c] * 3, indices + clusters[c + 1] * 3);
+    std::copy(output.begin(), output.end(), indices);
+}
+
+OverdrawStats AnalyzeOverdraw(const unsigned int *indices, size_t index_count, const float *vertices, size_t vertex_count, size_t vertex_floats)
+{
+    const int resolution = 256;
+
+    OverdrawStats stats;
+    stats.Covered = 0;
+    stats.Shaded = 0;
+    stats.Overdraw = 0.0f;
+    if (vertex_count == 0)
+        return stats;
+
+    glm::vec3 bounds_min = VertexPosition(vertices, vertex_floats, 0);
+    glm::vec3 bounds_max = bounds_min;
+    for (size_t v = 0; v < vertex_count; v++)
+    {
+        bounds_min = glm::min(bounds_min, VertexPosition(vertices, vertex_floats, unsigned(v)));
+        bounds_max = glm::max(bounds_max, VertexPosition(vertices, vertex_floats, unsigned(v)));
+    }
+    const glm::vec3 extent = bounds_max - bounds_min;
+    const float scale = float(resolution - 1) / std::max(std::max(extent.x, extent.y), std::max(extent.z, 1e-20f));
+
+    std::vector<float> depth(resolution * resolution);
+    for (int view = 0; view < 6; view++)
+    {
+        // Looking along the axis 'view / 2', from its negative or positive side
+        const int axis = view / 2;
+        const int u_axis = (axis + 1) % 3, v_axis = (axis + 2) % 3;
+        const float direction = (view % 2) ? -1.0f : 1.0f;
+        std::fill(depth.begin(), depth.end(), 1e30f);
+
+        for (size_t i = 0; i + 2 < index_count; i += 3)
+        {
+            if (indices[i] >= vertex_count || indices[i + 1] >= vertex_count || indices[i + 2] >= vertex_count)
+                continue;
+
+            // Screen coordinates in pixels and depth of the triangle
+            float x[3], y[3], z[3];
+            for (int c = 0; c < 3; c++)
+            {
+                const glm::vec3 p = (VertexPosition(vertices, vertex_floats, indices[i + c]) - bounds_min) * scale;
+                x[c] = p[u_axis];
+                y[c] = p[v_axis];
+                z[c] = p[axis] * direction;
+            }
+            const float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+            if (area == 0.0f)
+                continue;
+
+            const int min_x = std::max(0, int(std::ceil(std::min(x[0], std::min(x[1], x[2])) - 0.5f)));
+            const int max_x = std::min(resolution - 1, int(std::floor(std::max(x[0], std::max(x[1], x[2])) - 0.5f)));
+            const int min_y = std::max(0, int(std::ceil(std::min(y[0], std::min(y[1], y[2])) - 0.5f)));
+            const int max_y = std::min(resolution - 1, int(std::floor(std::max(y[0], std::max(y[1], y[2])) - 0.5f)));
+            for (int py = min_y; py <= max_y; py++)
+            {
+                for (int px = min_x; px <= max_x; px++)
+                {
+                    // Barycentric coordinates of the pixel center, the sign of 'area' handles both windings
+                    const float cx = float(px) + 0.5f, cy = float(py) + 0.5f;
+                    const float w0 = ((x[1] - cx) * (y[2] - cy) - (x[2] - cx) * (y[1] - cy)) / area;
+                    const float w1 = ((x[2] - cx) * (y[0] - cy) - (x[0] - cx) * (y[2] - cy)) / area;
+                    const float w2 = 1.0f - w0 - w1;
+                    if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f)
+                        continue;
+
+                    const float fragment_depth = w0 * z[0] + w1 * z[1] + w2 * z[2];
+                    float &pixel = depth[py * resolution + px];
+                    if (fragment_depth < pixel)
+                    {
+                        if (pixel == 1e30f)
+                            stats.Covered++;
+                        pixel = fragment_depth;
+                        stats.Shaded++;
+                    }
+                }
+            }
+        }
+    }
+
+    stats.Overdraw = stats.Covered ? float(double(stats.Shaded) / double(stats.Covered)) : 0.0f;
+    return stats;
+}
+
+size_t OptimizeVertexFetch(unsigned int *indices, size_t index_count, float *vertices, size_t vertex_count, size_t vertex_floats)
+{
+    const unsigned unused = ~0u;
+    std::vector<unsigned> remap(vertex_count, unused);
+    unsigned next = 0;
+    for (size_t i = 0; i < index_count; i++)
+    {
+        if (indices[i] >= vertex_count)
+            return vertex_count;        // Invalid input, leave it as it is
+        if (remap[indices[i]] == unused)
+            remap[indices[i]] = next++;
+    }
+
+    std::vector<float> reordered(size_t(next) * vertex_floats);
+    for (size_t v = 0; v < vertex_count; v++)
+    {
+        if (remap[v] != unused)
+            std::copy(vertices + v * vertex_floats, vertices + (v + 1) * vertex_floats, reordered.begin() + size_t(remap[v]) * vertex_floats);
+    }
+    std::copy(reordered.begin(), reordered.end(), vertices);
+
+    for (size_t i = 0; i < index_count; i++)
+        indices[i] = remap[indices[i]];
+    return next;
+}
+
+namespace
+{
+
+// Quadric error metric of Garland and Heckbert, the sum of weighted squared distances of a point from
+// a set of planes: p^T A p + 2 b^T p + c. 'w' is the sum of the weights.
+struct Quadric
+{
+    double a00, a01, a02, a11, a12, a22;
+    double b0, b1, b2;
+    double c;
+    double w;
+};
+
+// Adds a plane with the unit normal 'n' that goes through the point 'p'
+void AddPlane(Quadric &q, const glm::vec3 &n, const glm::vec3 &p, double weight)
+{
+    const double nx = n.x, ny = n.y, nz = n.z;
+    const double d = -(nx * p.x + ny * p.y + nz * p.z);
+    q.a00 += weight * nx * nx;  q.a01 += weight * nx * ny;  q.a02 += weight * nx * nz;
+    q.a11 += weight * ny * ny;  q.a12 += weight * ny * nz;  q.a22 += weight * nz * nz;
+    q.b0 += weight * nx * d;    q.b1 += weight * ny * d;    q.b2 += weight * nz * d;
+    q.c += weight * d * d;
+    q.w += weight;
+}
+
+void AddQuadric(Quadric &q, const Quadric &r)
+{
+    q.a00 += r.a00;  q.a01 += r.a01;  q.a02 += r.a02;
+    q.a11 += r.a11;  q.a12 += r.a12;  q.a22 += r.a22;
+    q.b0 += r.b0;    q.b1 += r.b1;    q.b2 += r.b2;
+    q.c += r.c;
+    q.w += r.w;
+}
+
+// Mean squared distance of 'p' from the planes of the quadric
+double QuadricError(const Quadric &q, const glm::vec3 &p)
+{
+    const double x = p.x, y = p.y, z = p.z;
+    const double e = x * (q.a00 * x + q.a01 * y + q.a02 * z) + y * (q.a01 * x + q.a11 * y + q.a12 * z) + z * (q.a02 * x + q.a12 * y + q.a22 * z)
+        + 2.0 * (q.b0 * x + q.b1 * y + q.b2 * z) + q.c;
+    return (q.w > 0.0) ? std::fabs(e) / q.w : 0.0;
+}
+
+// How a vertex may be collapsed, see SimplifyMesh
+enum class VertexKind
+{
+    Manifold,       // Inside a surface with continuous attributes, can be collapsed to any neighbour
+    Border,         // On an open border of the mesh, can slide only along the border
+    Seam,           // One of two vertices at the same position with different attributes, both move together along the seam
+    Locked          // Corners, non-manifold vertices and so on, never moves
+};
+
+// Triangles that use each vertex, in the compressed sparse row format
+struct VertexTriangles
+{
+    std::vector<unsigned int> Offsets;
+    std::vector<unsigned int> Triangles;
+
+    void Build(const unsigned int *indices, size_t index_count, size_t vertex_count)
+    {
+        Offsets.assign(vertex_count + 1, 0);
+        for (size_t i = 0; i < index_count; i++)
+            Offsets[indices[i] + 1]++;
+        for (size_t v = 0; v < vertex_count; v++)
+            Offsets[v + 1] += Offsets[v];
+
+        Triangles.resize(index_count);
+        std::vector<unsigned int> fill(Offsets.begin(), Offsets.end() - 1);
+        for (size_t i = 0; i < index_count; i++)
+            Triangles[fill[indices[i]]++] = unsigned(i / 3);
+    }
+};
+
+// Returns true if some triangle has the directed edge a -> b
+bool HasEdge(const VertexTriangles &adjacency, const unsigned int *indices, unsigned a, unsigned b)
+{
+    for (unsigned i = adjacency.Offsets[a]; i < adjacency.Offsets[a + 1]; i++)
+    {
+        const unsigned int *triangle = indices + adjacency.Triangles[i] * 3;
+        for (int c = 0; c < 3; c++)
+        {
+            if (triangle[c] == a && triangle[(c + 1) % 3] == b)
+                return true;
+        }
+    }
+    return false;
+}
+
+// Returns true if the edge between a and b exists, and it is used by triangles on one side only
+bool IsOpenEdge(const VertexTriangles &adjacency, const unsigned int *indices, unsigned a, unsigned b)
+{
+    return HasEdge(adjacency, indices, a, b) != HasEdge(adjacency, indices, b, a);
+}
+
+// Vertices with the same position but different normals or texture coordinates, the "wedges" of a single
+// position, are linked in a circular list by 'next_wedge', and share the id of the position
+void LinkWedges(const float *vertices, size_t vertex_count, size_t vertex_floats, std::vector<unsigned> &position_ids,
+        std::vector<unsigned> &next_wedge)
+{
+    std::vector<unsigned> sorted(vertex_count);
+    for (size_t v = 0; v < vertex_count; v++)
+        sorted[v] = unsigned(v);
+    std::sort(sorted.begin(), sorted.end(), [vertices, vertex_floats](unsigned a, unsigned b)
+    {
+        const float *pa = vertices + size_t(a) * vertex_floats;
+        const float *pb = vertices + size_t(b) * vertex_floats;
+        return std::lexicographical_compare(pa, pa + 3, pb, pb + 3);
+    });
+
+    position_ids.resize(vertex_count);
+    next_wedge.resize(vertex_count);
+    for (size_t begin = 0, end; begin < vertex_count; begin = end)
+    {
+        const float *position = vertices + size_t(sorted[begin]) * vertex_floats;
+        for (end = begin + 1; end < vertex_count && std::equal(position, position + 3, vertices + size_t(sorted[end]) * vertex_floats); end++)
+        {
+        }
+        for (size_t i = begin; i < end; i++)
+        {
+            position_ids[sorted[i]] = sorted[begin];
+            next_wedge[sorted[i]] = sorted[(i + 1 < end) ? i + 1 : begin];
+        }
+    }
+}
+
+// Returns true if moving vertex 'u' to 'target' turns some of its triangles over or folds them more than
+// about 75 degrees. Triangles that collapse because they contain a vertex at 'target' are ignored.
+bool FlipsTriangles(const VertexTriangles &adjacency, const unsigned int *indices, const float *vertices, size_t vertex_floats,
+        const std::vector<unsigned> &position_ids, unsigned u, unsigned target)
+{
+    const glm::vec3 target_position = VertexPosition(vertices, vertex_floats, target);
+    for (unsigned i = adjacency.Offsets[u]; i < adjacency.Offsets[u + 1]; i++)
+    {
+        const unsigned int *triangle = indices + adjacency.Triangles[i] * 3;
+        glm::vec3 before[3], after[3];
+        bool collapses = false;
+        for (int c = 0; c < 3; c++)
+        {
+            collapses = collapses || position_ids[triangle[c]] == position_ids[target];
+            before[c] = VertexPosition(vertices, vertex_floats, triangle[c]);
+            after[c] = (triangle[c] == u) ? target_position : before[c];
+        }
+        if (collapses)
+            continue;
+
+        const glm::vec3 normal_before = glm::cross(before[1] - before[0], before[2] - before[0]);
+        const glm::vec3 normal_after = glm::cross(after[1] - after[0], after[2] - after[0]);
+        if (glm::dot(normal_before, normal_after) <= 0.25f * glm::length(normal_before) * glm::length(normal_after))
+            return true;
+    }
+    return false;
+}
+
+// Collapse of 'from' into 'to', the error is that of the quadric of 'from' at the position of 'to'
+struct EdgeCollapse
+{
+    unsigned From, To;
+    double Error;
+};
+
+}
+
+size_t SimplifyMesh(unsigned int *out_indices, const unsigned int *indices, size_t index_count, const float *vertices, size_t vertex_count,
+        size_t vertex_floats, size_t target_index_count, float max_error, float *out_error)
+{
+    index_count -= index_count % 3;
+    std::copy(indices, indices + index_count, out_indices);
+    if (out_error)
+        *out_error = 0.0f;
+    for (size_t i = 0; i < index_count; i++)
+    {
+        if (indices[i] >= vertex_count)
+            return index_count;         // Invalid input, leave it as it is
+    }
+
+    std::vector<unsigned> position_ids, next_wedge;
+    LinkWedges(vertices, vertex_count, vertex_floats, position_ids, next_wedge);
+
+    // Planes of the triangles, and of the open edges perpendicular to their triangles so that the borders
+    // and the seams keep their shape
+    const double edge_weight = 10.0;
+    VertexTriangles adjacency;
+    adjacency.Build(out_indices, index_count, vertex_count);
+
+    std::vector<Quadric> quadrics(vertex_count);
+    std::memset(quadrics.data(), 0, quadrics.size() * sizeof(Quadric));
+    std::vector<unsigned> open_out(vertex_count, 0), open_in(vertex_count, 0);
+    for (size_t i = 0; i < index_count; i += 3)
+    {
+        const glm::vec3 p[3] = { VertexPosition(vertices, vertex_floats, indices[i]), VertexPosition(vertices, vertex_floats, indices[i + 1]),
+            VertexPosition(vertices, vertex_floats, indices[i + 2]) };
+        const glm::vec3 normal = glm::cross(p[1] - p[0], p[2] - p[0]);
+        const float length = glm::length(normal);
+        if (length == 0.0f)
+            continue;
+        const glm::vec3 unit_normal = normal / length;
+
+        for (int c = 0; c < 3; c++)
+            AddPlane(quadrics[position_ids[indices[i + c]]], unit_normal, p[c], 0.5 * length);
+
+        for (int c = 0; c < 3; c++)
+        {
+            const unsigned a = indices[i + c], b = indices[i + (c + 1) % 3];
+            if (HasEdge(adjacency, out_indices, b, a))
+                continue;
+            open_out[a]++;
+            open_in[b]++;
+
+            const glm::vec3 edge = p[(c + 1) % 3] - p[c];
+            const float edge_length = glm::length(edge);
+            if (edge_length == 0.0f)
+                continue;
+            const glm::vec3 edge_normal = glm::cross(edge, unit_normal) / edge_length;
+            AddPlane(quadrics[position_ids[a]], edge_normal, p[c], edge_weight * edge_length * edge_length);
+            AddPlane(quadrics[position_ids[b]], edge_normal, p[c], edge_weight * edge_length * edge_length);
+        }
+    }
+
+    std::vector<VertexKind> kinds(vertex_count, VertexKind::Locked);
+    for (size_t v = 0; v < vertex_count; v++)
+    {
+        const bool single_border = open_out[v] == 1 && open_in[v] == 1;
+        if (next_wedge[v] == v)
+        {
+            if (open_out[v] == 0 && open_in[v] == 0)
+                kinds[v] = VertexKind::Manifold;
+            else if (single_border)
+                kinds[v] = VertexKind::Border;
+        }
+        else
+        {
+            const unsigned other = next_wedge[v];
+            if (next_wedge[other] == v && single_border && open_out[other] == 1 && open_in[other] == 1)
+                kinds[v] = VertexKind::Seam;
+        }
+    }
+
+    // Each pass collapses the cheapest edges that do not touch each other, until there are few enough
+    // triangles or no edge can be collapsed
+    std::vector<unsigned> remap(vertex_count);
+    std::vector<bool> pass_locked(vertex_count);
+    std::vector<EdgeCollapse> collapses;
+    const double error_limit = double(max_error) * double(max_error);
+    double result_error = 0.0;
+    while (index_count > target_index_count)
+    {
+        collapses.clear();
+        for (size_t i = 0; i < index_count; i += 3)
+        {
+            for (int c = 0; c < 3; c++)
+            {
+                const unsigned a = out_indices[i + c], b = out_indices[i + (c + 1) % 3];
+
+                // An inner edge is in two triangles, it is enough to take it once
+                if (a > b && HasEdge(adjacency, out_indices, b, a))
+                    continue;
+
+                // Edges of zero length connect the sides of a seam, they must stay
+                if (position_ids[a] == position_ids[b])
+                    continue;
+
+                const glm::vec3 pa = VertexPosition(vertices, vertex_floats, a), pb = VertexPosition(vertices, vertex_floats, b);
+                if (kinds[a] != VertexKind::Locked)
+                {
+                    EdgeCollapse collapse = { a, b, QuadricError(quadrics[position_ids[a]], pb) };
+                    collapses.push_back(collapse);
+                }
+                if (kinds[b] != VertexKind::Locked)
+                {
+                    EdgeCollapse collapse = { b, a, QuadricError(quadrics[position_ids[b]], pa) };
+                    collapses.push_back(collapse);
+                }
+            }
+        }
+        std::sort(collapses.begin(), collapses.end(), [](const EdgeCollapse &a, const EdgeCollapse &b) { return a.Error < b.Error; });
+
+        // A collapse removes about two triangles
+        const size_t collapse_goal = (index_count - target_index_count) / 6 + 1;
+        size_t collapsed = 0;
+        for (size_t v = 0; v < vertex_count; v++)
+            remap[v] = unsigned(v);
+        std::fill(pass_locked.begin(), pass_locked.end(), false);
+
+        for (const EdgeCollapse &collapse : collapses)
+        {
+            if (collapsed >= collapse_goal || collapse.Error > error_limit)
+                break;
+
+            const unsigned u = collapse.From, v = collapse.To;
+            if (pass_locked[position_ids[u]] || pass_locked[position_ids[v]])
+                continue;
+
+            // The second wedge of a seam vertex must move along the other side of the seam
+            unsigned u2 = u, v2 = v;
+            const VertexKind kind = kinds[u];
+            if (kind == VertexKind::Border || kind == VertexKind::Seam)
+            {
+                if (!IsOpenEdge(adjacency, out_indices, u, v))
+                    continue;
+            }
+            if (kind == VertexKind::Seam)
+            {
+                u2 = next_wedge[u];
+                v2 = next_wedge[v];
+                while (v2 != v && !IsOpenEdge(adjacency, out_indices, u2, v2))
+                    v2 = next_wedge[v2];
+                if (!IsOpenEdge(adjacency, out_indices, u2, v2))
+                    continue;
+            }
+
+            if (FlipsTriangles(adjacency, out_indices, vertices, vertex_floats, position_ids, u, v) ||
+                    (u2 != u && FlipsTriangles(adjacency, out_indices, vertices, vertex_floats, position_ids, u2, v2)))
+                continue;
+
+            remap[u] = v;
+            remap[u2] = v2;
+            AddQuadric(quadrics[position_ids[v]], quadrics[position_ids[u]]);
+            result_error = std::max(result_error, collapse.Error);
+            collapsed++;
+
+            // No other collapse in this pass may change the triangles around, their flip test would be wrong
+            for (unsigned w : { u, u2 })
+            {
+                for (unsigned i = adjacency.Offsets[w]; i < adjacency.Offsets[w + 1]; i++)
+                {
+                    const unsigned int *triangle = out_indices + adjacency.Triangles[i] * 3;
+                    for (int c = 0; c < 3; c++)
+                        pass_locked[position_ids[triangle[c]]] = true;
+                }
+            }
+        }
+        if (collapsed == 0)
+            break;
+
+        // Remove the triangles that collapsed into lines
+        size_t write = 0;
+        for (size_t i = 0; i < index_count; i += 3)
+        {
+            const unsigned a = remap[out_indices[i]], b = remap[out_indices[i + 1]], c = remap[out_indices[i + 2]];
+            if (a != b && b != c && c != a)
+            {
+                out_indices[write++] = a;
+                out_indices[write++] = b;
+                out_indices[write++] = c;
+            }
+        }
+        index_count = write;
+        adjacency.Build(out_indices, index_count, vertex_count);
+    }
+
+    if (out_error)
+        *out_error = float(std::sqrt(result_error));
+    return index_count;
+}
+
+void BuildMeshlets(unsigned int *indices, size_t index_count, const float *vertices, size_t vertex_count, size_t vertex_floats,
+        std::vector<Meshlet> &out_meshlets, size_t max_vertices, size_t max_triangles)
+{
+    out_meshlets.clear();
+    const size_t triangle_count = index_count / 3;
+    for (size_t i = 0; i < triangle_count * 3; i++)
+    {
+        if (indices[i] >= vertex_count)
+            return;        // Invalid input, leave it as it is
+    }
+
+    VertexTriangles adjacency;
+    adjacency.Build(indices, triangle_count * 3, vertex_count);
+
+    // Unit normals of the triangles, zero for degenerate ones
+    std::vector<glm::vec3> normals(triangle_count);
+    for (size_t t = 0; t < triangle_count; t++)
+    {
+        const glm::vec3 a = VertexPosition(vertices, vertex_floats, indices[t * 3 + 0]);
+        const glm::vec3 b = VertexPosition(vertices, vertex_floats, indices[t * 3 + 1]);
+        const glm::vec3 c = VertexPosition(vertices, vertex_floats, indices[t * 3 + 2]);
+        const glm::vec3 normal = glm::cross(b - a, c - a);
+        const float length = glm::length(normal);
+        normals[t] = (length > 0.0f) ? normal / length : glm::vec3(0.0f);
+    }
+
+    std::vector<unsigned int> output;
+    output.reserve(triangle_count * 3);
+    std::vector<char> emitted(triangle_count, 0);
+    std::vector<size_t> meshlet_of_vertex(vertex_count, size_t(-1));
+    std::vector<unsigned> meshlet_vertices;
+    std::vector<unsigned> meshlet_local_indices;
+    size_t cursor = 0;
+    while (true)
+    {
+        while (cursor < triangle_count && emitted[cursor])
+            cursor++;
+        if (cursor == triangle_count)
+            break;
+
+        const size_t meshlet_id = out_meshlets.size();
+        const size_t first_index = output.size();
+        meshlet_vertices.clear();
+        glm::vec3 normal_sum(0.0f);
+
+        size_t triangle = cursor;
+        size_t triangles = 0;
+        while (true)
+        {
+            emitted[triangle] = 1;
+            triangles++;
+            normal_sum += normals[triangle];
+            for (int c = 0; c < 3; c++)
+            {
+                const unsigned v = indices[triangle * 3 + c];
+                output.push_back(v);
+                if (meshlet_of_vertex[v] != meshlet_id)
+                {
+                    meshlet_of_vertex[v] = meshlet_id;
+                    meshlet_vertices.push_back(v);
+                }
+            }
+            if (triangles == max_triangles)
+                break;
+
+            // The next triangle is a neighbour that fits, with the fewest new vertices and the normal
+            // closest to the average so far
+            size_t best = size_t(-1);
+            int best_new = 3;
+            float best_dot = -2.0f;
+            for (unsigned v : meshlet_vertices)
+            {
+                for (unsigned k = adjacency.Offsets[v]; k < adjacency.Offsets[v + 1]; k++)
+                {
+                    const unsigned t = adjacency.Triangles[k];
+                    if (emitted[t])
+                        continue;
+
+                    int new_vertices = 0;
+                    for (int c = 0; c < 3; c++)
+                        new_vertices += (meshlet_of_vertex[indices[t * 3 + c]] != meshlet_id) ? 1 : 0;
+                    if (meshlet_vertices.size() + new_vertices > max_vertices)
+                        continue;
+
+                    const float dot = glm::dot(normals[t], normal_sum);
+                    if (new_vertices < best_new || (new_vertices == best_new && dot > best_dot))
+                    {
+                        best = t;
+                        best_new = new_vertices;
+                        best_dot = dot;
+                    }
+                }
+            }
+            if (best == size_t(-1))
+                break;
+            triangle = best;
+        }
+
+        // The growth order follows the adjacency, not the cache, reorder the triangles of the meshlet with
+        // its vertices numbered locally, so that the optimizer only needs tables of the meshlet size
+        std::vector<unsigned> &local = meshlet_local_indices;
+        local.resize(output.size() - first_index);
+        for (size_t i = 0; i < local.size(); i++)
+            local[i] = unsigned(std::find(meshlet_vertices.begin(), meshlet_vertices.end(), output[first_index + i]) - meshlet_vertices.begin());
+        OptimizeVertexCache(local.data(), local.size(), meshlet_vertices.size());
+        for (size_t i = 0; i < local.size(); i++)
+            output[first_index + i] = meshlet_vertices[local[i]];
+
+        // Bounding sphere around the center of the bounding box, usually tight enough for clusters
+        glm::vec3 bounds_min = VertexPosition(vertices, vertex_floats, meshlet_vertices[0]);
+        glm::vec3 bounds_max = bounds_min;
+        for (unsigned v : meshlet_vertices)
+        {
+            bounds_min = glm::min(bounds_min, VertexPosition(vertices, vertex_floats, v));
+            bounds_max = glm::max(bounds_max, VertexPosition(vertices, vertex_floats, v));
+        }
+        const glm::vec3 center = (bounds_min + bounds_max) * 0.5f;
+        float radius = 0.0f;
+        for (unsigned v : meshlet_vertices)
+            radius = std::max(radius, glm::length(VertexPosition(vertices, vertex_floats, v) - center));
+
+        // The cone of normals around their average, unusable once the normals spread over a half-space
+        const float sum_length = glm::length(normal_sum);
+        const glm::vec3 axis = (sum_length > 0.0f) ? normal_sum / sum_length : glm::vec3(0.0f);
+        float min_dot = (sum_length > 0.0f) ? 1.0f : -1.0f;
+        // Degenerate triangles produce no fragments, they do not limit the cone
+        for (size_t i = first_index; i < output.size(); i += 3)
+        {
+            const glm::vec3 a = VertexPosition(vertices, vertex_floats, output[i]);
+            const glm::vec3 b = VertexPosition(vertices, vertex_floats, output[i + 1]);
+            const glm::vec3 c = VertexPosition(vertices, vertex_floats, output[i + 2]);
+            const glm::vec3 normal = glm::cross(b - a, c - a);
+            const float length = glm::length(normal);
+            if (length > 0.0f)
+                min_dot = std::min(min_dot, glm::dot(axis, normal / length));
+        }
+
+        Meshlet meshlet;
+        meshlet.FirstIndex = uint32_t(first_index);
+        meshlet.IndexCount = uint32_t(output.size() - first_index);
+        meshlet.Center[0] = center.x;
+        meshlet.Center[1] = center.y;
+        meshlet.Center[2] = center.z;
+        meshlet.Radius = radius;
+        meshlet.ConeAxis[0] = axis.x;
+        meshlet.ConeAxis[1] = axis.y;
+        meshlet.ConeAxis[2] = axis.z;
+        meshlet.ConeCutoff = (min_dot > 0.0f) ? std::sqrt(1.0f - min_dot * min_dot) : 1.0f;
+        out_meshlets.push_back(meshlet);
+    }
+
+    std::copy(output.begin(), output.end(), indices);
+}
+
+bool MeshletFacesAway(const Meshlet &meshlet, const glm::vec3 &eye_position)
+{
+    // All normals are within the angle asin(cutoff) from the axis. The triangles face away if every
+    // direction from the eye to the sphere is within 90 degrees minus that angle from the axis.
+    const glm::vec3 center(meshlet.Center[0], meshlet.Center[1], meshlet.Center[2]);
+    const glm::vec3 axis(meshlet.ConeAxis[0], meshlet.ConeAxis[1], meshlet.ConeAxis[2]);
+    const glm::vec3 view = center - eye_position;
+    return glm::dot(view, axis) >= meshlet.ConeCutoff * glm::length(view) + meshlet.Radius;
+}
+
+bool IsMeshClosed(const unsigned int *indices, size_t index_count, const float *vertices, size_t vertex_count, size_t vertex_floats)
+{
+    index_count -= index_count % 3;
+    for (size_t i = 0; i < index_count; i++)
+    {
+        if (indices[i] >= vertex_count)
+            return false;
+    }
+
+    // The triangles between the positions, the seams of the normals and texture coordinates are not holes
+    std::vector<unsigned> position_ids, next_wedge;
+    LinkWedges(vertices, vertex_count, vertex_floats, position_ids, next_wedge);
+    std::vector<unsigned int> corners(index_count);
+    for (size_t i = 0; i < index_count; i++)
+        corners[i] = position_ids[indices[i]];
+
+    VertexTriangles adjacency;
+    adjacency.Build(corners.data(), index_count, vertex_count);
+    for (size_t i = 0; i < index_count; i += 3)
+    {
+        for (int c = 0; c < 3; c++)
+        {
+            const unsigned a = corners[i + c], b = corners[i + (c + 1) % 3];
+            if (a != b && !HasEdge(adjacency, corners.data(), b, a))
+                return false;
+        }
+    }
+    return true;
+}
+
+VertexFetchStats AnalyzeVertexFetch(const unsigned int *indices, size_t index_count, size_t vertex_count,
+        const size_t *stream_strides, size_t stream_count, unsigned cache_size)
+{
+    const size_t line_size = 64;
+    const size_t line_count = 16 * 1024 / line_size;
+
+    // Each stream is a separate buffer, they start at page boundaries
+    std::vector<size_t> stream_bases(stream_count);
+    size_t buffer_bytes = 0;
+    size_t next_base = 0;
+    for (size_t s = 0; s < stream_count; s++)
+    {
+        stream_bases[s] = next_base;
+        buffer_bytes += stream_strides[s] * vertex_count;
+        next_base += (stream_strides[s] * vertex_count + 4095) / 4096 * 4096;
+    }
+
+    // Direct-mapped cache, each entry holds the address of its line plus one (0 means empty)
+    std::vector<size_t> lines(line_count, 0);
+    std::vector<size_t> cached_at(vertex_count, 0);
+    size_t transformed = 0;
+    size_t lines_fetched = 0;
+    for (size_t i = 0; i < index_count; i++)
+    {
+        const unsigned v = indices[i];
+        if (v >= vertex_count)
+            continue;
+
+        // Only vertices that are not in the post-transform cache are fetched
+        if (cached_at[v] != 0 && transformed + 1 - cached_at[v] <= cache_size)
+            continue;
+        transformed++;
+        cached_at[v] = transformed;
+
+        for (size_t s = 0; s < stream_count; s++)
+        {
+            const size_t first = stream_bases[s] + v * stream_strides[s];
+            const size_t last = first + stream_strides[s] - 1;
+            for (size_t line = first / line_size; line <= last / line_size; line++)
+            {
+                size_t &entry = lines[line % line_count];
+                if (entry != line + 1)
+                {
+                    entry = line + 1;
+                    lines_fetched++;
+                }
+            }
+        }
+    }
+
+    VertexFetchStats stats;
+    stats.BytesFetched = lines_fetched * line_size;
+    stats.Overfetch = buffer_bytes ? float(double(stats.BytesFetched) / double(buffer_bytes)) : 0.0f;
+    return stats;
+}
+
+void PackVertices(const float *vertices, size_t vertex_count, PackedVertex *out_vertices)
+{
+    for (size_t i = 0; i < vertex_count; i++)
+    {
+        const float *vertex = vertices + i * 8;
+        PackedVertex &packed = out_vertices[i];
+        packed.Position[0] = vertex[0];
+        packed.Position[1] = vertex[1];
+        packed.Position[2] = vertex[2];
+        packed.Normal = PackNormal(vertex[3], vertex[4], vertex[5]);
+        packed.TexCoord[0] = FloatToHalf(vertex[6]);
+        packed.TexCoord[1] = FloatToHalf(vertex[7]);
+    }
+}
+
+void QuantizeVertices(const float *vertices, size_t vertex_count, const glm::vec3 &bounds_min, const glm::vec3 &bounds_max,
+        QuantizedVertex *out_vertices)
+{
+    // An axis on which the mesh is flat gets all zeros
+    const glm::vec3 extent = bounds_max - bounds_min;
+    float scale[3];
+    for (int axis = 0; axis < 3; axis++)
+        scale[axis] = (extent[axis] > 0.0f) ? 65535.0f / extent[axis] : 0.0f;
+
+    for (size_t i = 0; i < vertex_count; i++)
+    {
+        const float *vertex = vertices + i * 8;
+        QuantizedVertex &quantized = out_vertices[i];
+        for (int axis = 0; axis < 3; axis++)
+        {
+            const float value = (vertex[axis] - bounds_min[axis]) * scale[axis];
+            quantized.Position[axis] = uint16_t(std::max(0.0f, std::min(65535.0f, std::floor(value + 0.5f))));
+        }
+        quantized.Position[3] = 0;
+        EncodeOctahedral(vertex[3], vertex[4], vertex[5], quantized.Normal);
+        quantized.TexCoord[0] = FloatToHalf(vertex[6]);
+        quantized.TexCoord[1] = FloatToHalf(vertex[7]);
+    }
+}
+
+void EncodeOctahedral(float x, float y, float z, int16_t out_encoded[2])
+{
+    const float length = std::fabs(x) + std::fabs(y) + std::fabs(z);
+    if (!(length > 0.0f))
+    {
+        out_encoded[0] = 0;
+        out_encoded[1] = 0;
+        return;
+    }
+
+    float u = x / length, v = y / length;
+    if (z < 0.0f)
+    {
+        const float folded_u = (1.0f - std::fabs(v)) * (u >= 0.0f ? 1.0f : -1.0f);
+        const float folded_v = (1.0f - std::fabs(u)) * (v >= 0.0f ? 1.0f : -1.0f);
+        u = folded_u;
+        v = folded_v;
+    }
+    out_encoded[0] = int16_t(std::floor(std::max(-1.0f, std::min(1.0f, u)) * 32767.0f + 0.5f));
+    out_encoded[1] = int16_t(std::floor(std::max(-1.0f, std::min(1.0f, v)) * 32767.0f + 0.5f));
+}
+
+glm::vec3 DecodeOctahedral(const int16_t encoded[2])
+{
+    // Normalized GL_SHORT, -32768 maps to -1 as well
+    const float u = std::max(-1.0f, float(encoded[0]) / 32767.0f);
+    const float v = std::max(-1.0f, float(encoded[1]) / 32767.0f);
+
+    glm::vec3 normal(u, v, 1.0f - std::fabs(u) - std::fabs(v));
+    const float t = std::max(-normal.z, 0.0f);
+    normal.x += (normal.x >= 0.0f) ? -t : t;
+    normal.y += (normal.y >= 0.0f) ? -t : t;
+    return glm::normalize(normal);
+}
+
+uint16_t FloatToHalf(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    const uint32_t sign = (bits >> 16) & 0x8000u;
+    const uint32_t exponent = (bits >> 23) & 0xFFu;
+    uint32_t mantissa = bits & 0x7FFFFFu;
+
+    // Infinity and NaN (the NaN stays a NaN)
+    if (exponent == 0xFFu)
+        return uint16_t(sign | 0x7C00u | (mantissa ? 0x200u : 0u));
+
+    // Too large values become infinity
+    const int half_exponent = int(exponent) - 127 + 15;
+    if (half_exponent >= 31)
+        return uint16_t(sign | 0x7C00u);
+
+    // Small values become subnormal halves or zero, the implicit leading bit must be shifted in too
+    uint32_t shift = 13;
+    if (half_exponent <= 0)
+    {
+        if (half_exponent < -10)
+            return uint16_t(sign);
+        mantissa |= 0x800000u;
+        shift = uint32_t(14 - half_exponent);
+    }
+
+    // Round to nearest, ties to even. A carry out of the mantissa correctly increments the exponent.
+    uint32_t half = (half_exponent > 0 ? (uint32_t(half_exponent) << 10) : 0u) + (mantissa >> shift);
+    const uint32_t remainder = mantissa & ((1u << shift) - 1);
+    const uint32_t halfway = 1u << (shift - 1);
+    if (remainder > halfway || (remainder == halfway && (half & 1u)))
+        half++;
+    return uint16_t(sign | half);
+}
+
+float HalfToFloat(uint16_t value)
+{
+    const uint32_t sign = uint32_t(value & 0x8000u) << 16;
+    const uint32_t exponent = (value >> 10) & 0x1Fu;
+    const uint32_t mantissa = value & 0x3FFu;
+
+    float result;
+    if (exponent == 0)
+    {
+        // Zero or subnormal, the value is mantissa * 2^-24 exactly
+        result = std::ldexp(float(mantissa), -24);
+        return sign ? -result : result;
+    }
+
+    uint32_t bits;
+    if (exponent == 31)
+        bits = sign | 0x7F800000u | (mantissa << 13);
+    else
+        bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+    memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+uint32_t PackNormal(float x, float y, float z)
+{
+    const float components[3] = { x, y, z };
+    uint32_t packed = 0;
+    for (int i = 0; i < 3; i++)
+    {
+        const float clamped = std::max(-1.0f, std::min(1.0f, components[i]));
+        const int value = int(std::floor(clamped * 511.0f + 0.5f));
+        packed |= (uint32_t(value) & 0x3FFu) << (10 * i);
+    }
+    return packed;
+}
+
+}
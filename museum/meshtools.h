@@ -0,0 +1,196 @@
+#pragma once
+#ifndef INCLUDED_MESHTOOLS_H
+#define INCLUDED_MESHTOOLS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace PV112
+{
+
+/// How well an indexed triangle list uses the post-transform vertex cache of the GPU.
+struct VertexCacheStats
+{
+    // Number of vertices the vertex shader processes (the cache misses)
+    size_t Transformed;
+    // Average cache miss ratio, the number of transformed vertices per triangle (0.5 to 3)
+    float ACMR;
+    // Average transform to vertex ratio, the number of transformed vertices per unique vertex (1 or more)
+    float ATVR;
+};
+
+/// Simulates a FIFO post-transform vertex cache with 'cache_size' entries while drawing 'indices' with
+/// GL_TRIANGLES. The real caches differ between GPUs, this is only an estimate of the vertex shader
+/// invocations.
+VertexCacheStats AnalyzeVertexCache(const unsigned int *indices, size_t index_count, size_t vertex_count, unsigned cache_size = 16);
+
+/// Converts a triangle strip to a list of triangles with the same winding (use GL_TRIANGLES). The
+/// degenerate triangles that join several strips into one are dropped.
+void TriangleStripToList(const unsigned int *strip, size_t strip_count, std::vector<unsigned int> &out_indices);
+
+/// Reorders the triangles of an indexed triangle list so that the vertices are reused from the
+/// post-transform cache as much as possible, which lowers the number of vertex shader invocations.
+/// The vertices are not changed, and the order of the vertices in each triangle (its winding) is kept.
+/// If the triangles are already in a better order (see AnalyzeVertexCache), they are left as they are.
+///
+/// This is the Tipsify algorithm (Sander, Nehab, Barczak: Fast Triangle Reordering for Vertex Locality
+/// and Reduced Overdraw, 2007). It runs in linear time and works well for any cache of at least
+/// 'cache_size' entries.
+void OptimizeVertexCache(unsigned int *indices, size_t index_count, size_t vertex_count, unsigned cache_size = 16);
+
+/// Reorders the clusters of triangles of a list optimized by OptimizeVertexCache so that the parts of
+/// the mesh that are likely to hide other parts are drawn first, and the depth test rejects more fragments
+/// before the fragment shader runs. 'vertices' contains 'vertex_count' vertices of 'vertex_floats' floats,
+/// the first three are the position.
+///
+/// The triangles are split where the cache order starts a new patch, and further wherever the cache
+/// efficiency of a cluster so far reaches 'threshold' times that of its whole patch, so the vertex cache
+/// efficiency gets worse by at most this factor. The clusters are then sorted outward from the centroid
+/// of the mesh: those far from it and facing away from it first (Sander, Nehab, Barczak 2007).
+void OptimizeOverdraw(unsigned int *indices, size_t index_count, const float *vertices, size_t vertex_count, size_t vertex_floats,
+        float threshold = 1.05f, unsigned cache_size = 16);
+
+/// How many fragments are shaded when drawing a mesh with the depth test enabled.
+struct OverdrawStats
+{
+    // Pixels covered by the mesh
+    size_t Covered;
+    // Fragments that passed the depth test when they were drawn, i.e. ran the fragment shader
+    size_t Shaded;
+    // Shaded fragments per covered pixel, 1 means no fragment was shaded in vain
+    float Overdraw;
+};
+
+/// Estimates the overdraw of a mesh by rasterizing it, in the order of 'indices' and without face culling,
+/// from the six axis directions into 256x256 depth buffers. 'vertices' are as in OptimizeOverdraw.
+OverdrawStats AnalyzeOverdraw(const unsigned int *indices, size_t index_count, const float *vertices, size_t vertex_count, size_t vertex_floats);
+
+/// Reorders the vertices of an indexed mesh into the order in which the indices first use them, so that
+/// the GPU reads the vertex buffer mostly sequentially, and updates the indices. Vertices that are not
+/// used at all are dropped. 'vertices' has 'vertex_count' vertices of 'vertex_floats' floats.
+///
+/// Returns the new number of vertices, they are at the beginning of 'vertices'.
+size_t OptimizeVertexFetch(unsigned int *indices, size_t index_count, float *vertices, size_t vertex_count, size_t vertex_floats);
+
+/// Simplifies a triangle mesh by collapsing its edges in the order of the quadric error metric (Garland,
+/// Heckbert 1997), until it has at most 'target_index_count' indices, or no edge can be collapsed without
+/// moving the surface by more than 'max_error' (in the units of the positions). The
+/// vertices are not changed, the simplified triangles use a subset of them. 'vertices' are as in
+/// OptimizeOverdraw, 'out_indices' must have room for 'index_count' indices.
+///
+/// Vertices at the same position with different normals or texture coordinates form a seam. Both sides of
+/// the seam move together and only along it, so the seam stays closed and its attributes do not bleed
+/// across. Vertices on open borders slide only along the border, and more complicated vertices are kept.
+///
+/// Returns the number of indices of the simplified mesh. 'out_error', if not null, receives the largest
+/// distance between the simplified and the original surface, estimated by the quadrics, in the units of
+/// the positions.
+size_t SimplifyMesh(unsigned int *out_indices, const unsigned int *indices, size_t index_count, const float *vertices, size_t vertex_count,
+        size_t vertex_floats, size_t target_index_count, float max_error, float *out_error = nullptr);
+
+/// A cluster of nearby triangles of a mesh with similar orientation, a contiguous range of its indices.
+/// The bounds allow skipping whole clusters that are outside the view or that face away from the eye.
+struct Meshlet
+{
+    uint32_t FirstIndex;
+    uint32_t IndexCount;
+    // Sphere around all vertices of the cluster
+    float Center[3];
+    float Radius;
+    // All triangle normals are within the cone around ConeAxis whose half angle has the sine ConeCutoff,
+    // 1 if the normals are too spread for the cone to be useful
+    float ConeAxis[3];
+    float ConeCutoff;
+};
+
+/// Splits a triangle list into meshlets of at most 'max_vertices' distinct vertices and 'max_triangles'
+/// triangles, and reorders the triangles so that every meshlet is a contiguous range of 'indices'.
+/// 'vertices' are as in OptimizeOverdraw.
+///
+/// A meshlet starts with the first triangle (in the current order) that is not in any meshlet yet and
+/// grows over the neighbouring triangles, those that add the fewest new vertices and have the normal
+/// closest to that of the meshlet first. The order of the meshlets therefore follows the original order
+/// of the triangles, and the triangles of every meshlet are reordered for the vertex cache. The vertices
+/// on the borders between meshlets are transformed once per meshlet, so the cache efficiency is a bit
+/// lower than that of OptimizeVertexCache alone.
+void BuildMeshlets(unsigned int *indices, size_t index_count, const float *vertices, size_t vertex_count, size_t vertex_floats,
+        std::vector<Meshlet> &out_meshlets, size_t max_vertices = 64, size_t max_triangles = 124);
+
+/// Returns true if all triangles of the meshlet face away from 'eye_position' (in the same space as the
+/// vertices), so that none of them is visible when back faces are not drawn.
+bool MeshletFacesAway(const Meshlet &meshlet, const glm::vec3 &eye_position);
+
+/// Returns true if the triangles enclose a volume: every edge of a triangle is also an edge of a triangle
+/// on its other side, so back faces can be seen only from inside. Vertices at the same position are one
+/// corner, whatever their normals and texture coordinates. 'vertices' are as in OptimizeOverdraw.
+bool IsMeshClosed(const unsigned int *indices, size_t index_count, const float *vertices, size_t vertex_count, size_t vertex_floats);
+
+/// How much memory the GPU reads to fetch the attributes of the transformed vertices.
+struct VertexFetchStats
+{
+    // Bytes read from the vertex buffers, in whole cache lines
+    size_t BytesFetched;
+    // Bytes read per byte of the vertex buffers, 1 means every byte is read exactly once
+    float Overfetch;
+};
+
+/// Estimates the memory traffic of the vertex fetch when drawing 'indices' with GL_TRIANGLES. The vertex
+/// data is split into 'stream_count' buffers (one buffer per attribute, or a single interleaved one) with
+/// the given strides. Every vertex missed by the post-transform cache (see AnalyzeVertexCache) reads its
+/// bytes from all streams through a 16 KB direct-mapped cache with 64-byte lines.
+VertexFetchStats AnalyzeVertexFetch(const unsigned int *indices, size_t index_count, size_t vertex_count,
+        const size_t *stream_strides, size_t stream_count, unsigned cache_size = 16);
+
+/// Interleaved vertex with the attributes of the float layout (8 floats, 32 bytes) in 20 bytes. The
+/// position stays in floats, the normal is stored as normalized GL_INT_2_10_10_10_REV (the w component is
+/// 0), and the texture coordinate as two GL_HALF_FLOAT values.
+struct PackedVertex
+{
+    float Position[3];
+    uint32_t Normal;
+    uint16_t TexCoord[2];
+};
+
+/// Converts vertices of the interleaved float layout (position, normal, texture coordinate) to packed ones.
+void PackVertices(const float *vertices, size_t vertex_count, PackedVertex *out_vertices);
+
+/// Interleaved vertex with the attributes of the float layout in 16 bytes, for VertexLayout::Quantized.
+/// The position is stored as three GL_UNSIGNED_SHORT values normalized to the bounding box of the mesh
+/// (the fourth one only keeps the normal aligned), the normal in the octahedral encoding as two normalized
+/// GL_SHORT values, and the texture coordinate as two GL_HALF_FLOAT values.
+struct QuantizedVertex
+{
+    uint16_t Position[4];
+    int16_t Normal[2];
+    uint16_t TexCoord[2];
+};
+
+/// Converts vertices of the interleaved float layout to quantized ones. The positions are mapped from the
+/// box 'bounds_min', 'bounds_max', which must contain all of them, to [0, 65535]; the shader gets them back
+/// as bounds_min + position * (bounds_max - bounds_min).
+void QuantizeVertices(const float *vertices, size_t vertex_count, const glm::vec3 &bounds_min, const glm::vec3 &bounds_max,
+        QuantizedVertex *out_vertices);
+
+/// Stores a unit normal in the octahedral encoding (Meyer et al. 2010): the normal is projected on the
+/// octahedron |x| + |y| + |z| = 1, and its lower half is folded over the upper one into the square [-1, 1]^2.
+/// The two coordinates are stored as normalized 16-bit integers, the largest error is about 0.04 degrees.
+void EncodeOctahedral(float x, float y, float z, int16_t out_encoded[2]);
+
+/// Decodes a normal stored by EncodeOctahedral, the same way vertex.glsl does it.
+glm::vec3 DecodeOctahedral(const int16_t encoded[2]);
+
+/// Converts a float to the nearest IEEE 754 half-precision value (GL_HALF_FLOAT).
+uint16_t FloatToHalf(float value);
+
+/// Converts a half-precision value back to float, exactly.
+float HalfToFloat(uint16_t value);
+
+/// Stores a normal with components in [-1, 1] as GL_INT_2_10_10_10_REV, 10 signed bits per component.
+uint32_t PackNormal(float x, float y, float z);
+
+}
+
+#endif	// INCLUDED_MESHTOOLS_H
@@ -3,6 +3,7 @@
 #include "helpers.h"
 
 #include <iostream>
+#include <algorithm>
 #include "PV112.h"
 #define _USE_MATH_DEFINES
 #include <math.h>
@@ -16,6 +17,11 @@
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include "museumclock.h"
+#include "assetloader.h"
+#include "parallel.h"
+#include "geometryarena.h"
+#include "geometrypool.h"
+#include "texturestreamer.h"
 
 //irrKlang
 #include <irrKlang.h>
@@ -30,6 +36,33 @@ using namespace PV112;
 int win_width = 1024;
 int win_height = 768;
 
+// Vertical field of view of the camera in degrees
+const float field_of_view = 50.0f;
+
+// Staging buffers of the texture uploads, the workers of asset_loader write the pixels to them. The largest
+// compressed texture of the museum with its mips has 11 MB, larger textures are uploaded from memory. It is
+// declared before asset_loader, whose workers may wait for a buffer, it must be stopped before they are joined.
+TextureStreamer texture_streamer;
+const size_t texture_staging_buffer_count = 3;
+const size_t texture_staging_buffer_bytes = 16 * 1024 * 1024;
+
+// Loads the models and textures while the scene is already drawn. The textures are decoded in parallel,
+// one worker per core decodes them all in about the time of the largest one.
+AssetLoader asset_loader(WorkerThreadCount());
+// Time each frame may spend on creating OpenGL objects of the loaded assets, in seconds
+const double asset_upload_budget = 0.004;
+
+// Shared buffers of all geometries, those with the same vertex layout share also the VAO. The museum needs
+// about a quarter of this, a geometry that does not fit keeps its own buffers.
+GeometryArena geometry_arena;
+const size_t arena_vertex_bytes = 4 * 1024 * 1024;
+const size_t arena_index_count = 1024 * 1024;
+// Buffers and VAOs given back by the models that are unloaded, the models loaded next reuse them. Only the
+// models that do not fit in the arena take their buffers from the pool.
+GLObjectPool geometry_pool;
+// The VAO bound by bindGeometry
+GLuint bound_vao = 0;
+
 // Shader program and its uniforms
 GLuint program;
 
@@ -37,16 +70,18 @@ LocationStorage storage;
 
 PV112Geometry my_cube;
 PV112Geometry my_rectangle;
-PV112Geometry statue_of_liberty;
-PV112Geometry marble_statue;
-PV112Geometry cup;
-PV112Geometry clocks;
-PV112Geometry statue;
-PV112Geometry lion;
-PV112Geometry spotlight;
-PV112Geometry bear;
-PV112Geometry speaker;
-PV112Geometry lamp;
+// The models loaded by LoadOBJAsync, they are empty and my_cube stands in for them until they are uploaded
+// (see modelGeometry)
+GeometryHandle statue_of_liberty;
+GeometryHandle marble_statue;
+GeometryHandle cup;
+GeometryHandle clocks;
+GeometryHandle statue;
+GeometryHandle lion;
+GeometryHandle spotlight;
+GeometryHandle bear;
+GeometryHandle speaker;
+GeometryHandle lamp;
 PV112Geometry sphere;
 
 // Simple camera that allows us to look at the object from different views
@@ -55,13 +90,10 @@ PV112Camera my_camera;
 // OpenGL texture objects
 GLuint wall_tex;
 GLuint paving_tex;
-GLuint mona_lisa_tex;
+// The paintings are the layers of a single texture array, see PaintingLayer
+GLuint paintings_tex;
 GLuint painting_frame_tex;
 GLuint bronze_tex;
-GLuint night_watch_tex;
-GLuint school_of_athens_tex;
-GLuint fall_of_icarus_tex;
-GLuint water_lilies_tex;
 GLuint wood_tex;
 GLuint cup_tex;
 GLuint glass_tex;
@@ -72,6 +104,20 @@ GLuint spotlight_tex;
 GLuint speaker_tex;
 GLuint bear_tex;
 
+// Layers of paintings_tex, every painting is resized to painting_layer_size x painting_layer_size
+enum PaintingLayer {
+  mona_lisa_layer,
+  night_watch_layer,
+  school_of_athens_layer,
+  fall_of_icarus_layer,
+  water_lilies_layer,
+  painting_layer_count
+};
+const int painting_layer_size = 1024;
+
+// Size of the instance arrays of vertex.glsl, the most rectangles renderRectangles draws at once
+const int max_rectangle_instances = 8;
+
 // Current time of the application in seconds, for animations
 float app_time_s = 0.0f;
 
@@ -81,12 +127,29 @@ ISoundEngine* engine;
 ISound* music;
 glm::vec3 soundPosition = glm::vec3(0.0, 0.5, -size_vector.z / 2.0 + 0.5);
 
+// Called before the window and its OpenGL context are destroyed, when the window is closed or Escape is
+// pressed. The workers of asset_loader are stopped first, they must not wait for a staging buffer or still
+// write into one, then the models, the arena and the staging buffers are deleted while OpenGL still exists.
+// Nothing may be drawn afterwards.
+void releaseResources()
+{
+  texture_streamer.Stop();
+  asset_loader.Stop();
+  texture_streamer.Destroy();
+  GeometryHandle* models[] = { &statue_of_liberty, &marble_statue, &cup, &clocks, &statue, &lion, &spotlight, &bear, &speaker, &lamp };
+  for (GeometryHandle* model : models)
+    model->Reset();
+  geometry_arena.Destroy();
+  geometry_pool.Clear();
+}
+
 // Called when the user presses a key
 void key_pressed(unsigned char key, int mouseX, int mouseY)
 {
   switch (key)
   {
   case 27: // Escape
+      releaseResources();
       exit(0);
       break;
   case 'l':
@@ -152,6 +215,15 @@ void initVariables() {
   storage.setTexRepeatXLocation(glGetUniformLocation(program, "tex_repeat_factor_x"));
   storage.setTexRepeatYLocation(glGetUniformLocation(program, "tex_repeat_factor_y"));
   storage.setProceduralTexType(glGetUniformLocation(program, "procedural_tex_type"));
+  storage.setPositionScaleLocation(glGetUniformLocation(program, "position_scale"));
+  storage.setPositionOffsetLocation(glGetUniformLocation(program, "position_offset"));
+  storage.setOctahedralNormalLocation(glGetUniformLocation(program, "octahedral_normal"));
+  storage.setInstancedLocation(glGetUniformLocation(program, "instanced"));
+  storage.setPVMatrixLocation(glGetUniformLocation(program, "PV_matrix"));
+  storage.setInstanceModelMatricesLocation(glGetUniformLocation(program, "instance_model_matrices"));
+  storage.setInstanceLayersLocation(glGetUniformLocation(program, "instance_layers"));
+  storage.setMyTexArrayLocation(glGetUniformLocation(program, "my_tex_array"));
+  storage.setUseTexArrayLocation(glGetUniformLocation(program, "use_tex_array"));
 
   // spotlight
   storage.setSpotlightPositionLocation(glGetUniformLocation(program, "spotLight.position"));
@@ -178,6 +250,11 @@ void init()
       WaitForEnterAndExit();
 
   initVariables();
+  // The texture arrays are bound to unit 1, samplers of different types must never share a unit
+  glUseProgram(program);
+  glUniform1i(storage.getMyTexArrayLocation(), 1);
+  glUseProgram(0);
+
   glm::vec2 bottom(-size_vector.x / 2.0 + size_vector.x / 4.0, -size_vector.z / 2.0 + size_vector.z / 8.0);
   glm::vec2 top(size_vector.x / 2.0 - size_vector.x / 4.0, size_vector.z / 2.0 - size_vector.z / 12.0);
   my_camera.setBarrier(bottom,top);
@@ -185,38 +262,51 @@ void init()
   int normal_loc = glGetAttribLocation(program, "normal");
   int tex_coord_loc = glGetAttribLocation(program, "tex_coord");
 
+  geometry_arena.Create(arena_vertex_bytes, arena_index_count, position_loc, normal_loc, tex_coord_loc);
   my_cube = CreateCube(position_loc, normal_loc, tex_coord_loc);
   my_rectangle = CreateRectangle(position_loc, normal_loc, tex_coord_loc);
-  statue_of_liberty = LoadOBJ("./obj_files/statue_of_liberty.obj", position_loc, normal_loc, tex_coord_loc);
-  marble_statue = LoadOBJ("./obj_files/marble_statue.obj", position_loc, normal_loc, tex_coord_loc);
-  cup = LoadOBJ("./obj_files/cup.obj", position_loc, normal_loc, tex_coord_loc);
-  clocks = LoadOBJ("./obj_files/clocks.obj", position_loc, normal_loc, tex_coord_loc);
-  statue = LoadOBJ("./obj_files/statue.obj", position_loc, normal_loc, tex_coord_loc);
-  lion = LoadOBJ("./obj_files/lion.obj", position_loc, normal_loc, tex_coord_loc);
-  spotlight = LoadOBJ("./obj_files/spotlight.obj", position_loc, normal_loc, tex_coord_loc);
-  bear = LoadOBJ("./obj_files/bear.obj", position_loc, normal_loc, tex_coord_loc);
-  speaker = LoadOBJ("./obj_files/speaker.obj", position_loc, normal_loc, tex_coord_loc);
-  lamp = LoadOBJ("./obj_files/flat_light.obj", position_loc, normal_loc, tex_coord_loc);
-  sphere = CreateSphere(position_loc, normal_loc, tex_coord_loc);
-
-  wall_tex = CreateAndLoadTexture(MAYBEWIDE("./textures/wall.jpg"));
-  paving_tex = CreateAndLoadTexture(MAYBEWIDE("./textures/paving.jpg"));
-  mona_lisa_tex = CreateAndLoadTexture(MAYBEWIDE("./textures/mona_lisa.jpg"));
-  painting_frame_tex = CreateAndLoadTexture(MAYBEWIDE("./textures/painting_frame.png"));
-  bronze_tex = CreateAndLoadTexture(MAYBEWIDE("./textures/bronze.jpg"));
-  night_watch_tex = CreateAndLoadTexture(MAYBEWIDE("./textures/night_watch_rembrandt.jpg"));
-  school_of_athens_tex = CreateAndLoadTexture(MAYBEWIDE("./textures/school_of_athens_raphael.jpg"));
-  fall_of_icarus_tex = CreateAndLoadTexture(MAYBEWIDE("./textures/fall_of_icarus.jpg"));
-  water_lilies_tex = CreateAndLoadTexture(MAYBEWIDE("./textures/water_lilies.jpg"));
-  wood_tex = CreateAndLoadTexture(MAYBEWIDE("./textures/wood.jpg"));
-  cup_tex = CreateAndLoadTexture(MAYBEWIDE("./textures/cup_tex.jpg"));
-  glass_tex = CreateAndLoadTexture(MAYBEWIDE("./textures/glass2.png"));
-  door_tex = CreateAndLoadTexture(MAYBEWIDE("./textures/door.jpg"));
-  statue_tex = CreateAndLoadTexture(MAYBEWIDE("./textures/statue_tex.tga"));
-  ceiling_tex = CreateAndLoadTexture(MAYBEWIDE("./textures/ceiling.jpg"));
-  spotlight_tex = CreateAndLoadTexture(MAYBEWIDE("./textures/spotlight_texture.jpg"));
-  speaker_tex = CreateAndLoadTexture(MAYBEWIDE("./textures/speaker.jpg"));
-  bear_tex = CreateAndLoadTexture(MAYBEWIDE("./textures/bear_wood.jpg"));
+  geometry_arena.Add(my_cube);
+  geometry_arena.Add(my_rectangle);
+
+  // The models and textures load in the background, the cube and white textures stand in for them until
+  // they are uploaded (see render)
+  LoadOBJAsync(asset_loader, statue_of_liberty, "./obj_files/statue_of_liberty.obj", position_loc, normal_loc, tex_coord_loc, VertexLayout::Float, &geometry_pool, &geometry_arena);
+  LoadOBJAsync(asset_loader, marble_statue, "./obj_files/marble_statue.obj", position_loc, normal_loc, tex_coord_loc, VertexLayout::Quantized, &geometry_pool, &geometry_arena);
+  LoadOBJAsync(asset_loader, cup, "./obj_files/cup.obj", position_loc, normal_loc, tex_coord_loc, VertexLayout::Quantized, &geometry_pool, &geometry_arena);
+  LoadOBJAsync(asset_loader, clocks, "./obj_files/clocks.obj", position_loc, normal_loc, tex_coord_loc, VertexLayout::Float, &geometry_pool, &geometry_arena);
+  LoadOBJAsync(asset_loader, statue, "./obj_files/statue.obj", position_loc, normal_loc, tex_coord_loc, VertexLayout::Quantized, &geometry_pool, &geometry_arena);
+  LoadOBJAsync(asset_loader, lion, "./obj_files/lion.obj", position_loc, normal_loc, tex_coord_loc, VertexLayout::Quantized, &geometry_pool, &geometry_arena);
+  LoadOBJAsync(asset_loader, spotlight, "./obj_files/spotlight.obj", position_loc, normal_loc, tex_coord_loc, VertexLayout::Float, &geometry_pool, &geometry_arena);
+  LoadOBJAsync(asset_loader, bear, "./obj_files/bear.obj", position_loc, normal_loc, tex_coord_loc, VertexLayout::Quantized, &geometry_pool, &geometry_arena);
+  LoadOBJAsync(asset_loader, speaker, "./obj_files/speaker.obj", position_loc, normal_loc, tex_coord_loc, VertexLayout::Float, &geometry_pool, &geometry_arena);
+  LoadOBJAsync(asset_loader, lamp, "./obj_files/flat_light.obj", position_loc, normal_loc, tex_coord_loc, VertexLayout::Float, &geometry_pool, &geometry_arena);
+  sphere = CreateSphereLODs(position_loc, normal_loc, tex_coord_loc);
+  geometry_arena.Add(sphere);
+
+  texture_streamer.Create(texture_staging_buffer_count, texture_staging_buffer_bytes);
+  wall_tex = CreateAndLoadTextureAsync(asset_loader, MAYBEWIDE("./textures/wall.jpg"), &texture_streamer);
+  paving_tex = CreateAndLoadTextureAsync(asset_loader, MAYBEWIDE("./textures/paving.jpg"), &texture_streamer);
+  const maybewchar *painting_files[painting_layer_count] = {
+    MAYBEWIDE("./textures/mona_lisa.jpg"),
+    MAYBEWIDE("./textures/night_watch_rembrandt.jpg"),
+    MAYBEWIDE("./textures/school_of_athens_raphael.jpg"),
+    MAYBEWIDE("./textures/fall_of_icarus.jpg"),
+    MAYBEWIDE("./textures/water_lilies.jpg"),
+  };
+  paintings_tex = CreateAndLoadTextureArrayAsync(asset_loader,
+    std::vector<const maybewchar *>(painting_files, painting_files + painting_layer_count), painting_layer_size, painting_layer_size,
+    &texture_streamer);
+  painting_frame_tex = CreateAndLoadTextureAsync(asset_loader, MAYBEWIDE("./textures/painting_frame.png"), &texture_streamer);
+  bronze_tex = CreateAndLoadTextureAsync(asset_loader, MAYBEWIDE("./textures/bronze.jpg"), &texture_streamer);
+  wood_tex = CreateAndLoadTextureAsync(asset_loader, MAYBEWIDE("./textures/wood.jpg"), &texture_streamer);
+  cup_tex = CreateAndLoadTextureAsync(asset_loader, MAYBEWIDE("./textures/cup_tex.jpg"), &texture_streamer);
+  glass_tex = CreateAndLoadTextureAsync(asset_loader, MAYBEWIDE("./textures/glass2.png"), &texture_streamer);
+  door_tex = CreateAndLoadTextureAsync(asset_loader, MAYBEWIDE("./textures/door.jpg"), &texture_streamer);
+  statue_tex = CreateAndLoadTextureAsync(asset_loader, MAYBEWIDE("./textures/statue_tex.tga"), &texture_streamer);
+  ceiling_tex = CreateAndLoadTextureAsync(asset_loader, MAYBEWIDE("./textures/ceiling.jpg"), &texture_streamer);
+  spotlight_tex = CreateAndLoadTextureAsync(asset_loader, MAYBEWIDE("./textures/spotlight_texture.jpg"), &texture_streamer);
+  speaker_tex = CreateAndLoadTextureAsync(asset_loader, MAYBEWIDE("./textures/speaker.jpg"), &texture_streamer);
+  bear_tex = CreateAndLoadTextureAsync(asset_loader, MAYBEWIDE("./textures/bear_wood.jpg"), &texture_streamer);
 
   //irrklang
   engine= createIrrKlangDevice();
@@ -233,7 +323,6 @@ void init()
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
   glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, 8.0f);
-  glGenerateMipmap(GL_TEXTURE_2D);
   glBindTexture(GL_TEXTURE_2D, 0);
 
   glBindTexture(GL_TEXTURE_2D, paving_tex);
@@ -242,17 +331,15 @@ void init()
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
   glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, 8.0f);
-  glGenerateMipmap(GL_TEXTURE_2D);
   glBindTexture(GL_TEXTURE_2D, 0);
 
-  glBindTexture(GL_TEXTURE_2D, mona_lisa_tex);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-  glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, 8.0f);
-  glGenerateMipmap(GL_TEXTURE_2D);
-  glBindTexture(GL_TEXTURE_2D, 0);
+  glBindTexture(GL_TEXTURE_2D_ARRAY, paintings_tex);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glTexParameterf(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_ANISOTROPY_EXT, 8.0f);
+  glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
 
   glBindTexture(GL_TEXTURE_2D, painting_frame_tex);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
@@ -260,7 +347,6 @@ void init()
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
   glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, 8.0f);
-  glGenerateMipmap(GL_TEXTURE_2D);
   glBindTexture(GL_TEXTURE_2D, 0);
 
   glBindTexture(GL_TEXTURE_2D, bronze_tex);
@@ -269,43 +355,6 @@ void init()
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
   glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, 8.0f);
-  glGenerateMipmap(GL_TEXTURE_2D);
-  glBindTexture(GL_TEXTURE_2D, 0);
-
-  glBindTexture(GL_TEXTURE_2D, night_watch_tex);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-  glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, 8.0f);
-  glGenerateMipmap(GL_TEXTURE_2D);
-  glBindTexture(GL_TEXTURE_2D, 0);
-
-  glBindTexture(GL_TEXTURE_2D, school_of_athens_tex);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-  glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, 8.0f);
-  glGenerateMipmap(GL_TEXTURE_2D);
-  glBindTexture(GL_TEXTURE_2D, 0);
-
-  glBindTexture(GL_TEXTURE_2D, fall_of_icarus_tex);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-  glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, 8.0f);
-  glGenerateMipmap(GL_TEXTURE_2D);
-  glBindTexture(GL_TEXTURE_2D, 0);
-
-  glBindTexture(GL_TEXTURE_2D, water_lilies_tex);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-  glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, 8.0f);
-  glGenerateMipmap(GL_TEXTURE_2D);
   glBindTexture(GL_TEXTURE_2D, 0);
 
   glBindTexture(GL_TEXTURE_2D, wood_tex);
@@ -314,7 +363,6 @@ void init()
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
   glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, 8.0f);
-  glGenerateMipmap(GL_TEXTURE_2D);
   glBindTexture(GL_TEXTURE_2D, 0);
 
   glBindTexture(GL_TEXTURE_2D, cup_tex);
@@ -323,7 +371,6 @@ void init()
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
   glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, 8.0f);
-  glGenerateMipmap(GL_TEXTURE_2D);
   glBindTexture(GL_TEXTURE_2D, 0);
 
   glBindTexture(GL_TEXTURE_2D, glass_tex);
@@ -332,7 +379,6 @@ void init()
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
   glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, 8.0f);
-  glGenerateMipmap(GL_TEXTURE_2D);
   glBindTexture(GL_TEXTURE_2D, 0);
 
   glBindTexture(GL_TEXTURE_2D, door_tex);
@@ -341,7 +387,6 @@ void init()
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
   glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, 8.0f);
-  glGenerateMipmap(GL_TEXTURE_2D);
   glBindTexture(GL_TEXTURE_2D, 0);
 
   glBindTexture(GL_TEXTURE_2D, statue_tex);
@@ -350,7 +395,6 @@ void init()
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
   glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, 8.0f);
-  glGenerateMipmap(GL_TEXTURE_2D);
   glBindTexture(GL_TEXTURE_2D, 0);
 
   glBindTexture(GL_TEXTURE_2D, ceiling_tex);
@@ -359,7 +403,6 @@ void init()
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
   glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, 8.0f);
-  glGenerateMipmap(GL_TEXTURE_2D);
   glBindTexture(GL_TEXTURE_2D, 0);
 
   glBindTexture(GL_TEXTURE_2D, spotlight_tex);
@@ -368,7 +411,6 @@ void init()
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
   glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, 8.0f);
-  glGenerateMipmap(GL_TEXTURE_2D);
   glBindTexture(GL_TEXTURE_2D, 0);
 
   glBindTexture(GL_TEXTURE_2D, speaker_tex);
@@ -377,7 +419,6 @@ void init()
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
   glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, 8.0f);
-  glGenerateMipmap(GL_TEXTURE_2D);
   glBindTexture(GL_TEXTURE_2D, 0);
 
   glBindTexture(GL_TEXTURE_2D, bear_tex);
@@ -386,7 +427,6 @@ void init()
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
   glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, 8.0f);
-  glGenerateMipmap(GL_TEXTURE_2D);
   glBindTexture(GL_TEXTURE_2D, 0);
 }
 
@@ -403,16 +443,89 @@ const int& procedural_tex_type = 0) {
   glUniform1i(storage.getProceduralTexType(), procedural_tex_type);
 }
 
+void setVertexDecoding(const PV112Geometry& geometry) {
+  SetVertexDecodeUniforms(geometry, storage.getPositionScaleLocation(),
+    storage.getPositionOffsetLocation(), storage.getOctahedralNormalLocation());
+}
+
+// The coarsest level of detail of a geometry whose simplification is at most a pixel on the screen
+int selectLOD(const PV112Geometry& geometry, const glm::mat4& model_matrix) {
+  BoundingSphere bounds = TransformBoundingSphere(geometry.Sphere, model_matrix);
+  float distance = std::max(glm::length(bounds.Center - my_camera.getPosition()) - bounds.Radius, 0.0f);
+  float scale = glm::length(glm::vec3(model_matrix[0]));
+  float projection_height = win_height / (2.0f * tan(glm::radians(field_of_view) / 2.0f));
+  return SelectGeometryLOD(geometry, distance, scale, projection_height);
+}
+
+// Draws the level of detail of a geometry chosen by selectLOD.
+// The geometry may be quantized, the following draws get the decoding of unquantized geometries.
+void drawGeometryLOD(const PV112Geometry& geometry, const glm::mat4& model_matrix) {
+  setVertexDecoding(geometry);
+  DrawGeometry(geometry, selectLOD(geometry, model_matrix));
+  setVertexDecoding(PV112Geometry());
+}
+
+// Like drawGeometryLOD, but the meshlets of the full geometry that are out of the view or turned away from
+// the camera are skipped. The back faces of closed geometries are culled, those of open ones stay visible
+// through their openings.
+void drawGeometryMeshlets(const PV112Geometry& geometry, const glm::mat4& PV_matrix, const glm::mat4& model_matrix) {
+  int lod = selectLOD(geometry, model_matrix);
+  setVertexDecoding(geometry);
+  if (geometry.Closed)
+    glEnable(GL_CULL_FACE);
+  if (lod == 0) {
+    glm::vec3 eye = glm::vec3(glm::inverse(model_matrix) * glm::vec4(my_camera.getPosition(), 1.0f));
+    DrawGeometryMeshlets(geometry, PV_matrix * model_matrix, eye);
+  } else {
+    DrawGeometry(geometry, lod);
+  }
+  glDisable(GL_CULL_FACE);
+  setVertexDecoding(PV112Geometry());
+}
+
+// Binds the VAO of a geometry unless it is already bound, which is the case for most geometries in the arena
+void bindGeometry(const PV112Geometry& geometry) {
+  if (geometry.VAO != bound_vao) {
+    glBindVertexArray(geometry.VAO);
+    bound_vao = geometry.VAO;
+  }
+}
+
+// The geometry of a loaded model, or the cube while the model is loading
+const PV112Geometry& modelGeometry(const GeometryHandle& model) {
+  return model.Empty() ? my_cube : *model;
+}
+
 void renderRectangle(const glm::mat4& PV_matrix, const glm::mat4& model_matrix,
   float tex_repeat_factor_x, float tex_repeat_factor_y) {
-  glBindVertexArray(my_rectangle.VAO);
+  bindGeometry(my_rectangle);
   sendDataToShaders(PV_matrix, model_matrix, tex_repeat_factor_x, tex_repeat_factor_y);
   DrawGeometry(my_rectangle);
   //glBindVertexArray(0);
 }
 
+// Draws the rectangle once for every model matrix (at most max_rectangle_instances) in a single instanced
+// draw. With 'layers', every instance takes its layer of the texture array bound to unit 1, otherwise all
+// take the texture bound to unit 0.
+void renderRectangles(const glm::mat4& PV_matrix, const glm::mat4* model_matrices, const GLint* layers, int count) {
+  count = std::min(count, max_rectangle_instances);
+  bindGeometry(my_rectangle);
+  glUniform1i(storage.getInstancedLocation(), 1);
+  glUniformMatrix4fv(storage.getPVMatrixLocation(), 1, GL_FALSE, glm::value_ptr(PV_matrix));
+  glUniformMatrix4fv(storage.getInstanceModelMatricesLocation(), count, GL_FALSE, glm::value_ptr(model_matrices[0]));
+  glUniform1i(storage.getUseTexArrayLocation(), layers != nullptr ? 1 : 0);
+  if (layers != nullptr)
+    glUniform1iv(storage.getInstanceLayersLocation(), count, layers);
+  glUniform1f(storage.getTexRepeatXLocation(), 1.0);
+  glUniform1f(storage.getTexRepeatYLocation(), 1.0);
+  glUniform1i(storage.getProceduralTexType(), 0);
+  DrawGeometryInstanced(my_rectangle, count);
+  glUniform1i(storage.getUseTexArrayLocation(), 0);
+  glUniform1i(storage.getInstancedLocation(), 0);
+}
+
 void renderRoom(const glm::mat4& PV_matrix) {
-  glBindVertexArray(my_rectangle.VAO);
+  bindGeometry(my_rectangle);
   glActiveTexture(GL_TEXTURE0);
   glBindTexture(GL_TEXTURE_2D, wall_tex);
   glUniform1i(storage.getMyTex(), 0);
@@ -504,26 +617,27 @@ void renderLight(const glm::mat4& PV_matrix) {
   glBindTexture(GL_TEXTURE_2D, spotlight_tex);
   glUniform1i(storage.getMyTex(), 0);
 
-  glBindVertexArray(lamp.VAO);
+  bindGeometry(modelGeometry(lamp));
   glm::mat4 model_matrix = glm::mat4(1.0f);
   model_matrix = glm::translate(model_matrix, glm::vec3(0.0, size_vector.y * 2.0 - 0.11, 0.0));
   model_matrix = glm::scale(model_matrix, glm::vec3(0.3, 0.3, 0.3));
   sendDataToShaders(PV_matrix, model_matrix);
-  DrawGeometry(lamp);
+  DrawGeometry(modelGeometry(lamp));
 
-  glBindVertexArray(sphere.VAO);
+  bindGeometry(sphere);
   model_matrix = glm::mat4(1.0f);
   model_matrix = glm::translate(model_matrix, glm::vec3(0.0, size_vector.y * 2.0 + 1.84, 0.02));
   model_matrix = glm::scale(model_matrix, glm::vec3(2.0, 2.0, 2.0));
   sendDataToShaders(PV_matrix, model_matrix, 1.0, 1.0, 3);
-  DrawGeometry(sphere);
+  // The tessellation of the shade follows its size on the screen
+  DrawGeometry(sphere, selectLOD(sphere, model_matrix));
 }
 
 void renderPictures(const glm::mat4& PV_matrix) {
   const float spaceBetweenPaintings = size_vector.z / 5.0;
-  glActiveTexture(GL_TEXTURE0);
-  glBindTexture(GL_TEXTURE_2D, mona_lisa_tex);
-  glUniform1i(storage.getMyTex(), 0);
+  // All paintings are drawn first and then all frames, each with a single instanced draw
+  glm::mat4 painting_matrices[painting_layer_count];
+  glm::mat4 frame_matrices[painting_layer_count];
 
   float ratio = 4.0/3.0;
   float x_size = 1.8;
@@ -532,22 +646,14 @@ void renderPictures(const glm::mat4& PV_matrix) {
   glm::mat4 model_matrix = glm::mat4(1.0f);
   model_matrix = glm::translate(model_matrix, glm::vec3(0.0, size_vector.y, -size_vector.z / 2.0 + 0.1));
   model_matrix = glm::scale(model_matrix, glm::vec3(x_size, x_size * ratio,1.0));
-  renderRectangle(PV_matrix, model_matrix, 1.0, 1.0);
-
-  glActiveTexture(GL_TEXTURE0);
-  glBindTexture(GL_TEXTURE_2D, painting_frame_tex);
-  glUniform1i(storage.getMyTex(), 0);
+  painting_matrices[mona_lisa_layer] = model_matrix;
 
   float factor = 1.2;
   model_matrix = glm::mat4(1.0f);
   model_matrix = glm::rotate(model_matrix, static_cast<float>(glm::radians(90.0)), glm::vec3(0.0,0.0,1.0));
   model_matrix = glm::translate(model_matrix, glm::vec3(size_vector.y, 0.0, -size_vector.z / 2.0 + 0.2));
   model_matrix = glm::scale(model_matrix, glm::vec3(x_size * ratio * factor, x_size * factor,1.0));
-  renderRectangle(PV_matrix, model_matrix, 1.0, 1.0);
-
-  glActiveTexture(GL_TEXTURE0);
-  glBindTexture(GL_TEXTURE_2D, night_watch_tex);
-  glUniform1i(storage.getMyTex(), 0);
+  frame_matrices[mona_lisa_layer] = model_matrix;
 
   //night_watch
   ratio = 1.20251938;
@@ -556,78 +662,62 @@ void renderPictures(const glm::mat4& PV_matrix) {
   model_matrix = glm::rotate(model_matrix, static_cast<float>(glm::radians(-90.0)), glm::vec3(0.0, 1.0, 0.0));
   model_matrix = glm::translate(model_matrix, glm::vec3(-size_vector.z / 2.0 + x_size * 2.0 , size_vector.y, -size_vector.x / 2.0 + 0.1));
   model_matrix = glm::scale(model_matrix, glm::vec3(x_size, x_size / ratio,1.0));
-  renderRectangle(PV_matrix, model_matrix, 1.0, 1.0);
-
-  glActiveTexture(GL_TEXTURE0);
-  glBindTexture(GL_TEXTURE_2D, painting_frame_tex);
-  glUniform1i(storage.getMyTex(), 0);
+  painting_matrices[night_watch_layer] = model_matrix;
 
   factor = 1.3;
   model_matrix = glm::scale(model_matrix, glm::vec3(factor, factor*1.138 ,1.0));
-  renderRectangle(PV_matrix, model_matrix, 1.0, 1.0);
+  frame_matrices[night_watch_layer] = model_matrix;
 
   //school_of_athens
-  glActiveTexture(GL_TEXTURE0);
-  glBindTexture(GL_TEXTURE_2D, school_of_athens_tex);
-  glUniform1i(storage.getMyTex(), 0);
-
   ratio = 1.287605295;
   x_size = 2.6;
   model_matrix = glm::mat4(1.0f);
   model_matrix = glm::rotate(model_matrix, static_cast<float>(glm::radians(-90.0)), glm::vec3(0.0, 1.0, 0.0));
   model_matrix = glm::translate(model_matrix, glm::vec3(-size_vector.z / 2.0 + spaceBetweenPaintings * 2 , size_vector.y, -size_vector.x / 2.0 + 0.1));
   model_matrix = glm::scale(model_matrix, glm::vec3(x_size, x_size / ratio,1.0));
-  renderRectangle(PV_matrix, model_matrix, 1.0, 1.0);
-
-  glActiveTexture(GL_TEXTURE0);
-  glBindTexture(GL_TEXTURE_2D, painting_frame_tex);
-  glUniform1i(storage.getMyTex(), 0);
+  painting_matrices[school_of_athens_layer] = model_matrix;
 
   factor = 1.3;
   model_matrix = glm::scale(model_matrix, glm::vec3(factor*1.0005, factor*1.134*1.0005 ,1.0));
-  renderRectangle(PV_matrix, model_matrix, 1.0, 1.0);
+  frame_matrices[school_of_athens_layer] = model_matrix;
 
   //fall_of_icarus
-  glActiveTexture(GL_TEXTURE0);
-  glBindTexture(GL_TEXTURE_2D, fall_of_icarus_tex);
-  glUniform1i(storage.getMyTex(), 0);
-
   ratio = 1.516425756;
   x_size = 2.7;
   model_matrix = glm::mat4(1.0f);
   model_matrix = glm::rotate(model_matrix, static_cast<float>(glm::radians(-90.0)), glm::vec3(0.0, 1.0, 0.0));
   model_matrix = glm::translate(model_matrix, glm::vec3(-size_vector.z / 2.0 + spaceBetweenPaintings * 3.2 , size_vector.y, -size_vector.x / 2.0 + 0.1));
   model_matrix = glm::scale(model_matrix, glm::vec3(x_size, x_size / ratio,1.0));
-  renderRectangle(PV_matrix, model_matrix, 1.0, 1.0);
-
-  glActiveTexture(GL_TEXTURE0);
-  glBindTexture(GL_TEXTURE_2D, painting_frame_tex);
-  glUniform1i(storage.getMyTex(), 0);
+  painting_matrices[fall_of_icarus_layer] = model_matrix;
 
   factor = 1.3;
   model_matrix = glm::scale(model_matrix, glm::vec3(factor, factor*1.14 ,1.0));
-  renderRectangle(PV_matrix, model_matrix, 1.0, 1.0);
+  frame_matrices[fall_of_icarus_layer] = model_matrix;
 
   //water_lilies
-  glActiveTexture(GL_TEXTURE0);
-  glBindTexture(GL_TEXTURE_2D, water_lilies_tex);
-  glUniform1i(storage.getMyTex(), 0);
-
   ratio = 1.508503401;
   x_size = 2.7;
   model_matrix = glm::mat4(1.0f);
   model_matrix = glm::rotate(model_matrix, static_cast<float>(glm::radians(-90.0)), glm::vec3(0.0, 1.0, 0.0));
   model_matrix = glm::translate(model_matrix, glm::vec3(-size_vector.z / 2.0 + spaceBetweenPaintings * 4.35 , size_vector.y, -size_vector.x / 2.0 + 0.1));
   model_matrix = glm::scale(model_matrix, glm::vec3(x_size, x_size / ratio,1.0));
-  renderRectangle(PV_matrix, model_matrix, 1.0, 1.0);
+  painting_matrices[water_lilies_layer] = model_matrix;
+
+  factor = 1.3;
+  model_matrix = glm::scale(model_matrix, glm::vec3(factor, factor*1.14 ,1.0));
+  frame_matrices[water_lilies_layer] = model_matrix;
+
+  GLint layers[painting_layer_count];
+  for (int layer = 0; layer < painting_layer_count; layer++)
+    layers[layer] = layer;
+  glActiveTexture(GL_TEXTURE1);
+  glBindTexture(GL_TEXTURE_2D_ARRAY, paintings_tex);
+  renderRectangles(PV_matrix, painting_matrices, layers, painting_layer_count);
 
   glActiveTexture(GL_TEXTURE0);
   glBindTexture(GL_TEXTURE_2D, painting_frame_tex);
   glUniform1i(storage.getMyTex(), 0);
-
-  factor = 1.3;
-  model_matrix = glm::scale(model_matrix, glm::vec3(factor, factor*1.14 ,1.0));
-  renderRectangle(PV_matrix, model_matrix, 1.0, 1.0);
+  renderRectangles(PV_matrix, frame_matrices, nullptr, painting_layer_count);
 }
 
 void renderStatues(const glm::mat4& PV_matrix) {
@@ -635,13 +725,13 @@ void renderStatues(const glm::mat4& PV_matrix) {
   glBindTexture(GL_TEXTURE_2D, bronze_tex);
   glUniform1i(storage.getMyTex(), 0);
 
-  glBindVertexArray(statue_of_liberty.VAO);
+  bindGeometry(modelGeometry(statue_of_liberty));
   glm::mat4 model_matrix = glm::mat4(1.0f);
   model_matrix = glm::translate(model_matrix, glm::vec3(-size_vector.x / 2.0 + 2.0, 0.0, -size_vector.z / 2.0 + 2.0));
   model_matrix = glm::scale(model_matrix, glm::vec3(5.0, 5.0, 5.0));
   model_matrix = glm::rotate(model_matrix, static_cast<float>(glm::radians(45.0)), glm::vec3(0.0, 1.0, 0.0));
   sendDataToShaders(PV_matrix, model_matrix);
-  DrawGeometry(statue_of_liberty);
+  DrawGeometry(modelGeometry(statue_of_liberty));
 
   // busta
   float distance = size_vector.z / 5;
@@ -649,81 +739,81 @@ void renderStatues(const glm::mat4& PV_matrix) {
   glBindTexture(GL_TEXTURE_2D, wood_tex);
   glUniform1i(storage.getMyTex(), 0);
 
-  glBindVertexArray(my_cube.VAO);
+  bindGeometry(my_cube);
   model_matrix = glm::mat4(1.0f);
   model_matrix = glm::translate(model_matrix, glm::vec3(-size_vector.x / 2.0 + 2.0, 1.0, -size_vector.z / 2.0 + 2.0 + distance));
   model_matrix = glm::scale(model_matrix, glm::vec3(0.9, 1.5, 0.9));
   sendDataToShaders(PV_matrix, model_matrix, 1.0, 1.0, 0);
   DrawGeometry(my_cube);
 
-  glBindVertexArray(marble_statue.VAO);
+  bindGeometry(modelGeometry(marble_statue));
   model_matrix = glm::mat4(1.0f);
   model_matrix = glm::rotate(model_matrix, static_cast<float>(glm::radians(90.0)), glm::vec3(0.0, 1.0, 0.0));
   model_matrix = glm::translate(model_matrix, glm::vec3(size_vector.z / 2.0 - 2.0 - distance , 2.4, -size_vector.x / 2.0 + 2.0));
   sendDataToShaders(PV_matrix, model_matrix, 1.0, 1.0, 1);
-  DrawGeometry(marble_statue);
+  drawGeometryLOD(modelGeometry(marble_statue), model_matrix);
 
   // bear
   glActiveTexture(GL_TEXTURE0);
   glBindTexture(GL_TEXTURE_2D, bear_tex);
   glUniform1i(storage.getMyTex(), 0);
 
-  glBindVertexArray(bear.VAO);
+  bindGeometry(modelGeometry(bear));
   model_matrix = glm::mat4(1.0f);
   model_matrix = glm::translate(model_matrix, glm::vec3(-size_vector.x / 2.0 + 2.0, 0.0, -size_vector.z / 2.0 + 2.0 + 2.5 * distance));
   model_matrix = glm::rotate(model_matrix, static_cast<float>(glm::radians(90.0)), glm::vec3(0.0, 1.0, 0.0));
   model_matrix = glm::scale(model_matrix, glm::vec3(2.0, 2.0, 2.0));
   sendDataToShaders(PV_matrix, model_matrix, 5.0, 5.0);
-  DrawGeometry(bear);
+  drawGeometryLOD(modelGeometry(bear), model_matrix);
 
   glActiveTexture(GL_TEXTURE0);
   glBindTexture(GL_TEXTURE_2D, statue_tex);
   glUniform1i(storage.getMyTex(), 0);
 
   // statue
-  glBindVertexArray(statue.VAO);
+  bindGeometry(modelGeometry(statue));
   model_matrix = glm::mat4(1.0f);
   model_matrix = glm::scale(model_matrix, glm::vec3(1.0, 1.0, 1.0));
   model_matrix = glm::translate(model_matrix, glm::vec3(-size_vector.x / 2.0 + 2.0, 0.0, -size_vector.z / 2.0 + 2.0 + 3 * distance));
   model_matrix = glm::rotate(model_matrix, static_cast<float>(glm::radians(90.0)), glm::vec3(0.0, 1.0, 0.0));
   sendDataToShaders(PV_matrix, model_matrix);
-  DrawGeometry(statue);
+  drawGeometryMeshlets(modelGeometry(statue), PV_matrix, model_matrix);
 
   // lion
-  glBindVertexArray(lion.VAO);
+  bindGeometry(modelGeometry(lion));
   model_matrix = glm::mat4(1.0f);
   model_matrix = glm::scale(model_matrix, glm::vec3(1.0, 1.0, 1.0));
   model_matrix = glm::translate(model_matrix, glm::vec3(-size_vector.x / 2.0 + 2.0, 1.0, -size_vector.z / 2.0 + 2.0 + 4 * distance));
   model_matrix = glm::rotate(model_matrix, static_cast<float>(glm::radians(170.0)), glm::vec3(0.0, 1.0, 0.0));
   model_matrix = glm::scale(model_matrix, glm::vec3(0.2, 0.2, 0.2));
   sendDataToShaders(PV_matrix, model_matrix, 1.0, 1.0, 1);
-  DrawGeometry(lion);
+  drawGeometryMeshlets(modelGeometry(lion), PV_matrix, model_matrix);
 
   // golden cup
   glActiveTexture(GL_TEXTURE0);
   glBindTexture(GL_TEXTURE_2D, cup_tex);
   glUniform1i(storage.getMyTex(), 0);
 
-  glBindVertexArray(cup.VAO);
+  bindGeometry(modelGeometry(cup));
   model_matrix = glm::mat4(1.0f);
   model_matrix = glm::translate(model_matrix, glm::vec3(0.0, 1.0, 0.0));
   model_matrix = glm::translate(model_matrix, glm::vec3(-size_vector.x / 2.0 + 2.0, 1.3, -size_vector.z / 2.0 + 2.0 + distance * 2));
   model_matrix = glm::rotate(model_matrix, app_time_s / 3.0f, glm::vec3(0.0, 1.0, 0.0));
   sendDataToShaders(PV_matrix, model_matrix, 1.0, 1.0, 0);
-  DrawGeometry(cup);
+  drawGeometryLOD(modelGeometry(cup), model_matrix);
 
   glActiveTexture(GL_TEXTURE0);
   glBindTexture(GL_TEXTURE_2D, wood_tex);
   glUniform1i(storage.getMyTex(), 0);
 
-  glBindVertexArray(my_cube.VAO);
+  bindGeometry(my_cube);
   model_matrix = glm::mat4(1.0f);
   model_matrix = glm::translate(model_matrix, glm::vec3(-size_vector.x / 2.0 + 2.0, 1.2, -size_vector.z / 2.0 + 2.0 + 2 * distance));
   model_matrix = glm::scale(model_matrix, glm::vec3(1.4, 1.2, 1.4));
   sendDataToShaders(PV_matrix, model_matrix, 1.0, 1.0, 0);
   DrawGeometry(my_cube);
 
-  glBindVertexArray(my_cube.VAO);
+  bindGeometry(my_cube);
   model_matrix = glm::mat4(1.0f);
   model_matrix = glm::translate(model_matrix, glm::vec3(-size_vector.x / 2.0 + 2.0, 6.705, -size_vector.z / 2.0 + 2.0 + 2 * distance));
   model_matrix = glm::scale(model_matrix, glm::vec3(1.4, 0.3, 1.4));
@@ -757,17 +847,17 @@ void renderStatues(const glm::mat4& PV_matrix) {
 void renderClock(const glm::mat4& PV_matrix) {
   museumClock.updateClock();
 
-  glBindVertexArray(clocks.VAO);
+  bindGeometry(modelGeometry(clocks));
   glm::mat4 model_matrix = glm::mat4(1.0f);
   model_matrix = glm::translate(model_matrix, glm::vec3(0.25 * size_vector.x, 1.25 * size_vector.y, size_vector.z / 2.0 - 0.1));
   model_matrix = glm::rotate(model_matrix, static_cast<float>(glm::radians(180.0)), glm::vec3(0.0, 1.0, 0.0));
   model_matrix = glm::scale(model_matrix, glm::vec3(0.8, 0.8, 1.0));
   sendDataToShaders(PV_matrix, model_matrix, 1.0, 1.0, 1);
-  DrawGeometry(clocks);
+  DrawGeometry(modelGeometry(clocks));
 
   float const_move = static_cast<float>(glm::radians(90.0));
   //minute hand
-  glBindVertexArray(my_rectangle.VAO);
+  bindGeometry(my_rectangle);
   model_matrix = glm::mat4(1.0f);
   model_matrix = glm::translate(model_matrix, glm::vec3(0.25 * size_vector.x, 1.25 * size_vector.y, size_vector.z / 2.0 - 0.25));
   model_matrix = glm::rotate(model_matrix, static_cast<float>(glm::radians(180.0)), glm::vec3(0.0, 1.0, 0.0));
@@ -804,13 +894,13 @@ void renderLamps(const glm::mat4& PV_matrix) {
   glBindTexture(GL_TEXTURE_2D, spotlight_tex);
   glUniform1i(storage.getMyTex(), 0);
 
-  glBindVertexArray(spotlight.VAO);
+  bindGeometry(modelGeometry(spotlight));
   glm::mat4 model_matrix = glm::mat4(1.0f);
   glm::vec3 light_pos = glm::vec3(0.0, size_vector.y * 2.0-0.35, - size_vector.z / 2.0 + size_vector.z / 14.0);
   model_matrix = glm::translate(model_matrix, light_pos);
   model_matrix = glm::scale(model_matrix, glm::vec3(1.0, 1.0, 1.0));
   sendDataToShaders(PV_matrix, model_matrix, 1.0, 1.0, 0);
-  DrawGeometry(spotlight);
+  DrawGeometry(modelGeometry(spotlight));
 
   glm::vec3 light_point = glm::vec3(0.0, size_vector.y * 1.1, -size_vector.z / 2.0 + 0.1);
   glm::vec3 light_direction = light_point - light_pos;
@@ -831,22 +921,25 @@ void renderSpeaker(const glm::mat4& PV_matrix) {
   glBindTexture(GL_TEXTURE_2D, speaker_tex);
   glUniform1i(storage.getMyTex(), 0);
 
-  glBindVertexArray(speaker.VAO);
+  bindGeometry(modelGeometry(speaker));
   glm::mat4 model_matrix = glm::mat4(1.0f);
   model_matrix = glm::translate(model_matrix, soundPosition);
   sendDataToShaders(PV_matrix, model_matrix, 1.0, 1.0, 0);
-  DrawGeometry(speaker);
+  DrawGeometry(modelGeometry(speaker));
 }
 
 void render()
 {
+  texture_streamer.Update();
+  asset_loader.Update(asset_upload_budget);
+
   glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
   glUseProgram(program);
 
   glm::mat4 projection_matrix, view_matrix, model_matrix, PVM_matrix;
   glm::mat3 normal_matrix;
 
-  projection_matrix = glm::perspective(glm::radians(50.0f),
+  projection_matrix = glm::perspective(glm::radians(field_of_view),
         float(win_width) / float(win_height), 0.1f, 100.0f);
 
   glm::vec3 position = my_camera.getPosition();
@@ -869,7 +962,7 @@ void render()
   renderStatues(PV_matrix);
   renderClock(PV_matrix);
 
-  glBindVertexArray(0);
+  bindGeometry(PV112Geometry());
   glUseProgram(0);
 
   glutSwapBuffers();
@@ -945,6 +1038,7 @@ int main(int argc, char ** argv)
     glutTimerFunc(20, timer, 0);
     glutMouseFunc(mouse_button_changed);
     glutMotionFunc(mouse_moved);
+    glutCloseFunc(releaseResources);
 
     // Run the main loop
     glutMainLoop();
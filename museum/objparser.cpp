@@ -0,0 +1,578 @@
+#include "objparser.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <algorithm>
+#include <atomic>
+
+#include "parallel.h"
+#include "objtokenizer.inl"
+
+namespace PV112
+{
+
+namespace detail
+{
+
+void AppendVertex(OBJData &out, const float *v)
+{
+    out.Vertices.push_back(glm::vec3(v[0], v[1], v[2]));
+}
+
+void AppendTexCoord(OBJData &out, const float *vt)
+{
+    out.TexCoords.push_back(glm::vec2(vt[0], vt[1]));
+}
+
+void AppendNormal(OBJData &out, const float *vn)
+{
+    out.Normals.push_back(glm::vec3(vn[0], vn[1], vn[2]));
+}
+
+void AppendTriangle(OBJData &out, const OBJTriangle &t)
+{
+    out.Triangles.push_back(t);
+}
+
+void AppendGroupRecord(OBJData &out, OBJGroupRecord::Kind kind, const char *name_begin, const char *name_end)
+{
+    OBJGroupRecord record;
+    record.RecordKind = kind;
+    record.FirstTriangle = out.Triangles.size();
+    record.Name.assign(name_begin, name_end);
+    out.GroupRecords.push_back(record);
+}
+
+float ConvertFloatSlow(const char *begin, const char *end)
+{
+    // The mapped data is not terminated by '\0' so the number must be copied first
+    std::string number(begin, end);
+    return strtof(number.c_str(), nullptr);
+}
+
+}
+
+// The vector variants of the tokenizer, compiled for their instruction sets
+#if defined(OBJ_TOKENIZER_X86)
+bool ParseOBJChunkSSE41(const char *begin, const char *end, OBJData &out);
+bool ParseOBJChunkAVX2(const char *begin, const char *end, OBJData &out);
+#endif
+
+namespace
+{
+
+typedef bool (*ParseOBJChunkFunction)(const char *begin, const char *end, OBJData &out);
+
+// Smaller files are not worth the threads
+const size_t min_chunk_size = 256 * 1024;
+
+// Smallest number of triangles expanded by one thread
+const size_t min_expand_batch = 16 * 1024;
+
+bool ParseOBJChunkScalar(const char *begin, const char *end, OBJData &out)
+{
+    return ParseOBJChunkT<ScalarKernel>(begin, end, out);
+}
+
+inline bool IsTriangleValid(const OBJTriangle &t, unsigned vertex_count, unsigned normal_count, unsigned tex_coord_count)
+{
+    // Negative indices come from the (invalid) index 0
+    return (unsigned(t.v0) < vertex_count) && (unsigned(t.v1) < vertex_count) && (unsigned(t.v2) < vertex_count) &&
+        (unsigned(t.n0) < normal_count) && (unsigned(t.n1) < normal_count) && (unsigned(t.n2) < normal_count) &&
+        (unsigned(t.t0) < tex_coord_count) && (unsigned(t.t1) < tex_coord_count) && (unsigned(t.t2) < tex_coord_count);
+}
+
+bool CPUSupports(OBJParserKernel kernel)
+{
+    switch (kernel)
+    {
+#if defined(OBJ_TOKENIZER_X86) && defined(_MSC_VER)
+    case OBJParserKernel::SSE41:
+    {
+        int info[4];
+        __cpuid(info, 1);
+        return (info[2] & (1 << 19)) != 0;
+    }
+    case OBJParserKernel::AVX2:
+    {
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7)
+            return false;
+
+        // The operating system must save the AVX registers too
+        __cpuid(info, 1);
+        const bool os_saves_avx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && ((_xgetbv(0) & 6) == 6);
+        __cpuidex(info, 7, 0);
+        return os_saves_avx && (info[1] & (1 << 5)) != 0;
+    }
+#elif defined(OBJ_TOKENIZER_X86)
+    case OBJParserKernel::SSE41:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("sse4.1");
+    case OBJParserKernel::AVX2:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+#endif
+    case OBJParserKernel::Scalar:
+        return true;
+    default:
+        return false;
+    }
+}
+
+OBJParserKernel FastestKernel()
+{
+    if (CPUSupports(OBJParserKernel::AVX2))
+        return OBJParserKernel::AVX2;
+    if (CPUSupports(OBJParserKernel::SSE41))
+        return OBJParserKernel::SSE41;
+    return OBJParserKernel::Scalar;
+}
+
+// The kernel chosen by SetOBJParserKernel, or the fastest one
+std::atomic<int> selected_kernel(-1);
+
+ParseOBJChunkFunction SelectedParseOBJChunk()
+{
+    switch (GetOBJParserKernel())
+    {
+#if defined(OBJ_TOKENIZER_X86)
+    case OBJParserKernel::AVX2:     return ParseOBJChunkAVX2;
+    case OBJParserKernel::SSE41:    return ParseOBJChunkSSE41;
+#endif
+    default:                        return ParseOBJChunkScalar;
+    }
+}
+
+// Indices of the position, normal, and texture coordinate of one corner of a triangle
+struct OBJCornerKey
+{
+    int Values[3];
+};
+
+// All attributes of a single vertex, compared and hashed bit by bit
+struct OBJVertexKey
+{
+    float Values[8];
+};
+
+template <typename Key>
+uint32_t HashKey(const Key &key)
+{
+    static_assert(sizeof(Key) % sizeof(uint32_t) == 0, "The key must consist of 32-bit values");
+    uint32_t bits[sizeof(Key) / sizeof(uint32_t)];
+    memcpy(bits, &key, sizeof(bits));
+
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < sizeof(Key) / sizeof(uint32_t); i++)
+        hash = (hash ^ bits[i]) * 16777619u;
+
+    // The table uses the low bits, mix the high bits into them
+    hash ^= hash >> 16;
+    hash *= 0x85EBCA6Bu;
+    hash ^= hash >> 13;
+    return hash;
+}
+
+// Open addressing hash table with linear probing that numbers distinct keys in the order they are first
+// inserted. It grows to stay at most half full, so the probe sequences are short. The hash is stored too,
+// most of the different keys are then skipped without comparing them.
+template <typename Key>
+class KeyNumbering
+{
+public:
+    explicit KeyNumbering(size_t expected_count)
+    {
+        size_t table_size = 16;
+        while (table_size < expected_count * 2)
+            table_size *= 2;
+        table.assign(table_size, EmptySlot());
+        keys.reserve(expected_count);
+    }
+
+    // Returns the number of 'key', the keys that were not inserted yet get the next free number
+    unsigned Insert(const Key &key)
+    {
+        const uint32_t hash = HashKey(key);
+        const size_t mask = table.size() - 1;
+
+        size_t slot = hash & mask;
+        while (table[slot].Number != empty)
+        {
+            if (table[slot].Hash == hash && memcmp(&keys[table[slot].Number], &key, sizeof(Key)) == 0)
+                return table[slot].Number;
+            slot = (slot + 1) & mask;
+        }
+
+        const unsigned number = unsigned(keys.size());
+        table[slot].Hash = hash;
+        table[slot].Number = number;
+        keys.push_back(key);
+        if (keys.size() * 2 > table.size())
+            Grow();
+        return number;
+    }
+
+    const std::vector<Key> &Keys() const
+    {
+        return keys;
+    }
+
+private:
+    static const unsigned empty = ~0u;
+
+    struct Slot
+    {
+        uint32_t Hash;
+        unsigned Number;
+    };
+
+    static Slot EmptySlot()
+    {
+        Slot slot = { 0, empty };
+        return slot;
+    }
+
+    // Doubles the table, the stored hashes tell where to move the keys
+    void Grow()
+    {
+        std::vector<Slot> old_table(table.size() * 2, EmptySlot());
+        old_table.swap(table);
+
+        const size_t mask = table.size() - 1;
+        for (size_t i = 0; i < old_table.size(); i++)
+        {
+            if (old_table[i].Number == empty)
+                continue;
+            size_t slot = old_table[i].Hash & mask;
+            while (table[slot].Number != empty)
+                slot = (slot + 1) & mask;
+            table[slot] = old_table[i];
+        }
+    }
+
+    std::vector<Slot> table;
+    std::vector<Key> keys;
+};
+
+template <typename T>
+void CopyChunk(const std::vector<T> &chunk, std::vector<T> &out, size_t offset)
+{
+    std::copy(chunk.begin(), chunk.end(), out.begin() + offset);
+}
+
+}
+
+bool SetOBJParserKernel(OBJParserKernel kernel)
+{
+    if (!CPUSupports(kernel))
+        return false;
+    selected_kernel = int(kernel);
+    return true;
+}
+
+OBJParserKernel GetOBJParserKernel()
+{
+    int kernel = selected_kernel;
+    if (kernel < 0)
+    {
+        kernel = int(FastestKernel());
+        selected_kernel = kernel;
+    }
+    return OBJParserKernel(kernel);
+}
+
+bool ParseOBJData(const char *data, size_t size, OBJData &out)
+{
+    out = OBJData();
+
+    const ParseOBJChunkFunction ParseOBJChunk = SelectedParseOBJChunk();
+
+    const char *end = data + size;
+    const size_t chunk_count = std::min<size_t>(WorkerThreadCount(), size / min_chunk_size);
+    if (chunk_count <= 1)
+        return ParseOBJChunk(data, end, out);
+
+    // Split the file into chunks of roughly the same size, each of them ends right after a new line
+    std::vector<const char *> bounds(chunk_count + 1);
+    bounds[0] = data;
+    bounds[chunk_count] = end;
+    for (size_t i = 1; i < chunk_count; i++)
+    {
+        const char *split = std::max(data + size * i / chunk_count, bounds[i - 1]);
+        bounds[i] = SkipLine(split, end);
+    }
+
+    // Parse the chunks concurrently, each into its own arrays
+    std::vector<OBJData> chunks(chunk_count);
+    std::vector<char> chunk_ok(chunk_count, 0);
+    ParallelFor(chunk_count, 1, [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; i++)
+            chunk_ok[i] = ParseOBJChunk(bounds[i], bounds[i + 1], chunks[i]);
+    });
+    if (std::find(chunk_ok.begin(), chunk_ok.end(), 0) != chunk_ok.end())
+        return false;
+
+    // Merge the chunks in the file order. The indices of faces are absolute, they refer to the records
+    // of the whole file, so a record of chunk i lands at the sum of record counts of chunks 0..i-1.
+    std::vector<size_t> vertex_offsets(chunk_count + 1, 0);
+    std::vector<size_t> normal_offsets(chunk_count + 1, 0);
+    std::vector<size_t> tex_coord_offsets(chunk_count + 1, 0);
+    std::vector<size_t> triangle_offsets(chunk_count + 1, 0);
+    std::vector<size_t> group_record_offsets(chunk_count + 1, 0);
+    for (size_t i = 0; i < chunk_count; i++)
+    {
+        vertex_offsets[i + 1] = vertex_offsets[i] + chunks[i].Vertices.size();
+        normal_offsets[i + 1] = normal_offsets[i] + chunks[i].Normals.size();
+        tex_coord_offsets[i + 1] = tex_coord_offsets[i] + chunks[i].TexCoords.size();
+        triangle_offsets[i + 1] = triangle_offsets[i] + chunks[i].Triangles.size();
+        group_record_offsets[i + 1] = group_record_offsets[i] + chunks[i].GroupRecords.size();
+
+        // The records count the triangles of their chunk only
+        for (OBJGroupRecord &record : chunks[i].GroupRecords)
+            record.FirstTriangle += triangle_offsets[i];
+    }
+    out.Vertices.resize(vertex_offsets[chunk_count]);
+    out.Normals.resize(normal_offsets[chunk_count]);
+    out.TexCoords.resize(tex_coord_offsets[chunk_count]);
+    out.Triangles.resize(triangle_offsets[chunk_count]);
+    out.GroupRecords.resize(group_record_offsets[chunk_count]);
+
+    ParallelFor(chunk_count, 1, [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; i++)
+        {
+            CopyChunk(chunks[i].Vertices, out.Vertices, vertex_offsets[i]);
+            CopyChunk(chunks[i].Normals, out.Normals, normal_offsets[i]);
+            CopyChunk(chunks[i].TexCoords, out.TexCoords, tex_coord_offsets[i]);
+            CopyChunk(chunks[i].Triangles, out.Triangles, triangle_offsets[i]);
+            CopyChunk(chunks[i].GroupRecords, out.GroupRecords, group_record_offsets[i]);
+            chunks[i] = OBJData();        // Release the chunk as soon as it is merged
+        }
+    });
+
+    return true;
+}
+
+bool ParseOBJStream(FILE *file, size_t block_size, OBJData &out)
+{
+    out = OBJData();
+
+    const ParseOBJChunkFunction ParseOBJChunk = SelectedParseOBJChunk();
+
+    // The buffer holds the unfinished line of the previous block followed by the new data
+    std::vector<char> buffer(std::max<size_t>(block_size, 1));
+    size_t used = 0;
+    while (true)
+    {
+        if (used == buffer.size())
+            buffer.resize(buffer.size() * 2);        // The line does not fit
+
+        const size_t read = fread(buffer.data() + used, 1, buffer.size() - used, file);
+        used += read;
+        if (read == 0)
+        {
+            // The last line may have no new line
+            return !ferror(file) && ParseOBJChunk(buffer.data(), buffer.data() + used, out);
+        }
+
+        const char *begin = buffer.data();
+        const char *lines_end = begin + used;
+        while (lines_end > begin && lines_end[-1] != '\n')
+            lines_end--;
+        if (lines_end == begin)
+            continue;
+
+        if (!ParseOBJChunk(begin, lines_end, out))
+            return false;
+        used -= lines_end - begin;
+        memmove(buffer.data(), lines_end, used);
+    }
+}
+
+void GetOBJSubmeshes(const OBJData &obj, std::vector<OBJSubmesh> &out_submeshes, std::vector<std::string> &out_materials)
+{
+    out_submeshes.clear();
+    out_materials.clear();
+
+    std::string name;
+    std::string material;
+    size_t record = 0;
+    size_t first_triangle = 0;
+    while (first_triangle < obj.Triangles.size())
+    {
+        // Apply the records before the triangle, the submesh ends at the next record
+        while (record < obj.GroupRecords.size() && obj.GroupRecords[record].FirstTriangle <= first_triangle)
+        {
+            const OBJGroupRecord &r = obj.GroupRecords[record++];
+            if (r.RecordKind == OBJGroupRecord::Material)
+                material = r.Name;
+            else
+                name = r.Name;
+        }
+        size_t end_triangle = obj.Triangles.size();
+        if (record < obj.GroupRecords.size())
+            end_triangle = std::min(end_triangle, obj.GroupRecords[record].FirstTriangle);
+
+        // A model has a few materials, a linear search is fine
+        const size_t material_index = std::find(out_materials.begin(), out_materials.end(), material) - out_materials.begin();
+        if (material_index == out_materials.size())
+            out_materials.push_back(material);
+
+        OBJSubmesh submesh;
+        submesh.Name = name;
+        submesh.Material = unsigned(material_index);
+        submesh.FirstTriangle = first_triangle;
+        submesh.TriangleCount = end_triangle - first_triangle;
+        out_submeshes.push_back(submesh);
+
+        first_triangle = end_triangle;
+    }
+}
+
+bool ExpandOBJTrianglesInBlocks(const OBJData &obj, float *block, size_t block_size, const OBJVertexBlockSink &sink)
+{
+    const size_t block_triangles = block_size / (obj_block_vertex_floats * 3);
+    if (block_triangles == 0)
+        return false;
+
+    const unsigned vertex_count = unsigned(obj.Vertices.size());
+    const unsigned normal_count = unsigned(obj.Normals.size());
+    const unsigned tex_coord_count = unsigned(obj.TexCoords.size());
+    for (const OBJTriangle &t : obj.Triangles)
+    {
+        if (!IsTriangleValid(t, vertex_count, normal_count, tex_coord_count))
+            return false;
+    }
+
+    for (size_t first = 0; first < obj.Triangles.size(); first += block_triangles)
+    {
+        const size_t count = std::min(block_triangles, obj.Triangles.size() - first);
+        float *vertex = block;
+        for (size_t i = first; i < first + count; i++)
+        {
+            const OBJTriangle &t = obj.Triangles[i];
+            const int positions[3] = { t.v0, t.v1, t.v2 };
+            const int normals[3] = { t.n0, t.n1, t.n2 };
+            const int tex_coords[3] = { t.t0, t.t1, t.t2 };
+            for (int c = 0; c < 3; c++)
+            {
+                const glm::vec3 &position = obj.Vertices[positions[c]];
+                const glm::vec3 &normal = obj.Normals[normals[c]];
+                const glm::vec2 &tex_coord = obj.TexCoords[tex_coords[c]];
+                vertex[0] = position.x;     vertex[1] = position.y;     vertex[2] = position.z;
+                vertex[3] = normal.x;       vertex[4] = normal.y;       vertex[5] = normal.z;
+                vertex[6] = tex_coord.x;    vertex[7] = tex_coord.y;
+                vertex += obj_block_vertex_floats;
+            }
+        }
+        if (!sink(block, first * 3, count * 3))
+            return false;
+    }
+    return true;
+}
+
+bool ExpandOBJTriangles(const OBJData &obj, std::vector<glm::vec3> &out_vertices, std::vector<glm::vec3> &out_normals, std::vector<glm::vec2> &out_tex_coords)
+{
+    const size_t triangle_count = obj.Triangles.size();
+    out_vertices.resize(triangle_count * 3);
+    out_normals.resize(triangle_count * 3);
+    out_tex_coords.resize(triangle_count * 3);
+
+    const unsigned vertex_count = unsigned(obj.Vertices.size());
+    const unsigned normal_count = unsigned(obj.Normals.size());
+    const unsigned tex_coord_count = unsigned(obj.TexCoords.size());
+
+    // Every triangle has its own place in the output, so the ranges can be expanded independently
+    std::atomic<bool> all_ok(true);
+    ParallelFor(triangle_count, min_expand_batch, [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; i++)
+        {
+            const OBJTriangle &t = obj.Triangles[i];
+
+            if (!IsTriangleValid(t, vertex_count, normal_count, tex_coord_count))
+            {
+                all_ok = false;
+                return;
+            }
+
+            out_vertices[i * 3 + 0] = obj.Vertices[t.v0];
+            out_vertices[i * 3 + 1] = obj.Vertices[t.v1];
+            out_vertices[i * 3 + 2] = obj.Vertices[t.v2];
+            out_normals[i * 3 + 0] = obj.Normals[t.n0];
+            out_normals[i * 3 + 1] = obj.Normals[t.n1];
+            out_normals[i * 3 + 2] = obj.Normals[t.n2];
+            out_tex_coords[i * 3 + 0] = obj.TexCoords[t.t0];
+            out_tex_coords[i * 3 + 1] = obj.TexCoords[t.t1];
+            out_tex_coords[i * 3 + 2] = obj.TexCoords[t.t2];
+        }
+    });
+
+    return all_ok;
+}
+
+bool IndexOBJTriangles(const OBJData &obj, std::vector<glm::vec3> &out_vertices, std::vector<glm::vec3> &out_normals, std::vector<glm::vec2> &out_tex_coords,
+        std::vector<unsigned int> &out_indices)
+{
+    const size_t corner_count = obj.Triangles.size() * 3;
+    const size_t expected_count = std::max(obj.Vertices.size(), std::max(obj.Normals.size(), obj.TexCoords.size()));
+
+    const unsigned vertex_count = unsigned(obj.Vertices.size());
+    const unsigned normal_count = unsigned(obj.Normals.size());
+    const unsigned tex_coord_count = unsigned(obj.TexCoords.size());
+
+    // Most of the corners that share a vertex share also its indices in the file, finding them compares
+    // just the indices and does not touch the data. The numbers of corners go to 'out_indices' for now.
+    KeyNumbering<OBJCornerKey> corners(expected_count);
+    out_indices.resize(corner_count);
+    for (size_t i = 0; i < obj.Triangles.size(); i++)
+    {
+        const OBJTriangle &t = obj.Triangles[i];
+        const OBJCornerKey keys[3] = { { { t.v0, t.n0, t.t0 } }, { { t.v1, t.n1, t.t1 } }, { { t.v2, t.n2, t.t2 } } };
+        for (int c = 0; c < 3; c++)
+        {
+            // Negative indices come from the (invalid) index 0
+            const OBJCornerKey &key = keys[c];
+            if ((unsigned(key.Values[0]) >= vertex_count) || (unsigned(key.Values[1]) >= normal_count) || (unsigned(key.Values[2]) >= tex_coord_count))
+                return false;
+            out_indices[i * 3 + c] = corners.Insert(key);
+        }
+    }
+
+    // The file may store the same values several times, corners with different indices can still be
+    // the same vertex. Compare the data of distinct corners, they are numbered in the order of their first
+    // use, so the vertices will be as well.
+    const std::vector<OBJCornerKey> &distinct_corners = corners.Keys();
+    KeyNumbering<OBJVertexKey> vertices(distinct_corners.size());
+    std::vector<unsigned> corner_vertex(distinct_corners.size());
+    for (size_t i = 0; i < distinct_corners.size(); i++)
+    {
+        const OBJCornerKey &corner = distinct_corners[i];
+        const glm::vec3 &position = obj.Vertices[corner.Values[0]];
+        const glm::vec3 &normal = obj.Normals[corner.Values[1]];
+        const glm::vec2 &tex_coord = obj.TexCoords[corner.Values[2]];
+        const OBJVertexKey key = { { position.x, position.y, position.z, normal.x, normal.y, normal.z, tex_coord.x, tex_coord.y } };
+        corner_vertex[i] = vertices.Insert(key);
+    }
+
+    for (size_t i = 0; i < corner_count; i++)
+        out_indices[i] = corner_vertex[out_indices[i]];
+
+    const std::vector<OBJVertexKey> &distinct_vertices = vertices.Keys();
+    out_vertices.resize(distinct_vertices.size());
+    out_normals.resize(distinct_vertices.size());
+    out_tex_coords.resize(distinct_vertices.size());
+    for (size_t i = 0; i < distinct_vertices.size(); i++)
+    {
+        const float *values = distinct_vertices[i].Values;
+        out_vertices[i] = glm::vec3(values[0], values[1], values[2]);
+        out_normals[i] = glm::vec3(values[3], values[4], values[5]);
+        out_tex_coords[i] = glm::vec2(values[6], values[7]);
+    }
+
+    return true;
+}
+
+}
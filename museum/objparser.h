@@ -0,0 +1,131 @@
+#pragma once
+#ifndef INCLUDED_OBJPARSER_H
+#define INCLUDED_OBJPARSER_H
+
+#include <vector>
+#include <string>
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+
+#include <glm/glm.hpp>
+
+namespace PV112
+{
+
+/// A single triangle of an OBJ file. The indices are already converted to start from 0.
+struct OBJTriangle
+{
+    int v0, v1, v2;
+    int n0, n1, n2;
+    int t0, t1, t2;
+};
+
+/// An o (object), g (group), or usemtl (material) record of an OBJ file. The record applies to the
+/// triangles that follow it, up to the next record of the same kind.
+struct OBJGroupRecord
+{
+    enum Kind { Object, Group, Material };
+
+    Kind RecordKind;
+    // Number of triangles before the record
+    size_t FirstTriangle;
+    // The rest of the line without the surrounding blanks
+    std::string Name;
+};
+
+/// The records of an OBJ file exactly as they appear in the file, i.e. before the triangles are
+/// resolved into vertices.
+struct OBJData
+{
+    std::vector<glm::vec3> Vertices;
+    std::vector<glm::vec3> Normals;
+    std::vector<glm::vec2> TexCoords;
+    std::vector<OBJTriangle> Triangles;
+    std::vector<OBJGroupRecord> GroupRecords;
+};
+
+/// A run of consecutive triangles of an OBJ file with the same object, group, and material.
+struct OBJSubmesh
+{
+    // Name of the last o or g record before the triangles, whichever is later (empty if there is none)
+    std::string Name;
+    // Index to the materials returned by GetOBJSubmeshes
+    unsigned int Material;
+    size_t FirstTriangle;
+    size_t TriangleCount;
+};
+
+/// Instruction sets the number conversion of ParseOBJData can use.
+enum class OBJParserKernel
+{
+    Scalar,
+    SSE41,
+    AVX2
+};
+
+/// Chooses the instruction set ParseOBJData uses to convert the numbers. By default, the fastest one the
+/// CPU supports is used. Returns false (and keeps the current one) if the CPU does not support it.
+///
+/// All kernels give exactly the same results, this is useful mostly for benchmarks.
+bool SetOBJParserKernel(OBJParserKernel kernel);
+
+/// Returns the instruction set ParseOBJData uses to convert the numbers.
+OBJParserKernel GetOBJParserKernel();
+
+/// Parses 'size' bytes of OBJ file content at 'data' and stores the v/vt/vn/f/o/g/usemtl records to 'out'.
+///
+/// The data is tokenized in place, without any allocation per line and without going through
+/// locale-aware stream extraction. Large files are split into line-aligned chunks that are parsed
+/// concurrently, one per CPU core, and merged in the file order.
+///
+/// The numbers are converted with the same rounding as the C library (and therefore std::istream)
+/// does. Only triangles with all three indices per vertex are supported, the function returns false
+/// when any other face is found or when a number is malformed.
+bool ParseOBJData(const char *data, size_t size, OBJData &out);
+
+/// Parses an OBJ file like ParseOBJData, but reads it from 'file' into a buffer of 'block_size' bytes
+/// and parses the complete lines of each block before reading the next one. The file is neither mapped
+/// nor read whole, so only the records and the buffer take memory. A line longer than the buffer makes
+/// it grow. The blocks are parsed on the calling thread only.
+///
+/// Returns false if the file cannot be read or ParseOBJData would fail.
+bool ParseOBJStream(FILE *file, size_t block_size, OBJData &out);
+
+/// Splits the triangles of 'obj' into submeshes by its o, g, and usemtl records, empty submeshes are left
+/// out. 'out_materials' gets the names of the used materials in the order of their first use, a file
+/// without usemtl records has a single material with an empty name.
+void GetOBJSubmeshes(const OBJData &obj, std::vector<OBJSubmesh> &out_submeshes, std::vector<std::string> &out_materials);
+
+/// Resolves the triangles of 'obj' into the data of individual vertices (use glDrawArrays with
+/// GL_TRIANGLES), in parallel for large geometries. Returns false if some index is out of range.
+bool ExpandOBJTriangles(const OBJData &obj, std::vector<glm::vec3> &out_vertices, std::vector<glm::vec3> &out_normals, std::vector<glm::vec2> &out_tex_coords);
+
+/// Number of floats of a vertex expanded by ExpandOBJTrianglesInBlocks: position (3), normal (3), and
+/// texture coordinate (2), interleaved.
+const size_t obj_block_vertex_floats = 8;
+
+/// Receives the vertices of ExpandOBJTrianglesInBlocks: 'vertex_count' vertices that follow the
+/// 'first_vertex' vertices of the previous blocks. The data is valid only during the call. Returns false
+/// to stop the expansion.
+typedef std::function<bool(const float *vertices, size_t first_vertex, size_t vertex_count)> OBJVertexBlockSink;
+
+/// Resolves the triangles of 'obj' like ExpandOBJTriangles, but into a staging block of 'block_size'
+/// floats, which is passed to 'sink' whenever it is full and at the end. Only whole triangles are put into
+/// a block, so it must have room for at least one. The memory does not grow with the geometry, the sink
+/// can copy each block where it belongs (for example with glBufferSubData) and the block is reused.
+///
+/// The indices are checked before the first block, so the sink is not called at all if some of them are
+/// out of range. Returns false in that case, or if the sink stops the expansion.
+bool ExpandOBJTrianglesInBlocks(const OBJData &obj, float *block, size_t block_size, const OBJVertexBlockSink &sink);
+
+/// Resolves the triangles of 'obj' into unique vertices and indices (use glDrawElements with
+/// GL_TRIANGLES). Corners with exactly the same position, normal, and texture coordinate share one
+/// vertex, even when the file stores these values several times. The vertices are numbered in the
+/// order of their first use. Returns false if some index is out of range.
+bool IndexOBJTriangles(const OBJData &obj, std::vector<glm::vec3> &out_vertices, std::vector<glm::vec3> &out_normals, std::vector<glm::vec2> &out_tex_coords,
+        std::vector<unsigned int> &out_indices);
+
+}
+
+#endif	// INCLUDED_OBJPARSER_H
@@ -0,0 +1,71 @@
+// The number parsing kernel of the OBJ tokenizer for CPUs with AVX2, compiled with -mavx2
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#define OBJ_TOKENIZER_SIMD
+#endif
+
+#include "objtokenizer.inl"
+
+#if defined(OBJ_TOKENIZER_SIMD)
+
+namespace PV112
+{
+
+namespace
+{
+
+// Returns a bit mask of the bytes that are digits among 32 bytes at 'p'
+inline uint32_t DigitMask32(const char *p)
+{
+    const __m256i values = _mm256_sub_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)), _mm256_set1_epi8('0'));
+    const __m256i is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(values, _mm256_set1_epi8(9)), values);
+    return uint32_t(_mm256_movemask_epi8(is_digit));
+}
+
+// Classifies 32 characters at once, a single mask covers both the integer part and the fraction of the
+// numbers in OBJ files
+struct AVX2Kernel
+{
+    // The longest number the kernel accepts, plus a full vector behind the decimal point
+    static const ptrdiff_t lookahead = 64;
+
+    static bool ParseDecimal(const char *&p, uint64_t &mantissa, int &exponent)
+    {
+        const uint32_t digits = DigitMask32(p);
+        const unsigned integer_count = (digits == 0xFFFFFFFFu) ? 32 : CountTrailingZeros(~digits);
+        if (integer_count >= 16)
+            return false;
+
+        const bool has_point = (p[integer_count] == '.');
+        unsigned fraction_count = 0;
+        if (has_point)
+        {
+            // The bits shifted in from the top are not digits, so the run always ends inside the mask
+            fraction_count = CountTrailingZeros(~(digits >> (integer_count + 1)));
+        }
+        return ConvertDecimal(p, integer_count, fraction_count, has_point, mantissa, exponent);
+    }
+
+    static bool ParseUnsigned(const char *&p, int &out)
+    {
+        // Indices are short, a half vector is enough. Nine digits always fit into an int.
+        const unsigned count = CountTrailingZeros(~DigitMask16(p));
+        if (count > 9)
+            return false;
+        out = int(ConvertDigits16(p, count));
+        p += count;
+        return true;
+    }
+};
+
+}
+
+bool ParseOBJChunkAVX2(const char *begin, const char *end, OBJData &out)
+{
+    return ParseOBJChunkT<AVX2Kernel>(begin, end, out);
+}
+
+}
+
+#endif	// OBJ_TOKENIZER_SIMD
@@ -0,0 +1,54 @@
+// The number parsing kernel of the OBJ tokenizer for CPUs with SSE4.1, compiled with -msse4.1
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <smmintrin.h>
+#define OBJ_TOKENIZER_SIMD
+#endif
+
+#include "objtokenizer.inl"
+
+#if defined(OBJ_TOKENIZER_SIMD)
+
+namespace PV112
+{
+
+namespace
+{
+
+// Classifies 16 characters at once, which covers the integer part and the fraction separately
+struct SSE41Kernel
+{
+    // The longest number the kernel accepts, plus a full vector behind the decimal point
+    static const ptrdiff_t lookahead = 64;
+
+    static bool ParseDecimal(const char *&p, uint64_t &mantissa, int &exponent)
+    {
+        // Counting the trailing ones gives the length of the run of digits
+        const unsigned integer_count = CountTrailingZeros(~DigitMask16(p));
+        const bool has_point = (p[integer_count] == '.');
+        const unsigned fraction_count = has_point ? CountTrailingZeros(~DigitMask16(p + integer_count + 1)) : 0;
+        return ConvertDecimal(p, integer_count, fraction_count, has_point, mantissa, exponent);
+    }
+
+    static bool ParseUnsigned(const char *&p, int &out)
+    {
+        // Nine digits always fit into an int
+        const unsigned count = CountTrailingZeros(~DigitMask16(p));
+        if (count > 9)
+            return false;
+        out = int(ConvertDigits16(p, count));
+        p += count;
+        return true;
+    }
+};
+
+}
+
+bool ParseOBJChunkSSE41(const char *begin, const char *end, OBJData &out)
+{
+    return ParseOBJChunkT<SSE41Kernel>(begin, end, out);
+}
+
+}
+
+#endif	// OBJ_TOKENIZER_SIMD
@@ -0,0 +1,428 @@
+// The OBJ tokenizer shared by objparser.cpp, objparser_sse41.cpp and objparser_avx2.cpp.
+//
+// Each of these files is compiled for a different instruction set and instantiates ParseOBJChunkT with
+// its own number parsing kernel. For this reason, everything here has internal linkage, and the records
+// are stored through the functions of objparser.cpp. No inline function of the standard library (such
+// as std::vector::push_back) may be compiled here, because the linker could share its AVX2 copy with
+// the code that runs on CPUs without AVX2.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <climits>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include "objparser.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define OBJ_TOKENIZER_X86
+#endif
+
+namespace PV112
+{
+
+namespace detail
+{
+
+// Defined in objparser.cpp, compiled for the baseline instruction set
+void AppendVertex(OBJData &out, const float *v);
+void AppendTexCoord(OBJData &out, const float *vt);
+void AppendNormal(OBJData &out, const float *vn);
+void AppendTriangle(OBJData &out, const OBJTriangle &t);
+void AppendGroupRecord(OBJData &out, OBJGroupRecord::Kind kind, const char *name_begin, const char *name_end);
+float ConvertFloatSlow(const char *begin, const char *end);
+
+}
+
+namespace
+{
+
+// All powers of ten up to 10^22 are exactly representable in a double
+const double powers_of_ten[] =
+{
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+const uint64_t integer_powers_of_ten[] =
+{
+    1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull,
+    1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull,
+    100000000000000ull, 1000000000000000ull, 10000000000000000ull, 100000000000000000ull,
+    1000000000000000000ull, 10000000000000000000ull
+};
+
+inline bool IsDigit(char c)
+{
+    return static_cast<unsigned char>(c - '0') < 10;
+}
+
+// White space that may appear inside a single line
+inline bool IsBlank(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+inline bool IsSpace(char c)
+{
+    return IsBlank(c) || c == '\n';
+}
+
+inline const char *SkipBlanks(const char *p, const char *end)
+{
+    while (p < end && IsBlank(*p))
+        p++;
+    return p;
+}
+
+// Returns the beginning of the next line
+inline const char *SkipLine(const char *p, const char *end)
+{
+    if (p >= end)
+        return end;
+    const void *new_line = memchr(p, '\n', size_t(end - p));
+    return new_line ? static_cast<const char *>(new_line) + 1 : end;
+}
+
+inline unsigned CountTrailingZeros(uint32_t x)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, x);
+    return unsigned(index);
+#else
+    return unsigned(__builtin_ctz(x));
+#endif
+}
+
+// Reads the digits of a decimal number "123.456" as 'mantissa' * 10^'exponent'. At most 19 significant
+// digits are stored in 'mantissa', 'exact' is false if some non-zero digit was dropped.
+bool ParseDecimalScalar(const char *&p, const char *end, uint64_t &mantissa, int &exponent, bool &exact)
+{
+    mantissa = 0;
+    exponent = 0;
+    exact = true;
+    int digits = 0;          // Significant digits stored in 'mantissa'
+    bool has_digits = false;
+
+    for (; p < end && IsDigit(*p); p++)
+    {
+        has_digits = true;
+        if (digits < 19)
+        {
+            mantissa = mantissa * 10 + uint64_t(*p - '0');
+            if (mantissa != 0)
+                digits++;
+        }
+        else
+        {
+            exponent++;
+            exact = exact && (*p == '0');
+        }
+    }
+    if (p < end && *p == '.')
+    {
+        for (p++; p < end && IsDigit(*p); p++)
+        {
+            has_digits = true;
+            if (digits < 19)
+            {
+                mantissa = mantissa * 10 + uint64_t(*p - '0');
+                exponent--;
+                if (mantissa != 0)
+                    digits++;
+            }
+            else exact = exact && (*p == '0');
+        }
+    }
+    return has_digits;
+}
+
+// Does nothing, the scalar code is used for all numbers
+struct ScalarKernel
+{
+    // Number of bytes that must be readable at the number, 0 disables the kernel
+    static const ptrdiff_t lookahead = 0;
+
+    static bool ParseDecimal(const char *&, uint64_t &, int &)
+    {
+        return false;
+    }
+
+    static bool ParseUnsigned(const char *&, int &)
+    {
+        return false;
+    }
+};
+
+// Converts the number at 'p' and moves 'p' behind it.
+//
+// Numbers with at most 19 significant digits and a small exponent are computed exactly as
+// mantissa * 10^exponent (or mantissa / 10^-exponent) in double precision. A single correctly rounded
+// double operation rounded again to float gives the correctly rounded float, because double has more
+// than 2 * 24 + 2 bits of precision. This is the result strtof (used by std::istream) gives as well.
+// The rare remaining numbers are passed to strtof directly.
+//
+// The kernel only finds and converts the digits, it produces the same mantissa and exponent as the
+// scalar code. It gives up (and the scalar code is used) when the number has too many digits.
+template <typename Kernel>
+bool ParseFloat(const char *&p, const char *end, float &out)
+{
+    const char *start = p;
+
+    bool negative = false;
+    if (p < end && (*p == '+' || *p == '-'))
+    {
+        negative = (*p == '-');
+        p++;
+    }
+
+    uint64_t mantissa;
+    int exponent;
+    bool exact = true;
+    if (!(Kernel::lookahead > 0 && end - p >= Kernel::lookahead && Kernel::ParseDecimal(p, mantissa, exponent)))
+    {
+        if (!ParseDecimalScalar(p, end, mantissa, exponent, exact))
+        {
+            p = start;
+            return false;
+        }
+    }
+
+    // The exponent belongs to the number only if at least one digit follows
+    if (p < end && (*p == 'e' || *p == 'E'))
+    {
+        const char *e = p + 1;
+        bool negative_exponent = false;
+        if (e < end && (*e == '+' || *e == '-'))
+        {
+            negative_exponent = (*e == '-');
+            e++;
+        }
+        if (e < end && IsDigit(*e))
+        {
+            int value = 0;
+            for (; e < end && IsDigit(*e); e++)
+            {
+                if (value < 100000)
+                    value = value * 10 + (*e - '0');
+            }
+            exponent += negative_exponent ? -value : value;
+            p = e;
+        }
+    }
+
+    if (mantissa == 0 && exact)
+    {
+        out = negative ? -0.0f : 0.0f;
+        return true;
+    }
+    if (exact && mantissa <= (uint64_t(1) << 53) && exponent >= -22 && exponent <= 22)
+    {
+        double value = double(mantissa);
+        value = (exponent < 0) ? value / powers_of_ten[-exponent] : value * powers_of_ten[exponent];
+        out = float(negative ? -value : value);
+        return true;
+    }
+
+    out = detail::ConvertFloatSlow(start, p);
+    return true;
+}
+
+// Converts an OBJ index, which must start with a digit (negative relative indices are not supported)
+template <typename Kernel>
+bool ParseIndex(const char *&p, const char *end, int &out)
+{
+    p = SkipBlanks(p, end);
+    if (p == end || !IsDigit(*p))
+        return false;
+
+    if (Kernel::lookahead > 0 && end - p >= Kernel::lookahead && Kernel::ParseUnsigned(p, out))
+        return true;
+
+    int64_t value = 0;
+    for (; p < end && IsDigit(*p); p++)
+    {
+        value = value * 10 + (*p - '0');
+        if (value > INT_MAX)
+            return false;
+    }
+    out = int(value);
+    return true;
+}
+
+inline bool ParseSlash(const char *&p, const char *end)
+{
+    p = SkipBlanks(p, end);
+    if (p == end || *p != '/')
+        return false;
+    p++;
+    return true;
+}
+
+// Reads "v/t/n" of one vertex of a face, the indices are converted to start from 0
+template <typename Kernel>
+inline bool ParseFaceVertex(const char *&p, const char *end, int &v, int &t, int &n)
+{
+    if (!ParseIndex<Kernel>(p, end, v) || !ParseSlash(p, end) ||
+            !ParseIndex<Kernel>(p, end, t) || !ParseSlash(p, end) ||
+            !ParseIndex<Kernel>(p, end, n))
+        return false;
+
+    // Subtract one, OBJ indexes from 1, not from 0
+    v--;        t--;        n--;
+    return true;
+}
+
+template <typename Kernel>
+inline bool ParseVector(const char *&p, const char *end, float *components, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        p = SkipBlanks(p, end);
+        if (!ParseFloat<Kernel>(p, end, components[i]))
+            return false;
+    }
+    return true;
+}
+
+// Parses complete lines in [begin, end) and appends the records to 'out'
+template <typename Kernel>
+bool ParseOBJChunkT(const char *begin, const char *end, OBJData &out)
+{
+    const char *p = begin;
+
+    while (p < end)
+    {
+        // Skip the indentation and empty lines
+        while (p < end && IsSpace(*p))
+            p++;
+        if (p == end)
+            break;
+
+        const char *keyword = p;
+        while (p < end && !IsSpace(*p))
+            p++;
+        const size_t keyword_length = p - keyword;
+
+        if (keyword_length == 1 && keyword[0] == 'v')
+        {
+            float v[3];
+            if (!ParseVector<Kernel>(p, end, v, 3))
+                return false;
+            detail::AppendVertex(out, v);
+        }
+        else if (keyword_length == 2 && keyword[0] == 'v' && keyword[1] == 't')
+        {
+            float vt[2];
+            if (!ParseVector<Kernel>(p, end, vt, 2))
+                return false;
+            detail::AppendTexCoord(out, vt);
+        }
+        else if (keyword_length == 2 && keyword[0] == 'v' && keyword[1] == 'n')
+        {
+            float vn[3];
+            if (!ParseVector<Kernel>(p, end, vn, 3))
+                return false;
+            detail::AppendNormal(out, vn);
+        }
+        else if (keyword_length == 1 && keyword[0] == 'f')
+        {
+            // The geometry must contain only triangles, and all vertices must have their position,
+            // normal, and texture coordinate set.
+            OBJTriangle t;
+            if (!ParseFaceVertex<Kernel>(p, end, t.v0, t.t0, t.n0) ||
+                    !ParseFaceVertex<Kernel>(p, end, t.v1, t.t1, t.n1) ||
+                    !ParseFaceVertex<Kernel>(p, end, t.v2, t.t2, t.n2))
+                return false;
+
+            // Check that this polygon has only three vertices (we support triangles only)
+            p = SkipBlanks(p, end);
+            if (p < end && IsDigit(*p))
+                return false;
+
+            detail::AppendTriangle(out, t);
+        }
+        else if ((keyword_length == 1 && (keyword[0] == 'o' || keyword[0] == 'g')) ||
+                (keyword_length == 6 && memcmp(keyword, "usemtl", 6) == 0))
+        {
+            const OBJGroupRecord::Kind kind = (keyword[0] == 'o') ? OBJGroupRecord::Object :
+                (keyword[0] == 'g') ? OBJGroupRecord::Group : OBJGroupRecord::Material;
+            const char *name_begin = SkipBlanks(p, end);
+            const char *name_end = SkipLine(name_begin, end);
+            while (name_end > name_begin && IsSpace(name_end[-1]))
+                name_end--;
+            detail::AppendGroupRecord(out, kind, name_begin, name_end);
+        }
+
+        // Ignore the rest of the line, and all other records
+        p = SkipLine(p, end);
+    }
+
+    return true;
+}
+
+#if defined(OBJ_TOKENIZER_SIMD)
+
+// Shuffle masks that move the first N bytes of a vector to its end and zero the rest, the mask for
+// N digits starts at shift_masks + N
+const signed char shift_masks[32] =
+{
+    -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128,
+       0,    1,    2,    3,    4,    5,    6,    7,    8,    9,   10,   11,   12,   13,   14,   15
+};
+
+// Returns a bit mask of the bytes that are digits among 16 bytes at 'p'
+inline uint32_t DigitMask16(const char *p)
+{
+    const __m128i values = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)), _mm_set1_epi8('0'));
+    const __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(values, _mm_set1_epi8(9)), values);
+    return uint32_t(_mm_movemask_epi8(is_digit));
+}
+
+// Converts 'count' (at most 16) digits at 'p' to an integer, 16 bytes must be readable at 'p'
+inline uint64_t ConvertDigits16(const char *p, unsigned count)
+{
+    __m128i values = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)), _mm_set1_epi8('0'));
+    values = _mm_shuffle_epi8(values, _mm_loadu_si128(reinterpret_cast<const __m128i *>(shift_masks + count)));
+
+    // Pairs of digits, then groups of four, then two groups of eight
+    const __m128i pairs = _mm_maddubs_epi16(values, _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1));
+    const __m128i quads = _mm_madd_epi16(pairs, _mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1));
+    const __m128i packed = _mm_packus_epi32(quads, quads);
+    const __m128i octets = _mm_madd_epi16(packed, _mm_setr_epi16(10000, 1, 10000, 1, 10000, 1, 10000, 1));
+
+    const uint64_t high = uint32_t(_mm_cvtsi128_si32(octets));
+    const uint64_t low = uint32_t(_mm_extract_epi32(octets, 1));
+    return high * 100000000ull + low;
+}
+
+// Combines the integer part and the fraction of a decimal number, the digits have already been counted.
+// Gives up if the number does not fit into 19 digits (the scalar code handles it).
+inline bool ConvertDecimal(const char *&p, unsigned integer_count, unsigned fraction_count, bool has_point,
+        uint64_t &mantissa, int &exponent)
+{
+    if (integer_count >= 16 || fraction_count >= 16 || integer_count + fraction_count > 19 ||
+            integer_count + fraction_count == 0)
+        return false;
+
+    mantissa = ConvertDigits16(p, integer_count);
+    p += integer_count;
+    exponent = 0;
+    if (has_point)
+    {
+        mantissa = mantissa * integer_powers_of_ten[fraction_count] + ConvertDigits16(p + 1, fraction_count);
+        exponent = -int(fraction_count);
+        p += 1 + fraction_count;
+    }
+    return true;
+}
+
+#endif	// OBJ_TOKENIZER_SIMD
+
+}
+
+}
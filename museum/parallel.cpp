@@ -0,0 +1,68 @@
+#include "parallel.h"
+
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+namespace PV112
+{
+
+namespace
+{
+
+// Set on the threads of ParallelFor and inside SerialScopes
+thread_local bool serial_thread = false;
+
+}
+
+unsigned WorkerThreadCount()
+{
+    // hardware_concurrency may return 0 when the number cannot be determined
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+void ParallelFor(size_t count, size_t min_batch, const std::function<void(size_t, size_t)> &body)
+{
+    if (count == 0)
+        return;
+
+    size_t parts = std::min<size_t>(WorkerThreadCount(), (count + min_batch - 1) / std::max<size_t>(min_batch, 1));
+    if (parts <= 1 || serial_thread)
+    {
+        body(0, count);
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(parts - 1);
+    for (size_t i = 0; i + 1 < parts; i++)
+    {
+        threads.push_back(std::thread([&body](size_t begin, size_t end)
+        {
+            serial_thread = true;
+            body(begin, end);
+        }, count * i / parts, count * (i + 1) / parts));
+    }
+    {
+        const SerialScope serial;
+        body(count * (parts - 1) / parts, count);
+    }
+
+    for (size_t i = 0; i < threads.size(); i++)
+    {
+        threads[i].join();
+    }
+}
+
+SerialScope::SerialScope()
+    : was_serial(serial_thread)
+{
+    serial_thread = true;
+}
+
+SerialScope::~SerialScope()
+{
+    serial_thread = was_serial;
+}
+
+}
@@ -0,0 +1,41 @@
+#pragma once
+#ifndef INCLUDED_PARALLEL_H
+#define INCLUDED_PARALLEL_H
+
+#include <cstddef>
+#include <functional>
+
+namespace PV112
+{
+
+/// Returns the number of threads the CPU can run at once (at least 1).
+unsigned WorkerThreadCount();
+
+/// Splits the range [0, count) into contiguous parts of at least 'min_batch' items, and calls
+/// 'body(begin, end)' for each of them, one part per thread. The calling thread processes the last part
+/// itself, and the function returns when all parts are done.
+///
+/// Small ranges (count <= min_batch) are processed directly on the calling thread. So is every range when
+/// the calling thread is already one of several running in parallel: a thread of another ParallelFor, or a
+/// thread inside a SerialScope. The threads would only compete for the same cores otherwise.
+void ParallelFor(size_t count, size_t min_batch, const std::function<void(size_t, size_t)> &body);
+
+/// Makes ParallelFor process whole ranges on the current thread while the scope exists. Work that runs
+/// beside other work of its kind, like the texture read steps of an AssetLoader, opens one, so that the
+/// kernels it calls do not start WorkerThreadCount() threads each. Scopes may be nested.
+class SerialScope
+{
+public:
+    SerialScope();
+    ~SerialScope();
+
+private:
+    SerialScope(const SerialScope &);
+    SerialScope &operator =(const SerialScope &);
+
+    bool was_serial;
+};
+
+}
+
+#endif	// INCLUDED_PARALLEL_H
@@ -0,0 +1,49 @@
+#pragma once
+#ifndef INCLUDED_PRIMITIVES_H
+#define INCLUDED_PRIMITIVES_H
+
+#include <cstddef>
+
+#include "meshtools.h"
+
+namespace PV112
+{
+
+/// Vertices and indices of a basic object, computed by the compiler (see constexprtables.h) and stored in
+/// read-only data in the final layout. The same vertices are in all three formats of VertexLayout, and the
+/// indices are a list of triangles already ordered for the post-transform vertex cache, so any of them
+/// can be passed to glBufferData as it is.
+struct PrimitiveTables
+{
+    // Interleaved position (3), normal (3), and texture coordinate (2)
+    const float *Vertices;
+    const PackedVertex *PackedVertices;
+    // Positions relative to BoundsMin and BoundsMax, see QuantizeVertices
+    const QuantizedVertex *QuantizedVertices;
+    size_t VertexCount;
+
+    const unsigned int *Indices;
+    size_t IndexCount;
+
+    // Bounding box of the positions
+    float BoundsMin[3];
+    float BoundsMax[3];
+    // Largest distance between the triangles and the exact surface, in the units of the positions, for
+    // the spheres (0 for the other objects)
+    float Error;
+};
+
+/// Tessellation levels of the sphere, level 'l' has 12 << l slices and half as many stacks. Level 1 is the
+/// density of the former sphere.inl table (24 x 12) and the default of CreateSphere.
+const int sphere_tessellation_levels = 4;
+const int default_sphere_tessellation = 1;
+
+/// Returns the tables of the basic objects of PV112.h. The level of the sphere is clamped to the valid ones.
+const PrimitiveTables &GetCubeTables();
+const PrimitiveTables &GetRectangleTables();
+const PrimitiveTables &GetTeapotTables();
+const PrimitiveTables &GetSphereTables(int level);
+
+}
+
+#endif	// INCLUDED_PRIMITIVES_H
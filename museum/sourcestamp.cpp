@@ -0,0 +1,95 @@
+#include "sourcestamp.h"
+
+#include <cstring>
+
+#if defined(_WIN32)
+#define NOMINMAX      // Make Windows.h not define 'min' and 'max' macros
+#include <windows.h>
+#endif
+
+namespace PV112
+{
+
+namespace
+{
+
+inline uint64_t RotateLeft(uint64_t x, int bits)
+{
+    return (x << bits) | (x >> (64 - bits));
+}
+
+inline uint64_t MixHash(uint64_t hash, uint64_t value)
+{
+    return RotateLeft(hash ^ (value * 0x9E3779B97F4A7C15ull), 31) * 0xC2B2AE3D27D4EB4Full;
+}
+
+// A fast non-cryptographic hash, four independent lanes of 8 bytes keep the multiplier busy
+uint64_t HashBytes(const char *data, size_t size)
+{
+    uint64_t lanes[4] = { 0x243F6A8885A308D3ull, 0x13198A2E03707344ull, 0xA4093822299F31D0ull, 0x082EFA98EC4E6C89ull };
+
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32)
+    {
+        uint64_t words[4];
+        memcpy(words, data + i, sizeof(words));
+        lanes[0] = MixHash(lanes[0], words[0]);
+        lanes[1] = MixHash(lanes[1], words[1]);
+        lanes[2] = MixHash(lanes[2], words[2]);
+        lanes[3] = MixHash(lanes[3], words[3]);
+    }
+
+    uint64_t hash = MixHash(MixHash(MixHash(MixHash(uint64_t(size), lanes[0]), lanes[1]), lanes[2]), lanes[3]);
+    for (; i < size; i++)
+        hash = MixHash(hash, uint64_t(static_cast<unsigned char>(data[i])));
+    return hash ^ (hash >> 29);
+}
+
+}
+
+SourceStamp GetSourceStamp(const MappedFile &source)
+{
+    SourceStamp stamp;
+    stamp.Size = source.Size();
+    stamp.ModificationTime = source.ModificationTime();
+    stamp.Hash = HashBytes(source.Data(), source.Size());
+    return stamp;
+}
+
+std::string GetCacheFileName(const char *source_file_name, const std::string &suffix)
+{
+    std::string name = source_file_name;
+
+    // Replace the extension, but only in the file name, not in the directories
+    const size_t dot = name.find_last_of('.');
+    const size_t slash = name.find_last_of("/\\");
+    if (dot != std::string::npos && (slash == std::string::npos || dot > slash))
+        name.erase(dot);
+    return name + suffix;
+}
+
+bool WriteCacheFile(const char *file_name, const std::function<bool(FILE *file)> &write)
+{
+    const std::string temporary_name = std::string(file_name) + ".tmp";
+    FILE *file = fopen(temporary_name.c_str(), "wb");
+    if (file == nullptr)
+        return false;
+
+    bool ok = write(file);
+    ok = (fclose(file) == 0) && ok;
+
+    // rename replaces an existing file on POSIX, on Windows it would fail
+    if (ok)
+    {
+#if defined(_WIN32)
+        ok = MoveFileExA(temporary_name.c_str(), file_name, MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+        ok = rename(temporary_name.c_str(), file_name) == 0;
+#endif
+    }
+    if (!ok)
+        remove(temporary_name.c_str());
+    return ok;
+}
+
+}
@@ -0,0 +1,41 @@
+#pragma once
+#ifndef INCLUDED_SOURCESTAMP_H
+#define INCLUDED_SOURCESTAMP_H
+
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+
+#include "mappedfile.h"
+
+namespace PV112
+{
+
+/// Identifies the content of the source file a cache was created from, an OBJ model or an image. The
+/// cache is used only if all three values still match.
+struct SourceStamp
+{
+    uint64_t Size;
+    int64_t ModificationTime;
+    uint64_t Hash;
+};
+
+/// Computes the stamp of an open source file, the whole content is hashed.
+SourceStamp GetSourceStamp(const MappedFile &source);
+
+/// Returns the name of a cache file stored next to its source file: the extension of the source is
+/// replaced by 'suffix' ("./obj_files/lion.obj", ".pvmesh" -> "./obj_files/lion.pvmesh"). Dots in the
+/// directories are not taken for the extension.
+std::string GetCacheFileName(const char *source_file_name, const std::string &suffix);
+
+/// Writes a cache file: 'write' writes the content to the open file and returns false if it fails. The
+/// content goes to a temporary file next to the cache first, which then replaces the cache in a single
+/// step, so an interrupted program never leaves a damaged or a missing cache behind.
+///
+/// Returns false if the file cannot be written, for example when the directory is read-only.
+bool WriteCacheFile(const char *file_name, const std::function<bool(FILE *file)> &write);
+
+}
+
+#endif	// INCLUDED_SOURCESTAMP_H
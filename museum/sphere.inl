@@ -1,366 +0,0 @@
-const int sphere_vertices_count = 325;
-const float sphere_vertices[sphere_vertices_count * 8] = {
-// Positions (3f), Normals (3f), Tex Coords (2f)
-	-0.000000f, -1.000000f,  0.000000f,		-0.000000f, -1.000000f,  0.000000f,		 0.000000f,  0.000000f,
-	 0.000000f, -1.000000f,  0.000000f,		 0.000000f, -1.000000f,  0.000000f,		 0.041667f,  0.000000f,
-	 0.000000f, -1.000000f,  0.000000f,		 0.000000f, -1.000000f,  0.000000f,		 0.083333f,  0.000000f,
-	 0.000000f, -1.000000f,  0.000000f,		 0.000000f, -1.000000f,  0.000000f,		 0.125000f,  0.000000f,
-	 0.000000f, -1.000000f,  0.000000f,		 0.000000f, -1.000000f,  0.000000f,		 0.166667f,  0.000000f,
-	 0.000000f, -1.000000f,  0.000000f,		 0.000000f, -1.000000f,  0.000000f,		 0.208333f,  0.000000f,
-	 0.000000f, -1.000000f,  0.000000f,		 0.000000f, -1.000000f,  0.000000f,		 0.250000f,  0.000000f,
-	 0.000000f, -1.000000f, -0.000000f,		 0.000000f, -1.000000f, -0.000000f,		 0.291667f,  0.000000f,
-	 0.000000f, -1.000000f, -0.000000f,		 0.000000f, -1.000000f, -0.000000f,		 0.333333f,  0.000000f,
-	 0.000000f, -1.000000f, -0.000000f,		 0.000000f, -1.000000f, -0.000000f,		 0.375000f,  0.000000f,
-	 0.000000f, -1.000000f, -0.000000f,		 0.000000f, -1.000000f, -0.000000f,		 0.416667f,  0.000000f,
-	 0.000000f, -1.000000f, -0.000000f,		 0.000000f, -1.000000f, -0.000000f,		 0.458333f,  0.000000f,
-	-0.000000f, -1.000000f, -0.000000f,		-0.000000f, -1.000000f, -0.000000f,		 0.500000f,  0.000000f,
-	-0.000000f, -1.000000f, -0.000000f,		-0.000000f, -1.000000f, -0.000000f,		 0.541667f,  0.000000f,
-	-0.000000f, -1.000000f, -0.000000f,		-0.000000f, -1.000000f, -0.000000f,		 0.583333f,  0.000000f,
-	-0.000000f, -1.000000f, -0.000000f,		-0.000000f, -1.000000f, -0.000000f,		 0.625000f,  0.000000f,
-	-0.000000f, -1.000000f, -0.000000f,		-0.000000f, -1.000000f, -0.000000f,		 0.666667f,  0.000000f,
-	-0.000000f, -1.000000f, -0.000000f,		-0.000000f, -1.000000f, -0.000000f,		 0.708333f,  0.000000f,
-	-0.000000f, -1.000000f, -0.000000f,		-0.000000f, -1.000000f, -0.000000f,		 0.750000f,  0.000000f,
-	-0.000000f, -1.000000f,  0.000000f,		-0.000000f, -1.000000f,  0.000000f,		 0.791667f,  0.000000f,
-	-0.000000f, -1.000000f,  0.000000f,		-0.000000f, -1.000000f,  0.000000f,		 0.833333f,  0.000000f,
-	-0.000000f, -1.000000f,  0.000000f,		-0.000000f, -1.000000f,  0.000000f,		 0.875000f,  0.000000f,
-	-0.000000f, -1.000000f,  0.000000f,		-0.000000f, -1.000000f,  0.000000f,		 0.916667f,  0.000000f,
-	-0.000000f, -1.000000f,  0.000000f,		-0.000000f, -1.000000f,  0.000000f,		 0.958333f,  0.000000f,
-	 0.000000f, -1.000000f,  0.000000f,		 0.000000f, -1.000000f,  0.000000f,		 1.000000f,  0.000000f,
-	 0.000000f, -0.965926f, -0.258819f,		 0.000000f, -0.965926f, -0.258819f,		 0.000000f,  0.083333f,
-	-0.066987f, -0.965926f, -0.250000f,		-0.066987f, -0.965926f, -0.250000f,		 0.041667f,  0.083333f,
-	-0.129410f, -0.965926f, -0.224144f,		-0.129410f, -0.965926f, -0.224144f,		 0.083333f,  0.083333f,
-	-0.183013f, -0.965926f, -0.183013f,		-0.183013f, -0.965926f, -0.183013f,		 0.125000f,  0.083333f,
-	-0.224144f, -0.965926f, -0.129410f,		-0.224144f, -0.965926f, -0.129410f,		 0.166667f,  0.083333f,
-	-0.250000f, -0.965926f, -0.066987f,		-0.250000f, -0.965926f, -0.066987f,		 0.208333f,  0.083333f,
-	-0.258819f, -0.965926f, -0.000000f,		-0.258819f, -0.965926f, -0.000000f,		 0.250000f,  0.083333f,
-	-0.250000f, -0.965926f,  0.066987f,		-0.250000f, -0.965926f,  0.066987f,		 0.291667f,  0.083333f,
-	-0.224144f, -0.965926f,  0.129410f,		-0.224144f, -0.965926f,  0.129410f,		 0.333333f,  0.083333f,
-	-0.183013f, -0.965926f,  0.183013f,		-0.183013f, -0.965926f,  0.183013f,		 0.375000f,  0.083333f,
-	-0.129410f, -0.965926f,  0.224144f,		-0.129410f, -0.965926f,  0.224144f,		 0.416667f,  0.083333f,
-	-0.066987f, -0.965926f,  0.250000f,		-0.066987f, -0.965926f,  0.250000f,		 0.458333f,  0.083333f,
-	 0.000000f, -0.965926f,  0.258819f,		 0.000000f, -0.965926f,  0.258819f,		 0.500000f,  0.083333f,
-	 0.066987f, -0.965926f,  0.250000f,		 0.066987f, -0.965926f,  0.250000f,		 0.541667f,  0.083333f,
-	 0.129410f, -0.965926f,  0.224144f,		 0.129410f, -0.965926f,  0.224144f,		 0.583333f,  0.083333f,
-	 0.183013f, -0.965926f,  0.183013f,		 0.183013f, -0.965926f,  0.183013f,		 0.625000f,  0.083333f,
-	 0.224144f, -0.965926f,  0.129410f,		 0.224144f, -0.965926f,  0.129410f,		 0.666667f,  0.083333f,
-	 0.250000f, -0.965926f,  0.066987f,		 0.250000f, -0.965926f,  0.066987f,		 0.708333f,  0.083333f,
-	 0.258819f, -0.965926f,  0.000000f,		 0.258819f, -0.965926f,  0.000000f,		 0.750000f,  0.083333f,
-	 0.250000f, -0.965926f, -0.066987f,		 0.250000f, -0.965926f, -0.066987f,		 0.791667f,  0.083333f,
-	 0.224144f, -0.965926f, -0.129409f,		 0.224144f, -0.965926f, -0.129409f,		 0.833333f,  0.083333f,
-	 0.183013f, -0.965926f, -0.183013f,		 0.183013f, -0.965926f, -0.183013f,		 0.875000f,  0.083333f,
-	 0.129409f, -0.965926f, -0.224144f,		 0.129409f, -0.965926f, -0.224144f,		 0.916667f,  0.083333f,
-	 0.066987f, -0.965926f, -0.250000f,		 0.066987f, -0.965926f, -0.250000f,		 0.958333f,  0.083333f,
-	-0.000000f, -0.965926f, -0.258819f,		-0.000000f, -0.965926f, -0.258819f,		 1.000000f,  0.083333f,
-	 0.000000f, -0.866025f, -0.500000f,		 0.000000f, -0.866025f, -0.500000f,		 0.000000f,  0.166667f,
-	-0.129409f, -0.866025f, -0.482963f,		-0.129409f, -0.866025f, -0.482963f,		 0.041667f,  0.166667f,
-	-0.250000f, -0.866025f, -0.433013f,		-0.250000f, -0.866025f, -0.433013f,		 0.083333f,  0.166667f,
-	-0.353553f, -0.866025f, -0.353553f,		-0.353553f, -0.866025f, -0.353553f,		 0.125000f,  0.166667f,
-	-0.433013f, -0.866025f, -0.250000f,		-0.433013f, -0.866025f, -0.250000f,		 0.166667f,  0.166667f,
-	-0.482963f, -0.866025f, -0.129410f,		-0.482963f, -0.866025f, -0.129410f,		 0.208333f,  0.166667f,
-	-0.500000f, -0.866025f, -0.000000f,		-0.500000f, -0.866025f, -0.000000f,		 0.250000f,  0.166667f,
-	-0.482963f, -0.866025f,  0.129409f,		-0.482963f, -0.866025f,  0.129409f,		 0.291667f,  0.166667f,
-	-0.433013f, -0.866025f,  0.250000f,		-0.433013f, -0.866025f,  0.250000f,		 0.333333f,  0.166667f,
-	-0.353553f, -0.866025f,  0.353553f,		-0.353553f, -0.866025f,  0.353553f,		 0.375000f,  0.166667f,
-	-0.250000f, -0.866025f,  0.433013f,		-0.250000f, -0.866025f,  0.433013f,		 0.416667f,  0.166667f,
-	-0.129409f, -0.866025f,  0.482963f,		-0.129409f, -0.866025f,  0.482963f,		 0.458333f,  0.166667f,
-	 0.000000f, -0.866025f,  0.500000f,		 0.000000f, -0.866025f,  0.500000f,		 0.500000f,  0.166667f,
-	 0.129410f, -0.866025f,  0.482963f,		 0.129410f, -0.866025f,  0.482963f,		 0.541667f,  0.166667f,
-	 0.250000f, -0.866025f,  0.433013f,		 0.250000f, -0.866025f,  0.433013f,		 0.583333f,  0.166667f,
-	 0.353553f, -0.866025f,  0.353553f,		 0.353553f, -0.866025f,  0.353553f,		 0.625000f,  0.166667f,
-	 0.433013f, -0.866025f,  0.250000f,		 0.433013f, -0.866025f,  0.250000f,		 0.666667f,  0.166667f,
-	 0.482963f, -0.866025f,  0.129410f,		 0.482963f, -0.866025f,  0.129410f,		 0.708333f,  0.166667f,
-	 0.500000f, -0.866025f,  0.000000f,		 0.500000f, -0.866025f,  0.000000f,		 0.750000f,  0.166667f,
-	 0.482963f, -0.866025f, -0.129410f,		 0.482963f, -0.866025f, -0.129410f,		 0.791667f,  0.166667f,
-	 0.433013f, -0.866025f, -0.250000f,		 0.433013f, -0.866025f, -0.250000f,		 0.833333f,  0.166667f,
-	 0.353553f, -0.866025f, -0.353553f,		 0.353553f, -0.866025f, -0.353553f,		 0.875000f,  0.166667f,
-	 0.250000f, -0.866025f, -0.433013f,		 0.250000f, -0.866025f, -0.433013f,		 0.916667f,  0.166667f,
-	 0.129409f, -0.866025f, -0.482963f,		 0.129409f, -0.866025f, -0.482963f,		 0.958333f,  0.166667f,
-	-0.000000f, -0.866025f, -0.500000f,		-0.000000f, -0.866025f, -0.500000f,		 1.000000f,  0.166667f,
-	 0.000000f, -0.707107f, -0.707107f,		 0.000000f, -0.707107f, -0.707107f,		 0.000000f,  0.250000f,
-	-0.183013f, -0.707107f, -0.683013f,		-0.183013f, -0.707107f, -0.683013f,		 0.041667f,  0.250000f,
-	-0.353553f, -0.707107f, -0.612372f,		-0.353553f, -0.707107f, -0.612372f,		 0.083333f,  0.250000f,
-	-0.500000f, -0.707107f, -0.500000f,		-0.500000f, -0.707107f, -0.500000f,		 0.125000f,  0.250000f,
-	-0.612372f, -0.707107f, -0.353553f,		-0.612372f, -0.707107f, -0.353553f,		 0.166667f,  0.250000f,
-	-0.683013f, -0.707107f, -0.183013f,		-0.683013f, -0.707107f, -0.183013f,		 0.208333f,  0.250000f,
-	-0.707107f, -0.707107f, -0.000000f,		-0.707107f, -0.707107f, -0.000000f,		 0.250000f,  0.250000f,
-	-0.683013f, -0.707107f,  0.183013f,		-0.683013f, -0.707107f,  0.183013f,		 0.291667f,  0.250000f,
-	-0.612372f, -0.707107f,  0.353553f,		-0.612372f, -0.707107f,  0.353553f,		 0.333333f,  0.250000f,
-	-0.500000f, -0.707107f,  0.500000f,		-0.500000f, -0.707107f,  0.500000f,		 0.375000f,  0.250000f,
-	-0.353553f, -0.707107f,  0.612372f,		-0.353553f, -0.707107f,  0.612372f,		 0.416667f,  0.250000f,
-	-0.183013f, -0.707107f,  0.683013f,		-0.183013f, -0.707107f,  0.683013f,		 0.458333f,  0.250000f,
-	 0.000000f, -0.707107f,  0.707107f,		 0.000000f, -0.707107f,  0.707107f,		 0.500000f,  0.250000f,
-	 0.183013f, -0.707107f,  0.683013f,		 0.183013f, -0.707107f,  0.683013f,		 0.541667f,  0.250000f,
-	 0.353553f, -0.707107f,  0.612372f,		 0.353553f, -0.707107f,  0.612372f,		 0.583333f,  0.250000f,
-	 0.500000f, -0.707107f,  0.500000f,		 0.500000f, -0.707107f,  0.500000f,		 0.625000f,  0.250000f,
-	 0.612372f, -0.707107f,  0.353553f,		 0.612372f, -0.707107f,  0.353553f,		 0.666667f,  0.250000f,
-	 0.683013f, -0.707107f,  0.183013f,		 0.683013f, -0.707107f,  0.183013f,		 0.708333f,  0.250000f,
-	 0.707107f, -0.707107f,  0.000000f,		 0.707107f, -0.707107f,  0.000000f,		 0.750000f,  0.250000f,
-	 0.683013f, -0.707107f, -0.183013f,		 0.683013f, -0.707107f, -0.183013f,		 0.791667f,  0.250000f,
-	 0.612373f, -0.707107f, -0.353553f,		 0.612373f, -0.707107f, -0.353553f,		 0.833333f,  0.250000f,
-	 0.500000f, -0.707107f, -0.500000f,		 0.500000f, -0.707107f, -0.500000f,		 0.875000f,  0.250000f,
-	 0.353553f, -0.707107f, -0.612373f,		 0.353553f, -0.707107f, -0.612373f,		 0.916667f,  0.250000f,
-	 0.183013f, -0.707107f, -0.683013f,		 0.183013f, -0.707107f, -0.683013f,		 0.958333f,  0.250000f,
-	-0.000000f, -0.707107f, -0.707107f,		-0.000000f, -0.707107f, -0.707107f,		 1.000000f,  0.250000f,
-	 0.000000f, -0.500000f, -0.866025f,		 0.000000f, -0.500000f, -0.866025f,		 0.000000f,  0.333333f,
-	-0.224144f, -0.500000f, -0.836516f,		-0.224144f, -0.500000f, -0.836516f,		 0.041667f,  0.333333f,
-	-0.433013f, -0.500000f, -0.750000f,		-0.433013f, -0.500000f, -0.750000f,		 0.083333f,  0.333333f,
-	-0.612372f, -0.500000f, -0.612372f,		-0.612372f, -0.500000f, -0.612372f,		 0.125000f,  0.333333f,
-	-0.750000f, -0.500000f, -0.433013f,		-0.750000f, -0.500000f, -0.433013f,		 0.166667f,  0.333333f,
-	-0.836516f, -0.500000f, -0.224144f,		-0.836516f, -0.500000f, -0.224144f,		 0.208333f,  0.333333f,
-	-0.866025f, -0.500000f, -0.000000f,		-0.866025f, -0.500000f, -0.000000f,		 0.250000f,  0.333333f,
-	-0.836516f, -0.500000f,  0.224144f,		-0.836516f, -0.500000f,  0.224144f,		 0.291667f,  0.333333f,
-	-0.750000f, -0.500000f,  0.433013f,		-0.750000f, -0.500000f,  0.433013f,		 0.333333f,  0.333333f,
-	-0.612372f, -0.500000f,  0.612372f,		-0.612372f, -0.500000f,  0.612372f,		 0.375000f,  0.333333f,
-	-0.433013f, -0.500000f,  0.750000f,		-0.433013f, -0.500000f,  0.750000f,		 0.416667f,  0.333333f,
-	-0.224144f, -0.500000f,  0.836516f,		-0.224144f, -0.500000f,  0.836516f,		 0.458333f,  0.333333f,
-	 0.000000f, -0.500000f,  0.866025f,		 0.000000f, -0.500000f,  0.866025f,		 0.500000f,  0.333333f,
-	 0.224144f, -0.500000f,  0.836516f,		 0.224144f, -0.500000f,  0.836516f,		 0.541667f,  0.333333f,
-	 0.433013f, -0.500000f,  0.750000f,		 0.433013f, -0.500000f,  0.750000f,		 0.583333f,  0.333333f,
-	 0.612372f, -0.500000f,  0.612372f,		 0.612372f, -0.500000f,  0.612372f,		 0.625000f,  0.333333f,
-	 0.750000f, -0.500000f,  0.433013f,		 0.750000f, -0.500000f,  0.433013f,		 0.666667f,  0.333333f,
-	 0.836516f, -0.500000f,  0.224144f,		 0.836516f, -0.500000f,  0.224144f,		 0.708333f,  0.333333f,
-	 0.866025f, -0.500000f,  0.000000f,		 0.866025f, -0.500000f,  0.000000f,		 0.750000f,  0.333333f,
-	 0.836516f, -0.500000f, -0.224144f,		 0.836516f, -0.500000f, -0.224144f,		 0.791667f,  0.333333f,
-	 0.750000f, -0.500000f, -0.433013f,		 0.750000f, -0.500000f, -0.433013f,		 0.833333f,  0.333333f,
-	 0.612372f, -0.500000f, -0.612373f,		 0.612372f, -0.500000f, -0.612373f,		 0.875000f,  0.333333f,
-	 0.433013f, -0.500000f, -0.750000f,		 0.433013f, -0.500000f, -0.750000f,		 0.916667f,  0.333333f,
-	 0.224144f, -0.500000f, -0.836516f,		 0.224144f, -0.500000f, -0.836516f,		 0.958333f,  0.333333f,
-	-0.000000f, -0.500000f, -0.866025f,		-0.000000f, -0.500000f, -0.866025f,		 1.000000f,  0.333333f,
-	 0.000000f, -0.258819f, -0.965926f,		 0.000000f, -0.258819f, -0.965926f,		 0.000000f,  0.416667f,
-	-0.250000f, -0.258819f, -0.933013f,		-0.250000f, -0.258819f, -0.933013f,		 0.041667f,  0.416667f,
-	-0.482963f, -0.258819f, -0.836516f,		-0.482963f, -0.258819f, -0.836516f,		 0.083333f,  0.416667f,
-	-0.683013f, -0.258819f, -0.683013f,		-0.683013f, -0.258819f, -0.683013f,		 0.125000f,  0.416667f,
-	-0.836516f, -0.258819f, -0.482963f,		-0.836516f, -0.258819f, -0.482963f,		 0.166667f,  0.416667f,
-	-0.933013f, -0.258819f, -0.250000f,		-0.933013f, -0.258819f, -0.250000f,		 0.208333f,  0.416667f,
-	-0.965926f, -0.258819f, -0.000000f,		-0.965926f, -0.258819f, -0.000000f,		 0.250000f,  0.416667f,
-	-0.933013f, -0.258819f,  0.250000f,		-0.933013f, -0.258819f,  0.250000f,		 0.291667f,  0.416667f,
-	-0.836516f, -0.258819f,  0.482963f,		-0.836516f, -0.258819f,  0.482963f,		 0.333333f,  0.416667f,
-	-0.683013f, -0.258819f,  0.683013f,		-0.683013f, -0.258819f,  0.683013f,		 0.375000f,  0.416667f,
-	-0.482963f, -0.258819f,  0.836516f,		-0.482963f, -0.258819f,  0.836516f,		 0.416667f,  0.416667f,
-	-0.250000f, -0.258819f,  0.933013f,		-0.250000f, -0.258819f,  0.933013f,		 0.458333f,  0.416667f,
-	 0.000000f, -0.258819f,  0.965926f,		 0.000000f, -0.258819f,  0.965926f,		 0.500000f,  0.416667f,
-	 0.250000f, -0.258819f,  0.933013f,		 0.250000f, -0.258819f,  0.933013f,		 0.541667f,  0.416667f,
-	 0.482963f, -0.258819f,  0.836516f,		 0.482963f, -0.258819f,  0.836516f,		 0.583333f,  0.416667f,
-	 0.683013f, -0.258819f,  0.683013f,		 0.683013f, -0.258819f,  0.683013f,		 0.625000f,  0.416667f,
-	 0.836516f, -0.258819f,  0.482963f,		 0.836516f, -0.258819f,  0.482963f,		 0.666667f,  0.416667f,
-	 0.933013f, -0.258819f,  0.250000f,		 0.933013f, -0.258819f,  0.250000f,		 0.708333f,  0.416667f,
-	 0.965926f, -0.258819f,  0.000000f,		 0.965926f, -0.258819f,  0.000000f,		 0.750000f,  0.416667f,
-	 0.933013f, -0.258819f, -0.250000f,		 0.933013f, -0.258819f, -0.250000f,		 0.791667f,  0.416667f,
-	 0.836516f, -0.258819f, -0.482963f,		 0.836516f, -0.258819f, -0.482963f,		 0.833333f,  0.416667f,
-	 0.683012f, -0.258819f, -0.683013f,		 0.683012f, -0.258819f, -0.683013f,		 0.875000f,  0.416667f,
-	 0.482963f, -0.258819f, -0.836516f,		 0.482963f, -0.258819f, -0.836516f,		 0.916667f,  0.416667f,
-	 0.250000f, -0.258819f, -0.933013f,		 0.250000f, -0.258819f, -0.933013f,		 0.958333f,  0.416667f,
-	-0.000000f, -0.258819f, -0.965926f,		-0.000000f, -0.258819f, -0.965926f,		 1.000000f,  0.416667f,
-	 0.000000f,  0.000000f, -1.000000f,		 0.000000f,  0.000000f, -1.000000f,		 0.000000f,  0.500000f,
-	-0.258819f,  0.000000f, -0.965926f,		-0.258819f,  0.000000f, -0.965926f,		 0.041667f,  0.500000f,
-	-0.500000f,  0.000000f, -0.866025f,		-0.500000f,  0.000000f, -0.866025f,		 0.083333f,  0.500000f,
-	-0.707107f,  0.000000f, -0.707107f,		-0.707107f,  0.000000f, -0.707107f,		 0.125000f,  0.500000f,
-	-0.866025f,  0.000000f, -0.500000f,		-0.866025f,  0.000000f, -0.500000f,		 0.166667f,  0.500000f,
-	-0.965926f,  0.000000f, -0.258819f,		-0.965926f,  0.000000f, -0.258819f,		 0.208333f,  0.500000f,
-	-1.000000f,  0.000000f, -0.000000f,		-1.000000f,  0.000000f, -0.000000f,		 0.250000f,  0.500000f,
-	-0.965926f,  0.000000f,  0.258819f,		-0.965926f,  0.000000f,  0.258819f,		 0.291667f,  0.500000f,
-	-0.866025f,  0.000000f,  0.500000f,		-0.866025f,  0.000000f,  0.500000f,		 0.333333f,  0.500000f,
-	-0.707107f,  0.000000f,  0.707107f,		-0.707107f,  0.000000f,  0.707107f,		 0.375000f,  0.500000f,
-	-0.500000f,  0.000000f,  0.866025f,		-0.500000f,  0.000000f,  0.866025f,		 0.416667f,  0.500000f,
-	-0.258819f,  0.000000f,  0.965926f,		-0.258819f,  0.000000f,  0.965926f,		 0.458333f,  0.500000f,
-	 0.000000f,  0.000000f,  1.000000f,		 0.000000f,  0.000000f,  1.000000f,		 0.500000f,  0.500000f,
-	 0.258819f,  0.000000f,  0.965926f,		 0.258819f,  0.000000f,  0.965926f,		 0.541667f,  0.500000f,
-	 0.500000f,  0.000000f,  0.866025f,		 0.500000f,  0.000000f,  0.866025f,		 0.583333f,  0.500000f,
-	 0.707107f,  0.000000f,  0.707107f,		 0.707107f,  0.000000f,  0.707107f,		 0.625000f,  0.500000f,
-	 0.866025f,  0.000000f,  0.500000f,		 0.866025f,  0.000000f,  0.500000f,		 0.666667f,  0.500000f,
-	 0.965926f,  0.000000f,  0.258819f,		 0.965926f,  0.000000f,  0.258819f,		 0.708333f,  0.500000f,
-	 1.000000f,  0.000000f,  0.000000f,		 1.000000f,  0.000000f,  0.000000f,		 0.750000f,  0.500000f,
-	 0.965926f,  0.000000f, -0.258819f,		 0.965926f,  0.000000f, -0.258819f,		 0.791667f,  0.500000f,
-	 0.866026f,  0.000000f, -0.500000f,		 0.866026f,  0.000000f, -0.500000f,		 0.833333f,  0.500000f,
-	 0.707107f,  0.000000f, -0.707107f,		 0.707107f,  0.000000f, -0.707107f,		 0.875000f,  0.500000f,
-	 0.500000f,  0.000000f, -0.866026f,		 0.500000f,  0.000000f, -0.866026f,		 0.916667f,  0.500000f,
-	 0.258819f,  0.000000f, -0.965926f,		 0.258819f,  0.000000f, -0.965926f,		 0.958333f,  0.500000f,
-	-0.000000f,  0.000000f, -1.000000f,		-0.000000f,  0.000000f, -1.000000f,		 1.000000f,  0.500000f,
-	 0.000000f,  0.258819f, -0.965926f,		 0.000000f,  0.258819f, -0.965926f,		 0.000000f,  0.583333f,
-	-0.250000f,  0.258819f, -0.933013f,		-0.250000f,  0.258819f, -0.933013f,		 0.041667f,  0.583333f,
-	-0.482963f,  0.258819f, -0.836516f,		-0.482963f,  0.258819f, -0.836516f,		 0.083333f,  0.583333f,
-	-0.683013f,  0.258819f, -0.683013f,		-0.683013f,  0.258819f, -0.683013f,		 0.125000f,  0.583333f,
-	-0.836516f,  0.258819f, -0.482963f,		-0.836516f,  0.258819f, -0.482963f,		 0.166667f,  0.583333f,
-	-0.933013f,  0.258819f, -0.250000f,		-0.933013f,  0.258819f, -0.250000f,		 0.208333f,  0.583333f,
-	-0.965926f,  0.258819f, -0.000000f,		-0.965926f,  0.258819f, -0.000000f,		 0.250000f,  0.583333f,
-	-0.933013f,  0.258819f,  0.250000f,		-0.933013f,  0.258819f,  0.250000f,		 0.291667f,  0.583333f,
-	-0.836516f,  0.258819f,  0.482963f,		-0.836516f,  0.258819f,  0.482963f,		 0.333333f,  0.583333f,
-	-0.683013f,  0.258819f,  0.683013f,		-0.683013f,  0.258819f,  0.683013f,		 0.375000f,  0.583333f,
-	-0.482963f,  0.258819f,  0.836516f,		-0.482963f,  0.258819f,  0.836516f,		 0.416667f,  0.583333f,
-	-0.250000f,  0.258819f,  0.933013f,		-0.250000f,  0.258819f,  0.933013f,		 0.458333f,  0.583333f,
-	 0.000000f,  0.258819f,  0.965926f,		 0.000000f,  0.258819f,  0.965926f,		 0.500000f,  0.583333f,
-	 0.250000f,  0.258819f,  0.933013f,		 0.250000f,  0.258819f,  0.933013f,		 0.541667f,  0.583333f,
-	 0.482963f,  0.258819f,  0.836516f,		 0.482963f,  0.258819f,  0.836516f,		 0.583333f,  0.583333f,
-	 0.683013f,  0.258819f,  0.683013f,		 0.683013f,  0.258819f,  0.683013f,		 0.625000f,  0.583333f,
-	 0.836516f,  0.258819f,  0.482963f,		 0.836516f,  0.258819f,  0.482963f,		 0.666667f,  0.583333f,
-	 0.933013f,  0.258819f,  0.250000f,		 0.933013f,  0.258819f,  0.250000f,		 0.708333f,  0.583333f,
-	 0.965926f,  0.258819f,  0.000000f,		 0.965926f,  0.258819f,  0.000000f,		 0.750000f,  0.583333f,
-	 0.933013f,  0.258819f, -0.250000f,		 0.933013f,  0.258819f, -0.250000f,		 0.791667f,  0.583333f,
-	 0.836516f,  0.258819f, -0.482963f,		 0.836516f,  0.258819f, -0.482963f,		 0.833333f,  0.583333f,
-	 0.683012f,  0.258819f, -0.683013f,		 0.683012f,  0.258819f, -0.683013f,		 0.875000f,  0.583333f,
-	 0.482963f,  0.258819f, -0.836516f,		 0.482963f,  0.258819f, -0.836516f,		 0.916667f,  0.583333f,
-	 0.250000f,  0.258819f, -0.933013f,		 0.250000f,  0.258819f, -0.933013f,		 0.958333f,  0.583333f,
-	-0.000000f,  0.258819f, -0.965926f,		-0.000000f,  0.258819f, -0.965926f,		 1.000000f,  0.583333f,
-	 0.000000f,  0.500000f, -0.866025f,		 0.000000f,  0.500000f, -0.866025f,		 0.000000f,  0.666667f,
-	-0.224144f,  0.500000f, -0.836516f,		-0.224144f,  0.500000f, -0.836516f,		 0.041667f,  0.666667f,
-	-0.433013f,  0.500000f, -0.750000f,		-0.433013f,  0.500000f, -0.750000f,		 0.083333f,  0.666667f,
-	-0.612372f,  0.500000f, -0.612372f,		-0.612372f,  0.500000f, -0.612372f,		 0.125000f,  0.666667f,
-	-0.750000f,  0.500000f, -0.433013f,		-0.750000f,  0.500000f, -0.433013f,		 0.166667f,  0.666667f,
-	-0.836516f,  0.500000f, -0.224144f,		-0.836516f,  0.500000f, -0.224144f,		 0.208333f,  0.666667f,
-	-0.866025f,  0.500000f, -0.000000f,		-0.866025f,  0.500000f, -0.000000f,		 0.250000f,  0.666667f,
-	-0.836516f,  0.500000f,  0.224144f,		-0.836516f,  0.500000f,  0.224144f,		 0.291667f,  0.666667f,
-	-0.750000f,  0.500000f,  0.433013f,		-0.750000f,  0.500000f,  0.433013f,		 0.333333f,  0.666667f,
-	-0.612372f,  0.500000f,  0.612372f,		-0.612372f,  0.500000f,  0.612372f,		 0.375000f,  0.666667f,
-	-0.433013f,  0.500000f,  0.750000f,		-0.433013f,  0.500000f,  0.750000f,		 0.416667f,  0.666667f,
-	-0.224144f,  0.500000f,  0.836516f,		-0.224144f,  0.500000f,  0.836516f,		 0.458333f,  0.666667f,
-	 0.000000f,  0.500000f,  0.866025f,		 0.000000f,  0.500000f,  0.866025f,		 0.500000f,  0.666667f,
-	 0.224144f,  0.500000f,  0.836516f,		 0.224144f,  0.500000f,  0.836516f,		 0.541667f,  0.666667f,
-	 0.433013f,  0.500000f,  0.750000f,		 0.433013f,  0.500000f,  0.750000f,		 0.583333f,  0.666667f,
-	 0.612372f,  0.500000f,  0.612372f,		 0.612372f,  0.500000f,  0.612372f,		 0.625000f,  0.666667f,
-	 0.750000f,  0.500000f,  0.433013f,		 0.750000f,  0.500000f,  0.433013f,		 0.666667f,  0.666667f,
-	 0.836516f,  0.500000f,  0.224144f,		 0.836516f,  0.500000f,  0.224144f,		 0.708333f,  0.666667f,
-	 0.866025f,  0.500000f,  0.000000f,		 0.866025f,  0.500000f,  0.000000f,		 0.750000f,  0.666667f,
-	 0.836516f,  0.500000f, -0.224144f,		 0.836516f,  0.500000f, -0.224144f,		 0.791667f,  0.666667f,
-	 0.750000f,  0.500000f, -0.433013f,		 0.750000f,  0.500000f, -0.433013f,		 0.833333f,  0.666667f,
-	 0.612372f,  0.500000f, -0.612373f,		 0.612372f,  0.500000f, -0.612373f,		 0.875000f,  0.666667f,
-	 0.433013f,  0.500000f, -0.750000f,		 0.433013f,  0.500000f, -0.750000f,		 0.916667f,  0.666667f,
-	 0.224144f,  0.500000f, -0.836516f,		 0.224144f,  0.500000f, -0.836516f,		 0.958333f,  0.666667f,
-	-0.000000f,  0.500000f, -0.866025f,		-0.000000f,  0.500000f, -0.866025f,		 1.000000f,  0.666667f,
-	 0.000000f,  0.707107f, -0.707107f,		 0.000000f,  0.707107f, -0.707107f,		 0.000000f,  0.750000f,
-	-0.183013f,  0.707107f, -0.683013f,		-0.183013f,  0.707107f, -0.683013f,		 0.041667f,  0.750000f,
-	-0.353553f,  0.707107f, -0.612372f,		-0.353553f,  0.707107f, -0.612372f,		 0.083333f,  0.750000f,
-	-0.500000f,  0.707107f, -0.500000f,		-0.500000f,  0.707107f, -0.500000f,		 0.125000f,  0.750000f,
-	-0.612372f,  0.707107f, -0.353553f,		-0.612372f,  0.707107f, -0.353553f,		 0.166667f,  0.750000f,
-	-0.683013f,  0.707107f, -0.183013f,		-0.683013f,  0.707107f, -0.183013f,		 0.208333f,  0.750000f,
-	-0.707107f,  0.707107f, -0.000000f,		-0.707107f,  0.707107f, -0.000000f,		 0.250000f,  0.750000f,
-	-0.683013f,  0.707107f,  0.183013f,		-0.683013f,  0.707107f,  0.183013f,		 0.291667f,  0.750000f,
-	-0.612373f,  0.707107f,  0.353553f,		-0.612373f,  0.707107f,  0.353553f,		 0.333333f,  0.750000f,
-	-0.500000f,  0.707107f,  0.500000f,		-0.500000f,  0.707107f,  0.500000f,		 0.375000f,  0.750000f,
-	-0.353554f,  0.707107f,  0.612372f,		-0.353554f,  0.707107f,  0.612372f,		 0.416667f,  0.750000f,
-	-0.183013f,  0.707107f,  0.683013f,		-0.183013f,  0.707107f,  0.683013f,		 0.458333f,  0.750000f,
-	 0.000000f,  0.707107f,  0.707107f,		 0.000000f,  0.707107f,  0.707107f,		 0.500000f,  0.750000f,
-	 0.183013f,  0.707107f,  0.683013f,		 0.183013f,  0.707107f,  0.683013f,		 0.541667f,  0.750000f,
-	 0.353553f,  0.707107f,  0.612373f,		 0.353553f,  0.707107f,  0.612373f,		 0.583333f,  0.750000f,
-	 0.500000f,  0.707107f,  0.500000f,		 0.500000f,  0.707107f,  0.500000f,		 0.625000f,  0.750000f,
-	 0.612373f,  0.707107f,  0.353553f,		 0.612373f,  0.707107f,  0.353553f,		 0.666667f,  0.750000f,
-	 0.683013f,  0.707107f,  0.183013f,		 0.683013f,  0.707107f,  0.183013f,		 0.708333f,  0.750000f,
-	 0.707107f,  0.707107f,  0.000000f,		 0.707107f,  0.707107f,  0.000000f,		 0.750000f,  0.750000f,
-	 0.683013f,  0.707107f, -0.183013f,		 0.683013f,  0.707107f, -0.183013f,		 0.791667f,  0.750000f,
-	 0.612373f,  0.707107f, -0.353553f,		 0.612373f,  0.707107f, -0.353553f,		 0.833333f,  0.750000f,
-	 0.500000f,  0.707107f, -0.500000f,		 0.500000f,  0.707107f, -0.500000f,		 0.875000f,  0.750000f,
-	 0.353553f,  0.707107f, -0.612373f,		 0.353553f,  0.707107f, -0.612373f,		 0.916667f,  0.750000f,
-	 0.183013f,  0.707107f, -0.683013f,		 0.183013f,  0.707107f, -0.683013f,		 0.958333f,  0.750000f,
-	-0.000000f,  0.707107f, -0.707107f,		-0.000000f,  0.707107f, -0.707107f,		 1.000000f,  0.750000f,
-	 0.000000f,  0.866025f, -0.500000f,		 0.000000f,  0.866025f, -0.500000f,		 0.000000f,  0.833333f,
-	-0.129409f,  0.866025f, -0.482963f,		-0.129409f,  0.866025f, -0.482963f,		 0.041667f,  0.833333f,
-	-0.250000f,  0.866025f, -0.433013f,		-0.250000f,  0.866025f, -0.433013f,		 0.083333f,  0.833333f,
-	-0.353553f,  0.866025f, -0.353553f,		-0.353553f,  0.866025f, -0.353553f,		 0.125000f,  0.833333f,
-	-0.433013f,  0.866025f, -0.250000f,		-0.433013f,  0.866025f, -0.250000f,		 0.166667f,  0.833333f,
-	-0.482963f,  0.866025f, -0.129410f,		-0.482963f,  0.866025f, -0.129410f,		 0.208333f,  0.833333f,
-	-0.500000f,  0.866025f, -0.000000f,		-0.500000f,  0.866025f, -0.000000f,		 0.250000f,  0.833333f,
-	-0.482963f,  0.866025f,  0.129409f,		-0.482963f,  0.866025f,  0.129409f,		 0.291667f,  0.833333f,
-	-0.433013f,  0.866025f,  0.250000f,		-0.433013f,  0.866025f,  0.250000f,		 0.333333f,  0.833333f,
-	-0.353553f,  0.866025f,  0.353553f,		-0.353553f,  0.866025f,  0.353553f,		 0.375000f,  0.833333f,
-	-0.250000f,  0.866025f,  0.433013f,		-0.250000f,  0.866025f,  0.433013f,		 0.416667f,  0.833333f,
-	-0.129410f,  0.866025f,  0.482963f,		-0.129410f,  0.866025f,  0.482963f,		 0.458333f,  0.833333f,
-	 0.000000f,  0.866025f,  0.500000f,		 0.000000f,  0.866025f,  0.500000f,		 0.500000f,  0.833333f,
-	 0.129410f,  0.866025f,  0.482963f,		 0.129410f,  0.866025f,  0.482963f,		 0.541667f,  0.833333f,
-	 0.250000f,  0.866025f,  0.433013f,		 0.250000f,  0.866025f,  0.433013f,		 0.583333f,  0.833333f,
-	 0.353553f,  0.866025f,  0.353553f,		 0.353553f,  0.866025f,  0.353553f,		 0.625000f,  0.833333f,
-	 0.433013f,  0.866025f,  0.250000f,		 0.433013f,  0.866025f,  0.250000f,		 0.666667f,  0.833333f,
-	 0.482963f,  0.866025f,  0.129410f,		 0.482963f,  0.866025f,  0.129410f,		 0.708333f,  0.833333f,
-	 0.500000f,  0.866025f,  0.000000f,		 0.500000f,  0.866025f,  0.000000f,		 0.750000f,  0.833333f,
-	 0.482963f,  0.866025f, -0.129410f,		 0.482963f,  0.866025f, -0.129410f,		 0.791667f,  0.833333f,
-	 0.433013f,  0.866025f, -0.250000f,		 0.433013f,  0.866025f, -0.250000f,		 0.833333f,  0.833333f,
-	 0.353553f,  0.866025f, -0.353554f,		 0.353553f,  0.866025f, -0.353554f,		 0.875000f,  0.833333f,
-	 0.250000f,  0.866025f, -0.433013f,		 0.250000f,  0.866025f, -0.433013f,		 0.916667f,  0.833333f,
-	 0.129409f,  0.866025f, -0.482963f,		 0.129409f,  0.866025f, -0.482963f,		 0.958333f,  0.833333f,
-	-0.000000f,  0.866025f, -0.500000f,		-0.000000f,  0.866025f, -0.500000f,		 1.000000f,  0.833333f,
-	 0.000000f,  0.965926f, -0.258819f,		 0.000000f,  0.965926f, -0.258819f,		 0.000000f,  0.916667f,
-	-0.066987f,  0.965926f, -0.250000f,		-0.066987f,  0.965926f, -0.250000f,		 0.041667f,  0.916667f,
-	-0.129409f,  0.965926f, -0.224144f,		-0.129409f,  0.965926f, -0.224144f,		 0.083333f,  0.916667f,
-	-0.183013f,  0.965926f, -0.183013f,		-0.183013f,  0.965926f, -0.183013f,		 0.125000f,  0.916667f,
-	-0.224144f,  0.965926f, -0.129409f,		-0.224144f,  0.965926f, -0.129409f,		 0.166667f,  0.916667f,
-	-0.250000f,  0.965926f, -0.066987f,		-0.250000f,  0.965926f, -0.066987f,		 0.208333f,  0.916667f,
-	-0.258819f,  0.965926f, -0.000000f,		-0.258819f,  0.965926f, -0.000000f,		 0.250000f,  0.916667f,
-	-0.250000f,  0.965926f,  0.066987f,		-0.250000f,  0.965926f,  0.066987f,		 0.291667f,  0.916667f,
-	-0.224144f,  0.965926f,  0.129409f,		-0.224144f,  0.965926f,  0.129409f,		 0.333333f,  0.916667f,
-	-0.183013f,  0.965926f,  0.183013f,		-0.183013f,  0.965926f,  0.183013f,		 0.375000f,  0.916667f,
-	-0.129410f,  0.965926f,  0.224144f,		-0.129410f,  0.965926f,  0.224144f,		 0.416667f,  0.916667f,
-	-0.066987f,  0.965926f,  0.250000f,		-0.066987f,  0.965926f,  0.250000f,		 0.458333f,  0.916667f,
-	 0.000000f,  0.965926f,  0.258819f,		 0.000000f,  0.965926f,  0.258819f,		 0.500000f,  0.916667f,
-	 0.066987f,  0.965926f,  0.250000f,		 0.066987f,  0.965926f,  0.250000f,		 0.541667f,  0.916667f,
-	 0.129409f,  0.965926f,  0.224144f,		 0.129409f,  0.965926f,  0.224144f,		 0.583333f,  0.916667f,
-	 0.183013f,  0.965926f,  0.183013f,		 0.183013f,  0.965926f,  0.183013f,		 0.625000f,  0.916667f,
-	 0.224144f,  0.965926f,  0.129409f,		 0.224144f,  0.965926f,  0.129409f,		 0.666667f,  0.916667f,
-	 0.250000f,  0.965926f,  0.066987f,		 0.250000f,  0.965926f,  0.066987f,		 0.708333f,  0.916667f,
-	 0.258819f,  0.965926f,  0.000000f,		 0.258819f,  0.965926f,  0.000000f,		 0.750000f,  0.916667f,
-	 0.250000f,  0.965926f, -0.066987f,		 0.250000f,  0.965926f, -0.066987f,		 0.791667f,  0.916667f,
-	 0.224144f,  0.965926f, -0.129409f,		 0.224144f,  0.965926f, -0.129409f,		 0.833333f,  0.916667f,
-	 0.183013f,  0.965926f, -0.183013f,		 0.183013f,  0.965926f, -0.183013f,		 0.875000f,  0.916667f,
-	 0.129409f,  0.965926f, -0.224144f,		 0.129409f,  0.965926f, -0.224144f,		 0.916667f,  0.916667f,
-	 0.066987f,  0.965926f, -0.250000f,		 0.066987f,  0.965926f, -0.250000f,		 0.958333f,  0.916667f,
-	-0.000000f,  0.965926f, -0.258819f,		-0.000000f,  0.965926f, -0.258819f,		 1.000000f,  0.916667f,
-	-0.000000f,  1.000000f,  0.000000f,		-0.000000f,  1.000000f,  0.000000f,		 0.000000f,  1.000000f,
-	 0.000000f,  1.000000f,  0.000000f,		 0.000000f,  1.000000f,  0.000000f,		 0.041667f,  1.000000f,
-	 0.000000f,  1.000000f,  0.000000f,		 0.000000f,  1.000000f,  0.000000f,		 0.083333f,  1.000000f,
-	 0.000000f,  1.000000f,  0.000000f,		 0.000000f,  1.000000f,  0.000000f,		 0.125000f,  1.000000f,
-	 0.000000f,  1.000000f,  0.000000f,		 0.000000f,  1.000000f,  0.000000f,		 0.166667f,  1.000000f,
-	 0.000000f,  1.000000f,  0.000000f,		 0.000000f,  1.000000f,  0.000000f,		 0.208333f,  1.000000f,
-	 0.000000f,  1.000000f,  0.000000f,		 0.000000f,  1.000000f,  0.000000f,		 0.250000f,  1.000000f,
-	 0.000000f,  1.000000f, -0.000000f,		 0.000000f,  1.000000f, -0.000000f,		 0.291667f,  1.000000f,
-	 0.000000f,  1.000000f, -0.000000f,		 0.000000f,  1.000000f, -0.000000f,		 0.333333f,  1.000000f,
-	 0.000000f,  1.000000f, -0.000000f,		 0.000000f,  1.000000f, -0.000000f,		 0.375000f,  1.000000f,
-	 0.000000f,  1.000000f, -0.000000f,		 0.000000f,  1.000000f, -0.000000f,		 0.416667f,  1.000000f,
-	 0.000000f,  1.000000f, -0.000000f,		 0.000000f,  1.000000f, -0.000000f,		 0.458333f,  1.000000f,
-	-0.000000f,  1.000000f, -0.000000f,		-0.000000f,  1.000000f, -0.000000f,		 0.500000f,  1.000000f,
-	-0.000000f,  1.000000f, -0.000000f,		-0.000000f,  1.000000f, -0.000000f,		 0.541667f,  1.000000f,
-	-0.000000f,  1.000000f, -0.000000f,		-0.000000f,  1.000000f, -0.000000f,		 0.583333f,  1.000000f,
-	-0.000000f,  1.000000f, -0.000000f,		-0.000000f,  1.000000f, -0.000000f,		 0.625000f,  1.000000f,
-	-0.000000f,  1.000000f, -0.000000f,		-0.000000f,  1.000000f, -0.000000f,		 0.666667f,  1.000000f,
-	-0.000000f,  1.000000f, -0.000000f,		-0.000000f,  1.000000f, -0.000000f,		 0.708333f,  1.000000f,
-	-0.000000f,  1.000000f, -0.000000f,		-0.000000f,  1.000000f, -0.000000f,		 0.750000f,  1.000000f,
-	-0.000000f,  1.000000f,  0.000000f,		-0.000000f,  1.000000f,  0.000000f,		 0.791667f,  1.000000f,
-	-0.000000f,  1.000000f,  0.000000f,		-0.000000f,  1.000000f,  0.000000f,		 0.833333f,  1.000000f,
-	-0.000000f,  1.000000f,  0.000000f,		-0.000000f,  1.000000f,  0.000000f,		 0.875000f,  1.000000f,
-	-0.000000f,  1.000000f,  0.000000f,		-0.000000f,  1.000000f,  0.000000f,		 0.916667f,  1.000000f,
-	-0.000000f,  1.000000f,  0.000000f,		-0.000000f,  1.000000f,  0.000000f,		 0.958333f,  1.000000f,
-	 0.000000f,  1.000000f,  0.000000f,		 0.000000f,  1.000000f,  0.000000f,		 1.000000f,  1.000000f,
-};
-
-const int sphere_indices_count = 622;
-const unsigned int sphere_indices[sphere_indices_count] = {
-// Triangle strip
-	 25,   0,  26,   1,  27,   2,  28,   3,  29,   4,  30,   5,  31,   6,  32,   7,  33,   8,  34,   9, 
-	 35,  10,  36,  11,  37,  12,  38,  13,  39,  14,  40,  15,  41,  16,  42,  17,  43,  18,  44,  19, 
-	 45,  20,  46,  21,  47,  22,  48,  23,  49,  24,  24,  50,  50,  25,  51,  26,  52,  27,  53,  28, 
-	 54,  29,  55,  30,  56,  31,  57,  32,  58,  33,  59,  34,  60,  35,  61,  36,  62,  37,  63,  38, 
-	 64,  39,  65,  40,  66,  41,  67,  42,  68,  43,  69,  44,  70,  45,  71,  46,  72,  47,  73,  48, 
-	 74,  49,  49,  75,  75,  50,  76,  51,  77,  52,  78,  53,  79,  54,  80,  55,  81,  56,  82,  57, 
-	 83,  58,  84,  59,  85,  60,  86,  61,  87,  62,  88,  63,  89,  64,  90,  65,  91,  66,  92,  67, 
-	 93,  68,  94,  69,  95,  70,  96,  71,  97,  72,  98,  73,  99,  74,  74, 100, 100,  75, 101,  76, 
-	102,  77, 103,  78, 104,  79, 105,  80, 106,  81, 107,  82, 108,  83, 109,  84, 110,  85, 111,  86, 
-	112,  87, 113,  88, 114,  89, 115,  90, 116,  91, 117,  92, 118,  93, 119,  94, 120,  95, 121,  96, 
-	122,  97, 123,  98, 124,  99,  99, 125, 125, 100, 126, 101, 127, 102, 128, 103, 129, 104, 130, 105, 
-	131, 106, 132, 107, 133, 108, 134, 109, 135, 110, 136, 111, 137, 112, 138, 113, 139, 114, 140, 115, 
-	141, 116, 142, 117, 143, 118, 144, 119, 145, 120, 146, 121, 147, 122, 148, 123, 149, 124, 124, 150, 
-	150, 125, 151, 126, 152, 127, 153, 128, 154, 129, 155, 130, 156, 131, 157, 132, 158, 133, 159, 134, 
-	160, 135, 161, 136, 162, 137, 163, 138, 164, 139, 165, 140, 166, 141, 167, 142, 168, 143, 169, 144, 
-	170, 145, 171, 146, 172, 147, 173, 148, 174, 149, 149, 175, 175, 150, 176, 151, 177, 152, 178, 153, 
-	179, 154, 180, 155, 181, 156, 182, 157, 183, 158, 184, 159, 185, 160, 186, 161, 187, 162, 188, 163, 
-	189, 164, 190, 165, 191, 166, 192, 167, 193, 168, 194, 169, 195, 170, 196, 171, 197, 172, 198, 173, 
-	199, 174, 174, 200, 200, 175, 201, 176, 202, 177, 203, 178, 204, 179, 205, 180, 206, 181, 207, 182, 
-	208, 183, 209, 184, 210, 185, 211, 186, 212, 187, 213, 188, 214, 189, 215, 190, 216, 191, 217, 192, 
-	218, 193, 219, 194, 220, 195, 221, 196, 222, 197, 223, 198, 224, 199, 199, 225, 225, 200, 226, 201, 
-	227, 202, 228, 203, 229, 204, 230, 205, 231, 206, 232, 207, 233, 208, 234, 209, 235, 210, 236, 211, 
-	237, 212, 238, 213, 239, 214, 240, 215, 241, 216, 242, 217, 243, 218, 244, 219, 245, 220, 246, 221, 
-	247, 222, 248, 223, 249, 224, 224, 250, 250, 225, 251, 226, 252, 227, 253, 228, 254, 229, 255, 230, 
-	256, 231, 257, 232, 258, 233, 259, 234, 260, 235, 261, 236, 262, 237, 263, 238, 264, 239, 265, 240, 
-	266, 241, 267, 242, 268, 243, 269, 244, 270, 245, 271, 246, 272, 247, 273, 248, 274, 249, 249, 275, 
-	275, 250, 276, 251, 277, 252, 278, 253, 279, 254, 280, 255, 281, 256, 282, 257, 283, 258, 284, 259, 
-	285, 260, 286, 261, 287, 262, 288, 263, 289, 264, 290, 265, 291, 266, 292, 267, 293, 268, 294, 269, 
-	295, 270, 296, 271, 297, 272, 298, 273, 299, 274, 274, 300, 300, 275, 301, 276, 302, 277, 303, 278, 
-	304, 279, 305, 280, 306, 281, 307, 282, 308, 283, 309, 284, 310, 285, 311, 286, 312, 287, 313, 288, 
-	314, 289, 315, 290, 316, 291, 317, 292, 318, 293, 319, 294, 320, 295, 321, 296, 322, 297, 323, 298, 
-	324, 299, 
-};
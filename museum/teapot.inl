@@ -1,5 +1,5 @@
-const int teapot_vertices_count = 1568;
-const float teapot_vertices[teapot_vertices_count * 8] = {
+constexpr int teapot_vertices_count = 1568;
+constexpr float teapot_vertices[teapot_vertices_count * 8] = {
 // Positions (3f), Normals (3f), Tex Coords (2f)
 	 0.777778f,  1.333333f, -0.000000f,		-0.902860f, -0.429934f,  0.000000f,		 0.000000f,  0.000000f,
 	 0.750411f,  1.333333f,  0.208848f,		-0.871509f, -0.430442f, -0.234929f,		 0.166667f,  0.000000f,
@@ -1571,8 +1571,8 @@ const float teapot_vertices[teapot_vertices_count * 8] = {
 	 0.833333f,  0.083333f, -0.000000f,		 1.000000f,  0.000000f,  0.000000f,		 1.000000f,  1.000000f,
 };
 
-const int teapot_indices_count = 3070;
-const unsigned int teapot_indices[teapot_indices_count] = {
+constexpr int teapot_indices_count = 3070;
+constexpr unsigned int teapot_indices[teapot_indices_count] = {
 // Triangle strip
 	  7,   0,   8,   1,   9,   2,  10,   3,  11,   4,  12,   5,  13,   6,   6,  14,  14,   7,  15,   8, 
 	 16,   9,  17,  10,  18,  11,  19,  12,  20,  13,  13,  21,  21,  14,  22,  15,  23,  16,  24,  17, 
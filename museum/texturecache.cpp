@@ -0,0 +1,250 @@
+#include "texturecache.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace PV112
+{
+
+namespace
+{
+
+// Increase whenever the encoder or the content of the levels changes
+const uint32_t texture_cache_version = 2;
+
+const unsigned char ktx_identifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n' };
+const uint32_t ktx_endianness = 0x04030201;
+
+// The OpenGL constants KTX stores, the cache does not include the OpenGL headers
+const uint32_t gl_compressed_rgb_s3tc_dxt1 = 0x83F0;
+const uint32_t gl_compressed_rgba_s3tc_dxt5 = 0x83F3;
+const uint32_t gl_rgb = 0x1907;
+const uint32_t gl_rgba = 0x1908;
+
+// The header of KTX 1.1. The key/value data, and then every level as its size followed by its data, come
+// after it. All values are stored in the byte order of the machine, the endianness field tells a reader on
+// a machine with another byte order to swap them, the cache rejects such files instead.
+struct KTXHeader
+{
+    unsigned char Identifier[12];
+    uint32_t Endianness;
+    uint32_t GLType;
+    uint32_t GLTypeSize;
+    uint32_t GLFormat;
+    uint32_t GLInternalFormat;
+    uint32_t GLBaseInternalFormat;
+    uint32_t PixelWidth;
+    uint32_t PixelHeight;
+    uint32_t PixelDepth;
+    uint32_t NumberOfArrayElements;
+    uint32_t NumberOfFaces;
+    uint32_t NumberOfMipmapLevels;
+    uint32_t BytesOfKeyValueData;
+};
+
+// The value of the stamp key, the key itself is terminated by a zero
+const char texture_cache_stamp_key[] = "PV112.source";
+
+struct TextureCacheStamp
+{
+    uint32_t Version;
+    uint32_t Reserved;
+    uint64_t SourceSize;
+    int64_t SourceModificationTime;
+    uint64_t SourceHash;
+};
+
+// Key/value entries and levels are padded to 4 bytes
+inline uint64_t PadTo4(uint64_t size)
+{
+    return (size + 3) & ~uint64_t(3);
+}
+
+inline uint32_t ReadUInt32(const char *data)
+{
+    uint32_t value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+// Finds the stamp in the key/value data from 'begin' to 'end' and compares it with the source
+bool IsStampValid(const char *begin, const char *end, const SourceStamp &source_stamp)
+{
+    const size_t key_size = sizeof(texture_cache_stamp_key);
+    while (end - begin >= 4)
+    {
+        const uint32_t entry_size = ReadUInt32(begin);
+        begin += 4;
+        if (entry_size > uint64_t(end - begin))
+            return false;
+
+        if (entry_size == key_size + sizeof(TextureCacheStamp) && memcmp(begin, texture_cache_stamp_key, key_size) == 0)
+        {
+            TextureCacheStamp stamp;
+            memcpy(&stamp, begin + key_size, sizeof(stamp));
+            return stamp.Version == texture_cache_version && stamp.SourceSize == source_stamp.Size &&
+                stamp.SourceModificationTime == source_stamp.ModificationTime && stamp.SourceHash == source_stamp.Hash;
+        }
+        if (PadTo4(entry_size) > uint64_t(end - begin))
+            return false;
+        begin += PadTo4(entry_size);
+    }
+    return false;
+}
+
+}
+
+std::string GetTextureCacheFileName(const char *source_file_name, int width, int height)
+{
+    if (width > 0 && height > 0)
+        return GetCacheFileName(source_file_name, "." + std::to_string(width) + "x" + std::to_string(height) + ".ktx");
+    return GetCacheFileName(source_file_name, ".ktx");
+}
+
+TextureCache::TextureCache()
+    : format(BlockFormat::BC1)
+{
+}
+
+bool TextureCache::Open(const char *file_name, const SourceStamp &source_stamp)
+{
+    Close();
+
+    if (!file.Open(file_name) || file.Size() < sizeof(KTXHeader))
+    {
+        Close();
+        return false;
+    }
+
+    KTXHeader header;
+    memcpy(&header, file.Data(), sizeof(header));
+
+    const uint64_t file_size = file.Size();
+    const bool bc3 = header.GLInternalFormat == gl_compressed_rgba_s3tc_dxt5;
+    const bool valid = memcmp(header.Identifier, ktx_identifier, sizeof(header.Identifier)) == 0 &&
+        header.Endianness == ktx_endianness &&
+        header.GLType == 0 && header.GLTypeSize == 1 && header.GLFormat == 0 &&
+        (bc3 || header.GLInternalFormat == gl_compressed_rgb_s3tc_dxt1) &&
+        header.GLBaseInternalFormat == (bc3 ? gl_rgba : gl_rgb) &&
+        header.PixelWidth >= 1 && header.PixelWidth <= 65536 && header.PixelHeight >= 1 && header.PixelHeight <= 65536 &&
+        header.PixelDepth == 0 && header.NumberOfArrayElements == 0 && header.NumberOfFaces == 1 &&
+        header.NumberOfMipmapLevels == uint32_t(GetMipLevelCount(int(header.PixelWidth), int(header.PixelHeight))) &&
+        header.BytesOfKeyValueData % 4 == 0 && header.BytesOfKeyValueData <= file_size - sizeof(KTXHeader);
+    const char *key_values = file.Data() + sizeof(KTXHeader);
+    if (!valid || !IsStampValid(key_values, key_values + header.BytesOfKeyValueData, source_stamp))
+    {
+        Close();
+        return false;
+    }
+
+    // The sizes of the levels must be those of a complete chain of the format
+    format = bc3 ? BlockFormat::BC3 : BlockFormat::BC1;
+    uint64_t position = sizeof(KTXHeader) + header.BytesOfKeyValueData;
+    int width = int(header.PixelWidth), height = int(header.PixelHeight);
+    for (uint32_t level = 0; level < header.NumberOfMipmapLevels; level++)
+    {
+        const size_t size = GetCompressedLevelSize(format, width, height);
+        if (position > file_size || file_size - position < 4 || ReadUInt32(file.Data() + position) != size || file_size - position - 4 < size)
+        {
+            Close();
+            return false;
+        }
+
+        CompressedLevel compressed;
+        compressed.Width = width;
+        compressed.Height = height;
+        compressed.Offset = size_t(position + 4);
+        compressed.Size = size;
+        levels.push_back(compressed);
+
+        position = PadTo4(position + 4 + size);
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+    return true;
+}
+
+void TextureCache::Close()
+{
+    file.Close();
+    format = BlockFormat::BC1;
+    levels.clear();
+}
+
+BlockFormat TextureCache::Format() const
+{
+    return format;
+}
+
+int TextureCache::Width() const
+{
+    return levels.empty() ? 0 : levels[0].Width;
+}
+
+int TextureCache::Height() const
+{
+    return levels.empty() ? 0 : levels[0].Height;
+}
+
+const std::vector<CompressedLevel> &TextureCache::Levels() const
+{
+    return levels;
+}
+
+const unsigned char *TextureCache::Data() const
+{
+    return reinterpret_cast<const unsigned char *>(file.Data());
+}
+
+bool WriteTextureCache(const char *file_name, const SourceStamp &source_stamp, const CompressedTexture &texture)
+{
+    if (texture.Levels.empty())
+        return false;
+
+    const bool bc3 = texture.Format == BlockFormat::BC3;
+    const size_t key_size = sizeof(texture_cache_stamp_key);
+    const uint32_t entry_size = uint32_t(key_size + sizeof(TextureCacheStamp));
+
+    KTXHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.Identifier, ktx_identifier, sizeof(header.Identifier));
+    header.Endianness = ktx_endianness;
+    header.GLTypeSize = 1;
+    header.GLInternalFormat = bc3 ? gl_compressed_rgba_s3tc_dxt5 : gl_compressed_rgb_s3tc_dxt1;
+    header.GLBaseInternalFormat = bc3 ? gl_rgba : gl_rgb;
+    header.PixelWidth = uint32_t(texture.Levels[0].Width);
+    header.PixelHeight = uint32_t(texture.Levels[0].Height);
+    header.NumberOfFaces = 1;
+    header.NumberOfMipmapLevels = uint32_t(texture.Levels.size());
+    header.BytesOfKeyValueData = uint32_t(4 + PadTo4(entry_size));
+
+    TextureCacheStamp stamp;
+    memset(&stamp, 0, sizeof(stamp));
+    stamp.Version = texture_cache_version;
+    stamp.SourceSize = source_stamp.Size;
+    stamp.SourceModificationTime = source_stamp.ModificationTime;
+    stamp.SourceHash = source_stamp.Hash;
+
+    return WriteCacheFile(file_name, [&](FILE *file)
+    {
+        const char padding[4] = {};
+        bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+        ok = ok && fwrite(&entry_size, sizeof(entry_size), 1, file) == 1;
+        ok = ok && fwrite(texture_cache_stamp_key, key_size, 1, file) == 1;
+        ok = ok && fwrite(&stamp, sizeof(stamp), 1, file) == 1;
+        ok = ok && fwrite(padding, 1, size_t(PadTo4(entry_size) - entry_size), file) == size_t(PadTo4(entry_size) - entry_size);
+        for (size_t level = 0; ok && level < texture.Levels.size(); level++)
+        {
+            const CompressedLevel &compressed = texture.Levels[level];
+            const uint32_t image_size = uint32_t(compressed.Size);
+            const size_t padding_size = size_t(PadTo4(compressed.Size) - compressed.Size);
+            ok = fwrite(&image_size, sizeof(image_size), 1, file) == 1 &&
+                fwrite(texture.Data.data() + compressed.Offset, compressed.Size, 1, file) == 1 &&
+                fwrite(padding, 1, padding_size, file) == padding_size;
+        }
+        return ok;
+    });
+}
+
+}
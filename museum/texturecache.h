@@ -0,0 +1,62 @@
+#pragma once
+#ifndef INCLUDED_TEXTURECACHE_H
+#define INCLUDED_TEXTURECACHE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "mappedfile.h"
+#include "sourcestamp.h"
+#include "texturecompress.h"
+
+namespace PV112
+{
+
+/// Returns the name of the cache file of a texture, the cache is stored next to the image with the
+/// extension replaced by .ktx ("./textures/wall.jpg" -> "./textures/wall.ktx"). A copy of the image resized
+/// to 'width' x 'height' has the size in the name as well ("./textures/wall.512x512.ktx").
+std::string GetTextureCacheFileName(const char *source_file_name, int width = 0, int height = 0);
+
+/// Memory-mapped KTX 1.1 file with a block compressed texture and its whole mip chain. The stamp of the
+/// source image is stored in the key/value data, so other tools read the file as an ordinary KTX texture.
+///
+/// The levels are NOT copied, Data() + Levels()[i].Offset points directly into the mapping and can be passed
+/// to glCompressedTexImage2D. The data are valid until the cache is closed.
+class TextureCache
+{
+public:
+    TextureCache();
+
+    /// Maps the cache file and checks it. Returns false if the file does not exist, it was written by
+    /// another version of the program, it is damaged, or it was created from a different source image.
+    bool Open(const char *file_name, const SourceStamp &source_stamp);
+
+    void Close();
+
+    BlockFormat Format() const;
+    int Width() const;
+    int Height() const;
+
+    /// All levels of the mip chain, from the full image to 1x1. Their sizes are checked by Open.
+    const std::vector<CompressedLevel> &Levels() const;
+    const unsigned char *Data() const;
+
+private:
+    // The mapping must not be copied, the offsets would point to the memory of another object
+    TextureCache(const TextureCache &);
+    TextureCache &operator =(const TextureCache &);
+
+    MappedFile file;
+    BlockFormat format;
+    std::vector<CompressedLevel> levels;
+};
+
+/// Writes a compressed texture to a cache file, the file is replaced only when it is completely written.
+///
+/// Returns false if the file cannot be written, for example when the directory is read-only.
+bool WriteTextureCache(const char *file_name, const SourceStamp &source_stamp, const CompressedTexture &texture);
+
+}
+
+#endif	// INCLUDED_TEXTURECACHE_H
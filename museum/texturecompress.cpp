@@ -0,0 +1,704 @@
+#include "texturecompress.h"
+
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <cmath>
+
+#include "parallel.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TEXTURE_COMPRESS_SSE2
+#endif
+
+namespace PV112
+{
+
+namespace
+{
+
+// The pixels of a 4x4 block, row by row. The color channels are floats in separate arrays, so that SSE2
+// compares four pixels with a color of the palette at once.
+struct BlockPixels
+{
+    alignas(16) float R[16];
+    alignas(16) float G[16];
+    alignas(16) float B[16];
+    unsigned char A[16];
+};
+
+void LoadBlock(const unsigned char *pixels, int width, int height, int channels, int block_x, int block_y, BlockPixels &out)
+{
+    for (int y = 0; y < 4; y++)
+    {
+        const int pixel_y = std::min(block_y * 4 + y, height - 1);
+        for (int x = 0; x < 4; x++)
+        {
+            const int pixel_x = std::min(block_x * 4 + x, width - 1);
+            const unsigned char *pixel = pixels + (size_t(pixel_y) * width + pixel_x) * channels;
+            out.R[y * 4 + x] = float(pixel[0]);
+            out.G[y * 4 + x] = float(pixel[1]);
+            out.B[y * 4 + x] = float(pixel[2]);
+            out.A[y * 4 + x] = channels == 4 ? pixel[3] : 255;
+        }
+    }
+}
+
+//----------------------------
+//----    COLOR BLOCKS    ----
+//----------------------------
+
+uint16_t PackColor565(const float color[3])
+{
+    const int r = int(std::min(std::max(color[0], 0.0f), 255.0f) * (31.0f / 255.0f) + 0.5f);
+    const int g = int(std::min(std::max(color[1], 0.0f), 255.0f) * (63.0f / 255.0f) + 0.5f);
+    const int b = int(std::min(std::max(color[2], 0.0f), 255.0f) * (31.0f / 255.0f) + 0.5f);
+    return uint16_t((r << 11) | (g << 5) | b);
+}
+
+// The bits are replicated to the low bits, as the hardware decodes them
+void UnpackColor565(uint16_t packed, float out_color[3])
+{
+    const int r = (packed >> 11) & 31, g = (packed >> 5) & 63, b = packed & 31;
+    out_color[0] = float((r << 3) | (r >> 2));
+    out_color[1] = float((g << 2) | (g >> 4));
+    out_color[2] = float((b << 3) | (b >> 2));
+}
+
+// Palette of the four-color mode: the endpoints, 2/3 of the first one, and 1/3 of it
+void BuildPalette(uint16_t color0, uint16_t color1, float out_palette[4][3])
+{
+    UnpackColor565(color0, out_palette[0]);
+    UnpackColor565(color1, out_palette[1]);
+    for (int c = 0; c < 3; c++)
+    {
+        out_palette[2][c] = (2.0f * out_palette[0][c] + out_palette[1][c]) / 3.0f;
+        out_palette[3][c] = (out_palette[0][c] + 2.0f * out_palette[1][c]) / 3.0f;
+    }
+}
+
+// Chooses the closest color of the palette for every pixel, returns the sum of the squared distances
+float SelectColorIndices(const BlockPixels &block, const float palette[4][3], unsigned char out_indices[16])
+{
+#if defined(TEXTURE_COMPRESS_SSE2)
+    __m128 error = _mm_setzero_ps();
+    for (int i = 0; i < 16; i += 4)
+    {
+        const __m128 r = _mm_load_ps(block.R + i);
+        const __m128 g = _mm_load_ps(block.G + i);
+        const __m128 b = _mm_load_ps(block.B + i);
+
+        __m128 best = _mm_set1_ps(1e30f);
+        __m128i best_index = _mm_setzero_si128();
+        for (int p = 0; p < 4; p++)
+        {
+            const __m128 dr = _mm_sub_ps(r, _mm_set1_ps(palette[p][0]));
+            const __m128 dg = _mm_sub_ps(g, _mm_set1_ps(palette[p][1]));
+            const __m128 db = _mm_sub_ps(b, _mm_set1_ps(palette[p][2]));
+            const __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dr, dr), _mm_mul_ps(dg, dg)), _mm_mul_ps(db, db));
+
+            // SSE2 has no blend, the mask selects the new index
+            const __m128i closer = _mm_castps_si128(_mm_cmplt_ps(distance, best));
+            best_index = _mm_or_si128(_mm_andnot_si128(closer, best_index), _mm_and_si128(closer, _mm_set1_epi32(p)));
+            best = _mm_min_ps(distance, best);
+        }
+        error = _mm_add_ps(error, best);
+
+        alignas(16) int32_t indices[4];
+        _mm_store_si128(reinterpret_cast<__m128i *>(indices), best_index);
+        for (int k = 0; k < 4; k++)
+            out_indices[i + k] = (unsigned char)indices[k];
+    }
+
+    alignas(16) float errors[4];
+    _mm_store_ps(errors, error);
+    return errors[0] + errors[1] + errors[2] + errors[3];
+#else
+    float error = 0.0f;
+    for (int i = 0; i < 16; i++)
+    {
+        float best = 1e30f;
+        for (int p = 0; p < 4; p++)
+        {
+            const float dr = block.R[i] - palette[p][0], dg = block.G[i] - palette[p][1], db = block.B[i] - palette[p][2];
+            const float distance = dr * dr + dg * dg + db * db;
+            if (distance < best)
+            {
+                best = distance;
+                out_indices[i] = (unsigned char)p;
+            }
+        }
+        error += best;
+    }
+    return error;
+#endif
+}
+
+// The endpoints of a color block with the indices they give and their error
+struct ColorEndpoints
+{
+    uint16_t Color0;
+    uint16_t Color1;
+    unsigned char Indices[16];
+    float Error;
+};
+
+void EvaluateEndpoints(const BlockPixels &block, const float endpoint0[3], const float endpoint1[3], ColorEndpoints &out)
+{
+    out.Color0 = PackColor565(endpoint0);
+    out.Color1 = PackColor565(endpoint1);
+    float palette[4][3];
+    BuildPalette(out.Color0, out.Color1, palette);
+    out.Error = SelectColorIndices(block, palette, out.Indices);
+}
+
+// Endpoints that minimize the squared error of the pixels for the chosen indices, returns false if the
+// indices do not determine them (all pixels use the same weights)
+bool FitEndpoints(const BlockPixels &block, const unsigned char indices[16], float out_endpoint0[3], float out_endpoint1[3])
+{
+    // Weight of the first endpoint for each index, the second one has the rest
+    static const float weights[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+
+    float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+    float ax[3] = { 0.0f, 0.0f, 0.0f }, bx[3] = { 0.0f, 0.0f, 0.0f };
+    for (int i = 0; i < 16; i++)
+    {
+        const float a = weights[indices[i]], b = 1.0f - a;
+        const float pixel[3] = { block.R[i], block.G[i], block.B[i] };
+        aa += a * a;
+        ab += a * b;
+        bb += b * b;
+        for (int c = 0; c < 3; c++)
+        {
+            ax[c] += a * pixel[c];
+            bx[c] += b * pixel[c];
+        }
+    }
+
+    const float determinant = aa * bb - ab * ab;
+    if (std::abs(determinant) < 1e-6f)
+        return false;
+    for (int c = 0; c < 3; c++)
+    {
+        out_endpoint0[c] = (bb * ax[c] - ab * bx[c]) / determinant;
+        out_endpoint1[c] = (aa * bx[c] - ab * ax[c]) / determinant;
+    }
+    return true;
+}
+
+void EncodeColorBlock(const BlockPixels &block, unsigned char *out_block)
+{
+    // The principal axis of the colors, found by power iteration on their covariance
+    float mean[3] = { 0.0f, 0.0f, 0.0f };
+    float low[3] = { 255.0f, 255.0f, 255.0f }, high[3] = { 0.0f, 0.0f, 0.0f };
+    for (int i = 0; i < 16; i++)
+    {
+        const float pixel[3] = { block.R[i], block.G[i], block.B[i] };
+        for (int c = 0; c < 3; c++)
+        {
+            mean[c] += pixel[c] / 16.0f;
+            low[c] = std::min(low[c], pixel[c]);
+            high[c] = std::max(high[c], pixel[c]);
+        }
+    }
+
+    float covariance[3][3] = {};
+    for (int i = 0; i < 16; i++)
+    {
+        const float d[3] = { block.R[i] - mean[0], block.G[i] - mean[1], block.B[i] - mean[2] };
+        for (int row = 0; row < 3; row++)
+            for (int column = 0; column < 3; column++)
+                covariance[row][column] += d[row] * d[column];
+    }
+
+    float axis[3] = { high[0] - low[0], high[1] - low[1], high[2] - low[2] };
+    for (int iteration = 0; iteration < 8; iteration++)
+    {
+        float next[3];
+        for (int row = 0; row < 3; row++)
+            next[row] = covariance[row][0] * axis[0] + covariance[row][1] * axis[1] + covariance[row][2] * axis[2];
+        const float scale = std::max(std::max(std::abs(next[0]), std::abs(next[1])), std::abs(next[2]));
+        if (scale <= 0.0f)
+            break;
+        for (int c = 0; c < 3; c++)
+            axis[c] = next[c] / scale;
+    }
+
+    // The endpoints start at the pixels with the extreme projections onto the axis
+    int first = 0, last = 0;
+    float first_projection = 1e30f, last_projection = -1e30f;
+    for (int i = 0; i < 16; i++)
+    {
+        const float projection = block.R[i] * axis[0] + block.G[i] * axis[1] + block.B[i] * axis[2];
+        if (projection < first_projection)
+        {
+            first_projection = projection;
+            first = i;
+        }
+        if (projection > last_projection)
+        {
+            last_projection = projection;
+            last = i;
+        }
+    }
+
+    const float endpoint0[3] = { block.R[last], block.G[last], block.B[last] };
+    const float endpoint1[3] = { block.R[first], block.G[first], block.B[first] };
+    ColorEndpoints best;
+    EvaluateEndpoints(block, endpoint0, endpoint1, best);
+
+    // One step of least squares usually moves the endpoints inside the extreme pixels and lowers the error
+    float fitted0[3], fitted1[3];
+    if (best.Error > 0.0f && FitEndpoints(block, best.Indices, fitted0, fitted1))
+    {
+        ColorEndpoints fitted;
+        EvaluateEndpoints(block, fitted0, fitted1, fitted);
+        if (fitted.Error < best.Error)
+            best = fitted;
+    }
+
+    // The four-color mode needs color0 > color1, swapping the endpoints swaps the indices 0 <-> 1 and 2 <-> 3.
+    // Equal endpoints give a single color, index 0 is used for all pixels.
+    if (best.Color0 < best.Color1)
+    {
+        std::swap(best.Color0, best.Color1);
+        for (int i = 0; i < 16; i++)
+            best.Indices[i] ^= 1;
+    }
+    uint32_t bits = 0;
+    if (best.Color0 != best.Color1)
+    {
+        for (int i = 0; i < 16; i++)
+            bits |= uint32_t(best.Indices[i]) << (2 * i);
+    }
+
+    // Little-endian regardless of the machine
+    out_block[0] = (unsigned char)(best.Color0 & 0xFF);
+    out_block[1] = (unsigned char)(best.Color0 >> 8);
+    out_block[2] = (unsigned char)(best.Color1 & 0xFF);
+    out_block[3] = (unsigned char)(best.Color1 >> 8);
+    for (int i = 0; i < 4; i++)
+        out_block[4 + i] = (unsigned char)(bits >> (8 * i));
+}
+
+//----------------------------
+//----    ALPHA BLOCKS    ----
+//----------------------------
+
+// The eight-value mode: alpha0 > alpha1, indices 2 to 7 interpolate from alpha0 to alpha1 in sevenths
+void EncodeAlphaBlock(const BlockPixels &block, unsigned char *out_block)
+{
+    int alpha0 = 0, alpha1 = 255;
+    for (int i = 0; i < 16; i++)
+    {
+        alpha0 = std::max(alpha0, int(block.A[i]));
+        alpha1 = std::min(alpha1, int(block.A[i]));
+    }
+
+    uint64_t bits = 0;
+    if (alpha0 > alpha1)
+    {
+        for (int i = 0; i < 16; i++)
+        {
+            // Sevenths of alpha0 in the value closest to the pixel, then its index
+            const int level = (14 * (int(block.A[i]) - alpha1) + (alpha0 - alpha1)) / (2 * (alpha0 - alpha1));
+            const int index = level == 7 ? 0 : (level == 0 ? 1 : 8 - level);
+            bits |= uint64_t(index) << (3 * i);
+        }
+    }
+
+    out_block[0] = (unsigned char)alpha0;
+    out_block[1] = (unsigned char)alpha1;
+    for (int i = 0; i < 6; i++)
+        out_block[2 + i] = (unsigned char)(bits >> (8 * i));
+}
+
+//--------------------------
+//----    MIP LEVELS    ----
+//--------------------------
+
+// Number of steps of the linear values in the table that converts them back to sRGB, fine enough that the
+// darkest sRGB values (where the curve is steepest) are rounded exactly
+const int linear_steps = 65535;
+
+// The pixels are sRGB, the filter averages them in linear light. A plain average of sRGB values makes the
+// smaller levels darker wherever light and dark pixels meet.
+struct GammaTables
+{
+    float ToLinear[256];
+    unsigned char ToSRGB[linear_steps + 1];
+
+    GammaTables()
+    {
+        for (int i = 0; i < 256; i++)
+        {
+            const float value = float(i) / 255.0f;
+            ToLinear[i] = value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+        }
+        for (int i = 0; i <= linear_steps; i++)
+        {
+            const float value = float(i) / float(linear_steps);
+            const float srgb = value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+            ToSRGB[i] = (unsigned char)(srgb * 255.0f + 0.5f);
+        }
+    }
+};
+
+const GammaTables &GetGammaTables()
+{
+    static const GammaTables tables;
+    return tables;
+}
+
+// Filters 2x2 pixels to one. The colors are weighted by their alpha, so that the colors of transparent
+// pixels do not bleed into the visible ones; if all four are transparent, the colors are averaged as they are.
+// Alpha is not gamma encoded, it is averaged directly.
+void FilterPixel(const unsigned char *const source[4], int channels, const GammaTables &tables, unsigned char *out_pixel)
+{
+#if defined(TEXTURE_COMPRESS_SSE2)
+    // A pixel in a register: linear R, G, B, and alpha (the last lane)
+    const __m128 color_lanes = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+    __m128 sum = _mm_setzero_ps(), weighted_sum = _mm_setzero_ps();
+    for (int i = 0; i < 4; i++)
+    {
+        const unsigned char *pixel = source[i];
+        const __m128 value = _mm_set_ps(channels == 4 ? float(pixel[3]) / 255.0f : 1.0f, tables.ToLinear[pixel[2]],
+                tables.ToLinear[pixel[1]], tables.ToLinear[pixel[0]]);
+        const __m128 alpha = _mm_shuffle_ps(value, value, _MM_SHUFFLE(3, 3, 3, 3));
+        sum = _mm_add_ps(sum, value);
+        weighted_sum = _mm_add_ps(weighted_sum, _mm_or_ps(_mm_and_ps(color_lanes, _mm_mul_ps(value, alpha)), _mm_andnot_ps(color_lanes, value)));
+    }
+
+    // The alpha lane of both sums is the sum of the alphas
+    const __m128 alpha_sum = _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(3, 3, 3, 3));
+    const __m128 visible = _mm_and_ps(color_lanes, _mm_cmpgt_ps(alpha_sum, _mm_setzero_ps()));
+    const __m128 weighted = _mm_div_ps(weighted_sum, _mm_max_ps(alpha_sum, _mm_set1_ps(1e-6f)));
+    const __m128 average = _mm_mul_ps(sum, _mm_set1_ps(0.25f));
+    __m128 result = _mm_or_ps(_mm_and_ps(visible, weighted), _mm_andnot_ps(visible, average));
+
+    // The colors become indices to the sRGB table, alpha becomes the final byte
+    result = _mm_min_ps(_mm_max_ps(result, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+    const __m128i scaled = _mm_cvtps_epi32(_mm_mul_ps(result, _mm_set_ps(255.0f, float(linear_steps), float(linear_steps), float(linear_steps))));
+    alignas(16) int32_t values[4];
+    _mm_store_si128(reinterpret_cast<__m128i *>(values), scaled);
+#else
+    float sum[4] = { 0.0f, 0.0f, 0.0f, 0.0f }, weighted_sum[3] = { 0.0f, 0.0f, 0.0f };
+    for (int i = 0; i < 4; i++)
+    {
+        const unsigned char *pixel = source[i];
+        const float alpha = channels == 4 ? float(pixel[3]) / 255.0f : 1.0f;
+        for (int c = 0; c < 3; c++)
+        {
+            sum[c] += tables.ToLinear[pixel[c]];
+            weighted_sum[c] += tables.ToLinear[pixel[c]] * alpha;
+        }
+        sum[3] += alpha;
+    }
+
+    int32_t values[4];
+    for (int c = 0; c < 4; c++)
+    {
+        const float value = (c < 3 && sum[3] > 0.0f) ? weighted_sum[c] / std::max(sum[3], 1e-6f) : sum[c] * 0.25f;
+        values[c] = int32_t(std::nearbyint(std::min(std::max(value, 0.0f), 1.0f) * (c < 3 ? float(linear_steps) : 255.0f)));
+    }
+#endif
+
+    for (int c = 0; c < 3; c++)
+        out_pixel[c] = tables.ToSRGB[values[c]];
+    if (channels == 4)
+        out_pixel[3] = (unsigned char)values[3];
+}
+
+//------------------------
+//----    RESIZING    ----
+//------------------------
+
+// A pixel with linear colors premultiplied by alpha, in a register where SSE2 is available
+#if defined(TEXTURE_COMPRESS_SSE2)
+typedef __m128 LinearPixel;
+
+inline LinearPixel MakeLinearPixel(float r, float g, float b, float a)
+{
+    return _mm_set_ps(a, b * a, g * a, r * a);
+}
+
+inline LinearPixel LoadLinearPixel(const float *pixel)
+{
+    return _mm_loadu_ps(pixel);
+}
+
+inline void StoreLinearPixel(float *out_pixel, LinearPixel value)
+{
+    _mm_storeu_ps(out_pixel, value);
+}
+
+inline LinearPixel AddWeightedPixel(LinearPixel sum, LinearPixel value, float weight)
+{
+    return _mm_add_ps(sum, _mm_mul_ps(value, _mm_set1_ps(weight)));
+}
+#else
+struct LinearPixel
+{
+    float Values[4];
+};
+
+inline LinearPixel MakeLinearPixel(float r, float g, float b, float a)
+{
+    const LinearPixel pixel = { { r * a, g * a, b * a, a } };
+    return pixel;
+}
+
+inline LinearPixel LoadLinearPixel(const float *pixel)
+{
+    const LinearPixel value = { { pixel[0], pixel[1], pixel[2], pixel[3] } };
+    return value;
+}
+
+inline void StoreLinearPixel(float *out_pixel, LinearPixel value)
+{
+    std::copy(value.Values, value.Values + 4, out_pixel);
+}
+
+inline LinearPixel AddWeightedPixel(LinearPixel sum, LinearPixel value, float weight)
+{
+    for (int c = 0; c < 4; c++)
+        sum.Values[c] += value.Values[c] * weight;
+    return sum;
+}
+#endif
+
+// The source pixels of every target pixel along one axis and their weights. The tent filter is as wide as a
+// source pixel when enlarging (bilinear interpolation), and as wide as a target pixel when shrinking, so
+// that every source pixel contributes.
+struct FilterTaps
+{
+    // For each target pixel, the first tap and the number of taps
+    std::vector<size_t> First;
+    std::vector<size_t> Count;
+    std::vector<int> Sources;
+    std::vector<float> Weights;
+};
+
+void BuildFilterTaps(int source_size, int target_size, FilterTaps &out)
+{
+    const float scale = float(source_size) / float(target_size);
+    const float radius = std::max(scale, 1.0f);
+    for (int i = 0; i < target_size; i++)
+    {
+        const float center = (float(i) + 0.5f) * scale - 0.5f;
+        const size_t first = out.Weights.size();
+        float weight_sum = 0.0f;
+        for (int source = int(std::ceil(center - radius)); source <= int(std::floor(center + radius)); source++)
+        {
+            const float weight = 1.0f - std::abs(float(source) - center) / radius;
+            if (weight <= 0.0f)
+                continue;
+            // The edges are repeated
+            out.Sources.push_back(std::min(std::max(source, 0), source_size - 1));
+            out.Weights.push_back(weight);
+            weight_sum += weight;
+        }
+        for (size_t tap = first; tap < out.Weights.size(); tap++)
+            out.Weights[tap] /= weight_sum;
+        out.First.push_back(first);
+        out.Count.push_back(out.Weights.size() - first);
+    }
+}
+
+}
+
+size_t GetCompressedLevelSize(BlockFormat format, int width, int height)
+{
+    const size_t block_size = format == BlockFormat::BC1 ? 8 : 16;
+    return size_t((width + 3) / 4) * size_t((height + 3) / 4) * block_size;
+}
+
+int GetMipLevelCount(int width, int height)
+{
+    int count = 1;
+    while (width > 1 || height > 1)
+    {
+        width = std::max(width / 2, 1);
+        height = std::max(height / 2, 1);
+        count++;
+    }
+    return count;
+}
+
+BlockFormat ChooseBlockFormat(const unsigned char *pixels, int width, int height, int channels)
+{
+    if (channels != 4)
+        return BlockFormat::BC1;
+
+    const size_t pixel_count = size_t(width) * height;
+    for (size_t i = 0; i < pixel_count; i++)
+    {
+        if (pixels[i * 4 + 3] != 255)
+            return BlockFormat::BC3;
+    }
+    return BlockFormat::BC1;
+}
+
+void CompressImage(const unsigned char *pixels, int width, int height, int channels, BlockFormat format, unsigned char *out_blocks)
+{
+    const int blocks_x = (width + 3) / 4, blocks_y = (height + 3) / 4;
+    const size_t block_size = format == BlockFormat::BC1 ? 8 : 16;
+
+    ParallelFor(size_t(blocks_y), 4, [&](size_t begin, size_t end)
+    {
+        BlockPixels block;
+        for (size_t block_y = begin; block_y < end; block_y++)
+        {
+            unsigned char *out_block = out_blocks + block_y * blocks_x * block_size;
+            for (int block_x = 0; block_x < blocks_x; block_x++, out_block += block_size)
+            {
+                LoadBlock(pixels, width, height, channels, block_x, int(block_y), block);
+                if (format == BlockFormat::BC3)
+                {
+                    EncodeAlphaBlock(block, out_block);
+                    EncodeColorBlock(block, out_block + 8);
+                }
+                else
+                {
+                    EncodeColorBlock(block, out_block);
+                }
+            }
+        }
+    });
+}
+
+void DownsampleImage(const unsigned char *pixels, int width, int height, int channels, std::vector<unsigned char> &out_pixels)
+{
+    const int out_width = std::max(width / 2, 1), out_height = std::max(height / 2, 1);
+    out_pixels.resize(size_t(out_width) * out_height * channels);
+    const GammaTables &tables = GetGammaTables();
+
+    ParallelFor(size_t(out_height), 16, [&](size_t begin, size_t end)
+    {
+        for (size_t y = begin; y < end; y++)
+        {
+            const size_t y0 = std::min(2 * y, size_t(height - 1)), y1 = std::min(2 * y + 1, size_t(height - 1));
+            for (int x = 0; x < out_width; x++)
+            {
+                const size_t x0 = std::min(2 * x, width - 1), x1 = std::min(2 * x + 1, width - 1);
+                const unsigned char *const source[4] =
+                {
+                    pixels + (y0 * width + x0) * channels, pixels + (y0 * width + x1) * channels,
+                    pixels + (y1 * width + x0) * channels, pixels + (y1 * width + x1) * channels,
+                };
+                FilterPixel(source, channels, tables, &out_pixels[(y * out_width + x) * channels]);
+            }
+        }
+    });
+}
+
+void GenerateMipLevels(const unsigned char *pixels, int width, int height, int channels, std::vector<std::vector<unsigned char> > &out_levels)
+{
+    out_levels.resize(GetMipLevelCount(width, height) - 1);
+    for (size_t level = 0; level < out_levels.size(); level++)
+    {
+        DownsampleImage(pixels, width, height, channels, out_levels[level]);
+        pixels = out_levels[level].data();
+        width = std::max(width / 2, 1);
+        height = std::max(height / 2, 1);
+    }
+}
+
+void ResizeImage(const unsigned char *pixels, int width, int height, int channels, int out_width, int out_height,
+        std::vector<unsigned char> &out_pixels)
+{
+    const GammaTables &tables = GetGammaTables();
+    FilterTaps columns, rows;
+    BuildFilterTaps(width, out_width, columns);
+    BuildFilterTaps(height, out_height, rows);
+
+    // The rows are resized first, into linear premultiplied pixels, then the columns of those
+    std::vector<float> resized_rows(size_t(out_width) * height * 4);
+    ParallelFor(size_t(height), 16, [&](size_t begin, size_t end)
+    {
+        for (size_t y = begin; y < end; y++)
+        {
+            const unsigned char *row = pixels + y * width * channels;
+            for (int x = 0; x < out_width; x++)
+            {
+                LinearPixel sum = MakeLinearPixel(0.0f, 0.0f, 0.0f, 0.0f);
+                for (size_t tap = columns.First[x]; tap < columns.First[x] + columns.Count[x]; tap++)
+                {
+                    const unsigned char *pixel = row + size_t(columns.Sources[tap]) * channels;
+                    const LinearPixel value = MakeLinearPixel(tables.ToLinear[pixel[0]], tables.ToLinear[pixel[1]], tables.ToLinear[pixel[2]],
+                            channels == 4 ? float(pixel[3]) / 255.0f : 1.0f);
+                    sum = AddWeightedPixel(sum, value, columns.Weights[tap]);
+                }
+                StoreLinearPixel(&resized_rows[(y * out_width + x) * 4], sum);
+            }
+        }
+    });
+
+    out_pixels.resize(size_t(out_width) * out_height * channels);
+    ParallelFor(size_t(out_height), 16, [&](size_t begin, size_t end)
+    {
+        for (size_t y = begin; y < end; y++)
+        {
+            for (int x = 0; x < out_width; x++)
+            {
+                LinearPixel sum = MakeLinearPixel(0.0f, 0.0f, 0.0f, 0.0f);
+                for (size_t tap = rows.First[y]; tap < rows.First[y] + rows.Count[y]; tap++)
+                    sum = AddWeightedPixel(sum, LoadLinearPixel(&resized_rows[(size_t(rows.Sources[tap]) * out_width + x) * 4]), rows.Weights[tap]);
+
+                float value[4];
+                StoreLinearPixel(value, sum);
+                const float alpha = std::min(std::max(value[3], 0.0f), 1.0f);
+                unsigned char *out_pixel = &out_pixels[(y * out_width + x) * channels];
+                for (int c = 0; c < 3; c++)
+                {
+                    const float color = value[3] > 0.0f ? std::min(std::max(value[c] / value[3], 0.0f), 1.0f) : 0.0f;
+                    out_pixel[c] = tables.ToSRGB[int(std::nearbyint(color * float(linear_steps)))];
+                }
+                if (channels == 4)
+                    out_pixel[3] = (unsigned char)std::nearbyint(alpha * 255.0f);
+            }
+        }
+    });
+}
+
+void CompressTexture(const unsigned char *pixels, int width, int height, int channels, CompressedTexture &out)
+{
+    CompressTexture(pixels, width, height, channels, ChooseBlockFormat(pixels, width, height, channels), out);
+}
+
+void CompressTexture(const unsigned char *pixels, int width, int height, int channels, BlockFormat format, CompressedTexture &out)
+{
+    out.Format = format;
+    out.Levels.resize(GetMipLevelCount(width, height));
+
+    size_t total_size = 0;
+    for (size_t level = 0, level_width = width, level_height = height; level < out.Levels.size(); level++)
+    {
+        out.Levels[level].Width = int(level_width);
+        out.Levels[level].Height = int(level_height);
+        out.Levels[level].Offset = total_size;
+        out.Levels[level].Size = GetCompressedLevelSize(out.Format, int(level_width), int(level_height));
+        total_size += out.Levels[level].Size;
+        level_width = std::max<size_t>(level_width / 2, 1);
+        level_height = std::max<size_t>(level_height / 2, 1);
+    }
+    out.Data.resize(total_size);
+
+    // Every level is made from the previous one
+    std::vector<unsigned char> level_pixels, next_pixels;
+    const unsigned char *source = pixels;
+    for (size_t level = 0; level < out.Levels.size(); level++)
+    {
+        const CompressedLevel &compressed = out.Levels[level];
+        CompressImage(source, compressed.Width, compressed.Height, channels, out.Format, out.Data.data() + compressed.Offset);
+        if (level + 1 < out.Levels.size())
+        {
+            DownsampleImage(source, compressed.Width, compressed.Height, channels, next_pixels);
+            level_pixels.swap(next_pixels);
+            source = level_pixels.data();
+        }
+    }
+}
+
+}
@@ -0,0 +1,82 @@
+#pragma once
+#ifndef INCLUDED_TEXTURECOMPRESS_H
+#define INCLUDED_TEXTURECOMPRESS_H
+
+#include <cstddef>
+#include <vector>
+
+namespace PV112
+{
+
+/// Block compressed formats of the texture cache. Both store 4x4 pixels in a block, the image is padded to
+/// whole blocks by repeating the last row and column.
+///     - BC1 .. RGB in 8 bytes per block (GL_COMPRESSED_RGB_S3TC_DXT1_EXT), 1/6 of the size of GL_RGB
+///     - BC3 .. RGBA in 16 bytes per block, an interpolated alpha block followed by a BC1 color block
+///              (GL_COMPRESSED_RGBA_S3TC_DXT5_EXT), 1/4 of the size of GL_RGBA
+enum class BlockFormat { BC1, BC3 };
+
+/// A level of a compressed mip chain, a range of CompressedTexture::Data.
+struct CompressedLevel
+{
+    int Width;
+    int Height;
+    size_t Offset;
+    size_t Size;
+};
+
+/// A texture with all levels of its mip chain compressed, from the full image to 1x1.
+struct CompressedTexture
+{
+    BlockFormat Format;
+    std::vector<CompressedLevel> Levels;
+    std::vector<unsigned char> Data;
+};
+
+/// Returns the number of bytes of an image of the given size compressed to 'format'.
+size_t GetCompressedLevelSize(BlockFormat format, int width, int height);
+
+/// Returns the number of levels of a complete mip chain, the size is halved (rounded down) until 1x1.
+int GetMipLevelCount(int width, int height);
+
+/// Returns BC3 if any pixel of an RGBA image is not opaque, BC1 otherwise. Opaque RGBA images and RGB
+/// images do not need the alpha block.
+BlockFormat ChooseBlockFormat(const unsigned char *pixels, int width, int height, int channels);
+
+/// Compresses an image with 'channels' (3 or 4) bytes per pixel and rows without padding. The blocks are
+/// written row by row from the first row of the image, the order glCompressedTexImage2D takes. The rows of
+/// blocks are compressed in parallel (by ParallelFor, so not in a SerialScope), the pixels of a block
+/// are matched with SSE2 where available.
+///
+/// The endpoints of a color block lie on the principal axis of its colors and are refined once by least
+/// squares. The alpha blocks use the smallest and the largest alpha of the block.
+void CompressImage(const unsigned char *pixels, int width, int height, int channels, BlockFormat format, unsigned char *out_blocks);
+
+/// Halves an image with a 2x2 box filter. The last row or column of an odd size is left out, a size of 1 stays 1.
+///
+/// The filter is gamma-correct: the sRGB colors are averaged in linear light and weighted by alpha, alpha
+/// itself is averaged directly. The arithmetic of a pixel runs in SSE2 where available, and the rows are
+/// filtered in parallel like the blocks of CompressImage.
+void DownsampleImage(const unsigned char *pixels, int width, int height, int channels, std::vector<unsigned char> &out_pixels);
+
+/// Creates the levels of the mip chain of an image below the full one, down to 1x1. Each level is filtered
+/// from the previous one by DownsampleImage. The levels depend on each other, only the rows of a level are
+/// filtered in parallel, and in a SerialScope not even those.
+void GenerateMipLevels(const unsigned char *pixels, int width, int height, int channels, std::vector<std::vector<unsigned char> > &out_levels);
+
+/// Resizes an image to any size with a tent filter, gamma-correct and weighted by alpha like DownsampleImage.
+/// Shrinking averages all pixels under a target pixel, enlarging interpolates bilinearly. Target pixels that
+/// are completely transparent are black.
+void ResizeImage(const unsigned char *pixels, int width, int height, int channels, int out_width, int out_height,
+        std::vector<unsigned char> &out_pixels);
+
+/// Compresses an image and all levels of its mip chain, which are filtered by DownsampleImage. The format is
+/// chosen by ChooseBlockFormat.
+void CompressTexture(const unsigned char *pixels, int width, int height, int channels, CompressedTexture &out);
+
+/// Like CompressTexture above, but to the given format, for example to give all layers of a texture array
+/// the same one. Alpha is dropped if the format is BC1.
+void CompressTexture(const unsigned char *pixels, int width, int height, int channels, BlockFormat format, CompressedTexture &out);
+
+}
+
+#endif	// INCLUDED_TEXTURECOMPRESS_H
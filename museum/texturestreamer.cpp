@@ -0,0 +1,156 @@
+#include "texturestreamer.h"
+
+#include <iostream>
+
+namespace PV112
+{
+
+TextureStreamer::TextureStreamer()
+    : buffer_size(0), stopped(false)
+{
+}
+
+bool TextureStreamer::Create(size_t buffer_count, size_t new_buffer_size)
+{
+    if (!buffers.empty() || buffer_count == 0 || new_buffer_size == 0)
+        return false;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    buffers.resize(buffer_count);
+    buffer_size = new_buffer_size;
+    for (size_t i = 0; i < buffers.size(); i++)
+    {
+        StagingBuffer &buffer = buffers[i];
+        buffer.Data = nullptr;
+        buffer.Fence = 0;
+        glGenBuffers(1, &buffer.Buffer);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer.Buffer);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, GLsizeiptr(buffer_size), nullptr, GL_STREAM_DRAW);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        if (!Map(buffer))
+        {
+            std::cout << "Cannot map the texture staging buffers" << std::endl;
+            free_buffers.clear();
+            for (size_t created = 0; created <= i; created++)
+            {
+                glDeleteBuffers(1, &buffers[created].Buffer);
+            }
+            buffers.clear();
+            buffer_size = 0;
+            return false;
+        }
+        free_buffers.push_back(&buffer);
+    }
+    return true;
+}
+
+void TextureStreamer::Destroy()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t i = 0; i < buffers.size(); i++)
+    {
+        StagingBuffer &buffer = buffers[i];
+        if (buffer.Data != nullptr)
+        {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer.Buffer);
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        }
+        if (buffer.Fence != 0)
+            glDeleteSync(buffer.Fence);
+        glDeleteBuffers(1, &buffer.Buffer);
+    }
+    buffers.clear();
+    free_buffers.clear();
+    submitted.clear();
+    buffer_size = 0;
+}
+
+void TextureStreamer::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopped = true;
+    }
+    buffer_freed.notify_all();
+}
+
+TextureStreamer::StagingBuffer *TextureStreamer::Acquire(size_t size)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    if (buffers.empty() || size > buffer_size)
+        return nullptr;
+
+    buffer_freed.wait(lock, [this] { return stopped || !free_buffers.empty(); });
+    if (stopped)
+        return nullptr;
+    StagingBuffer *buffer = free_buffers.back();
+    free_buffers.pop_back();
+    return buffer;
+}
+
+void TextureStreamer::Submit(StagingBuffer *buffer, const std::function<void(const unsigned char *data)> &upload)
+{
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer->Buffer);
+    if (glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_FALSE)
+        std::cout << "Texture staging buffer was corrupted, the texture may be damaged" << std::endl;
+    buffer->Data = nullptr;
+
+    upload(nullptr);
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    buffer->Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    submitted.push_back(buffer);
+}
+
+size_t TextureStreamer::Update()
+{
+    // The GPU finishes the uploads in the order they were submitted. The fences are only queried, the
+    // commands before them are flushed by the swap of the buffers at the end of every frame.
+    size_t finished = 0;
+    while (!submitted.empty())
+    {
+        StagingBuffer *buffer = submitted.front();
+        GLint status = GL_UNSIGNALED;
+        glGetSynciv(buffer->Fence, GL_SYNC_STATUS, 1, nullptr, &status);
+        if (status != GL_SIGNALED)
+            break;
+
+        submitted.pop_front();
+        glDeleteSync(buffer->Fence);
+        buffer->Fence = 0;
+        finished++;
+
+        // Without the buffer, the workers would wait for the others, or forever if it was the last one
+        if (!Map(*buffer))
+        {
+            std::cout << "Cannot map a texture staging buffer, the textures are uploaded from memory" << std::endl;
+            Stop();
+            continue;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            free_buffers.push_back(buffer);
+        }
+        buffer_freed.notify_one();
+    }
+    return finished;
+}
+
+size_t TextureStreamer::BufferSize() const
+{
+    return buffer_size;
+}
+
+bool TextureStreamer::Map(StagingBuffer &buffer)
+{
+    // The fence of the buffer is signaled, so the mapping does not have to synchronize with the GPU. The
+    // old content is not needed, the driver does not have to keep it.
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer.Buffer);
+    buffer.Data = static_cast<unsigned char *>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, GLsizeiptr(buffer_size),
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT));
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    return buffer.Data != nullptr;
+}
+
+}
@@ -0,0 +1,92 @@
+#pragma once
+#ifndef INCLUDED_TEXTURESTREAMER_H
+#define INCLUDED_TEXTURESTREAMER_H
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+
+#include "PV112.h"
+
+namespace PV112
+{
+
+/// Streams the pixels of textures to OpenGL through pixel-unpack buffers, so that the thread with the
+/// OpenGL context neither copies them nor waits until the driver copies them.
+///
+/// The streamer has a few staging buffers of the same size, each of them stays mapped while it is free.
+/// A worker thread (the read step of an AssetLoader) acquires a buffer and writes the pixels to its mapping.
+/// The upload step submits the buffer: it is unmapped and the glTexImage functions read from it, so they
+/// only queue a copy for the GPU. A fence after them tells Update when the copy is finished, the texture is
+/// complete then and the buffer can be mapped again without waiting for the GPU.
+///
+/// Like GeometryArena, the streamer does not delete its buffers by itself, call Destroy while the OpenGL
+/// context exists.
+class TextureStreamer
+{
+public:
+    /// A staging buffer, 'Data' is its mapping while it is acquired
+    struct StagingBuffer
+    {
+        GLuint Buffer;
+        unsigned char *Data;
+        GLsync Fence;
+    };
+
+    TextureStreamer();
+
+    /// Creates 'buffer_count' buffers of 'buffer_size' bytes and maps them. Returns false if the streamer
+    /// already exists or a buffer cannot be mapped.
+    bool Create(size_t buffer_count, size_t buffer_size);
+
+    /// Deletes the buffers, no buffer may be acquired then, or only by upload steps that are never called
+    /// (stop the AssetLoader first). OpenGL deletes the submitted ones only after the uploads from them finish.
+    void Destroy();
+
+    /// Stops handing out buffers, Acquire returns null from now on, also to the threads that are waiting in
+    /// it. Call it before the AssetLoader whose workers acquire the buffers is destroyed, the workers could
+    /// wait for a buffer forever otherwise. It can be called from any thread.
+    void Stop();
+
+    /// Waits until a buffer is free and returns it. Returns null if 'size' is larger than the buffers, or
+    /// the streamer is stopped or not created; the pixels have to be uploaded from memory then. It can be
+    /// called from any thread.
+    StagingBuffer *Acquire(size_t size);
+
+    /// Unmaps an acquired buffer and calls 'upload' while the buffer is bound to GL_PIXEL_UNPACK_BUFFER.
+    /// The pointers passed to the pixel functions are offsets into the buffer then, 'data' is the pointer of
+    /// the offset 0, so 'data' + offset can be passed like a pointer to memory.
+    void Submit(StagingBuffer *buffer, const std::function<void(const unsigned char *data)> &upload);
+
+    /// Maps the buffers whose uploads are finished again and makes them free. Call it once per frame, it
+    /// does not wait for the GPU. Returns the number of finished uploads.
+    size_t Update();
+
+    size_t BufferSize() const;
+
+private:
+    TextureStreamer(const TextureStreamer &);
+    TextureStreamer &operator =(const TextureStreamer &);
+
+    // Maps a buffer for writing, the GPU must not read from it anymore
+    bool Map(StagingBuffer &buffer);
+
+    // Acquired buffers point into this vector, its size does not change until Destroy
+    std::vector<StagingBuffer> buffers;
+    size_t buffer_size;
+
+    // Only the free buffers are shared with the workers, the submitted ones are used only by the thread
+    // with the OpenGL context
+    std::mutex mutex;
+    std::condition_variable buffer_freed;
+    std::vector<StagingBuffer *> free_buffers;
+    bool stopped;
+    std::deque<StagingBuffer *> submitted;
+};
+
+}
+
+#endif	// INCLUDED_TEXTURESTREAMER_H
@@ -0,0 +1,184 @@
+// Compares the vertex fetch of the vertex layouts OBJ models can use: separate buffers per attribute,
+// interleaved floats (VertexLayout::Float), packed interleaved vertices (VertexLayout::Packed), and
+// quantized interleaved vertices (VertexLayout::Quantized).
+//
+// For each layout, it prints the size of the vertex data, the estimated memory traffic of the GPU vertex
+// fetch (see AnalyzeVertexFetch), and the measured throughput of fetching the vertices in the draw order
+// on the CPU, which has the same access pattern as the GPU vertex fetch.
+//
+// Usage: fetchbench [file.obj ...]
+// Build with 'make tools' and run it from the museum directory, lion.obj and cup.obj are used by default.
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <cstring>
+
+#include "mappedfile.h"
+#include "objparser.h"
+#include "meshtools.h"
+
+using namespace std;
+using namespace PV112;
+
+namespace
+{
+
+const int repetitions = 200;
+
+// The sums of the fetched words are stored here, so that the compiler cannot remove the loads
+volatile uint32_t fetch_sink;
+
+// A vertex buffer seen as 32-bit words, the vertex 'v' is at words [v * stride, v * stride + size)
+struct Stream
+{
+    vector<uint32_t> Words;
+    size_t Stride;
+};
+
+template <typename T>
+Stream MakeStream(const T *data, size_t count)
+{
+    Stream stream;
+    stream.Stride = sizeof(T) / sizeof(uint32_t);
+    stream.Words.resize(stream.Stride * count);
+    if (count > 0)
+        memcpy(stream.Words.data(), data, sizeof(T) * count);
+    return stream;
+}
+
+// Reads all words of all streams of every indexed vertex, returns the best time of one draw in seconds
+double MeasureFetch(const vector<Stream> &streams, const vector<unsigned int> &indices)
+{
+    double best = 1e30;
+    for (int r = 0; r < repetitions; r++)
+    {
+        const auto start = chrono::steady_clock::now();
+        uint32_t sum = 0;
+        for (const Stream &stream : streams)
+        {
+            const uint32_t *words = stream.Words.data();
+            const size_t stride = stream.Stride;
+            for (unsigned int index : indices)
+            {
+                const uint32_t *vertex = words + index * stride;
+                for (size_t i = 0; i < stride; i++)
+                    sum += vertex[i];
+            }
+        }
+        const chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+        best = min(best, elapsed.count());
+        fetch_sink = sum;
+    }
+    return best;
+}
+
+void PrintLayout(const char *name, const vector<Stream> &streams, const vector<unsigned int> &indices, size_t vertex_count)
+{
+    vector<size_t> strides;
+    size_t vertex_size = 0;
+    for (const Stream &stream : streams)
+    {
+        strides.push_back(stream.Stride * sizeof(uint32_t));
+        vertex_size += stream.Stride * sizeof(uint32_t);
+    }
+    const VertexFetchStats fetch = AnalyzeVertexFetch(indices.data(), indices.size(), vertex_count, strides.data(), strides.size());
+
+    const double seconds = MeasureFetch(streams, indices);
+    const double vertices_per_second = double(indices.size()) / seconds;
+
+    cout << "  " << left << setw(12) << name << right
+        << setw(4) << vertex_size << " B/vertex, " << setw(5) << vertex_count * vertex_size / 1024 << " KB, GPU fetch "
+        << setw(5) << fetch.BytesFetched / 1024 << " KB (overfetch " << fixed << setprecision(2) << fetch.Overfetch << "), CPU "
+        << setw(7) << setprecision(1) << vertices_per_second * 1e-6 << " Mvertices/s, "
+        << setw(5) << setprecision(2) << vertices_per_second * double(vertex_size) * 1e-9 << " GB/s" << endl;
+}
+
+bool BenchmarkModel(const char *file_name)
+{
+    MappedFile file;
+    OBJData obj;
+    if (!file.Open(file_name) || !ParseOBJData(file.Data(), file.Size(), obj))
+    {
+        cout << "Cannot read OBJ file " << file_name << endl;
+        return false;
+    }
+
+    vector<glm::vec3> positions, normals;
+    vector<glm::vec2> tex_coords;
+    vector<unsigned int> indices;
+    if (!IndexOBJTriangles(obj, positions, normals, tex_coords, indices))
+    {
+        cout << "Invalid indices in OBJ file " << file_name << endl;
+        return false;
+    }
+
+    const size_t vertex_count = positions.size();
+    vector<float> interleaved(vertex_count * 8);
+    for (size_t i = 0; i < vertex_count; i++)
+    {
+        const float vertex[8] = { positions[i].x, positions[i].y, positions[i].z, normals[i].x, normals[i].y, normals[i].z, tex_coords[i].x, tex_coords[i].y };
+        memcpy(&interleaved[i * 8], vertex, sizeof(vertex));
+    }
+    vector<PackedVertex> packed(vertex_count);
+    PackVertices(interleaved.data(), vertex_count, packed.data());
+
+    glm::vec3 bounds_min(0.0f), bounds_max(0.0f);
+    for (size_t i = 0; i < vertex_count; i++)
+    {
+        bounds_min = (i == 0) ? positions[i] : glm::min(bounds_min, positions[i]);
+        bounds_max = (i == 0) ? positions[i] : glm::max(bounds_max, positions[i]);
+    }
+    vector<QuantizedVertex> quantized(vertex_count);
+    QuantizeVertices(interleaved.data(), vertex_count, bounds_min, bounds_max, quantized.data());
+
+    struct Float2 { float Values[2]; };
+    struct Float3 { float Values[3]; };
+    struct Float8 { float Values[8]; };
+    vector<Float3> separate_positions(vertex_count), separate_normals(vertex_count);
+    vector<Float2> separate_tex_coords(vertex_count);
+    for (size_t i = 0; i < vertex_count; i++)
+    {
+        memcpy(separate_positions[i].Values, &interleaved[i * 8 + 0], sizeof(Float3));
+        memcpy(separate_normals[i].Values, &interleaved[i * 8 + 3], sizeof(Float3));
+        memcpy(separate_tex_coords[i].Values, &interleaved[i * 8 + 6], sizeof(Float2));
+    }
+
+    cout << file_name << ": " << vertex_count << " vertices, " << indices.size() / 3 << " triangles" << endl;
+
+    vector<Stream> streams;
+    streams.push_back(MakeStream(separate_positions.data(), vertex_count));
+    streams.push_back(MakeStream(separate_normals.data(), vertex_count));
+    streams.push_back(MakeStream(separate_tex_coords.data(), vertex_count));
+    PrintLayout("3 buffers", streams, indices, vertex_count);
+
+    streams.assign(1, MakeStream(reinterpret_cast<const Float8 *>(interleaved.data()), vertex_count));
+    PrintLayout("Float", streams, indices, vertex_count);
+
+    streams.assign(1, MakeStream(packed.data(), vertex_count));
+    PrintLayout("Packed", streams, indices, vertex_count);
+
+    streams.assign(1, MakeStream(quantized.data(), vertex_count));
+    PrintLayout("Quantized", streams, indices, vertex_count);
+    return true;
+}
+
+}
+
+int main(int argc, char **argv)
+{
+    vector<const char *> files(argv + 1, argv + argc);
+    if (files.empty())
+    {
+        files.push_back("./obj_files/lion.obj");
+        files.push_back("./obj_files/cup.obj");
+    }
+
+    bool all_ok = true;
+    for (const char *file_name : files)
+    {
+        all_ok = BenchmarkModel(file_name) && all_ok;
+    }
+    return all_ok ? 0 : 1;
+}
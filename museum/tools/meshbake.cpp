@@ -0,0 +1,91 @@
+// Creates the .pvmesh caches of OBJ models ahead of time, so that even the first run of the museum loads
+// them without parsing and simplifying, and prints their levels of detail and meshlets.
+//
+// Usage: meshbake [file.obj ...]
+// Build with 'make tools' and run it from the museum directory, all models of the museum are used by default.
+// LoadOBJ creates the same caches when they are missing or out of date, this only moves the work offline.
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "mappedfile.h"
+#include "objparser.h"
+#include "meshcache.h"
+#include "meshbuild.h"
+
+using namespace std;
+using namespace PV112;
+
+namespace
+{
+
+const char *const museum_models[] =
+{
+    "./obj_files/lion.obj",
+    "./obj_files/marble_statue.obj",
+    "./obj_files/cup.obj",
+    "./obj_files/bear.obj",
+    "./obj_files/speaker.obj",
+    "./obj_files/statue.obj",
+    "./obj_files/flat_light.obj",
+    "./obj_files/spotlight.obj",
+    "./obj_files/clocks.obj",
+};
+
+bool BakeModel(const char *file_name)
+{
+    const auto start = chrono::steady_clock::now();
+
+    MappedFile file;
+    OBJData obj;
+    MeshData mesh;
+    if (!file.Open(file_name) || !ParseOBJData(file.Data(), file.Size(), obj) || !BuildOBJMesh(obj, mesh))
+    {
+        cout << "Cannot read OBJ file " << file_name << endl;
+        return false;
+    }
+
+    const string cache_name = GetMeshCacheFileName(file_name);
+    if (!WriteMeshCache(cache_name.c_str(), GetSourceStamp(file), mesh))
+    {
+        cout << "Cannot write mesh cache " << cache_name << endl;
+        return false;
+    }
+
+    const double milliseconds = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    cout << cache_name << " (" << fixed << setprecision(1) << milliseconds << " ms)" << endl;
+    for (size_t level = 0; level < mesh.LODs.size(); level++)
+    {
+        cout << "  LOD " << level << "  triangles " << setw(7) << mesh.LODs[level].IndexCount / 3
+            << ", error " << setprecision(4) << mesh.LODs[level].Error << endl;
+    }
+    cout << "  meshlets " << mesh.Meshlets.size() << ", " << setprecision(1)
+        << (mesh.Meshlets.empty() ? 0.0 : double(mesh.LODs[0].IndexCount / 3) / double(mesh.Meshlets.size())) << " triangles per meshlet" << endl;
+    cout << "  " << (mesh.Closed ? "closed, back faces are culled" : "open, back faces are drawn") << endl;
+    for (size_t i = 0; i < mesh.Submeshes.size(); i++)
+    {
+        const MeshSubmesh &submesh = mesh.Submeshes[i];
+        cout << "  submesh " << setw(2) << i << "  triangles " << setw(7) << submesh.IndexCount[0] / 3
+            << ", material \"" << mesh.Materials[submesh.Material] << "\", \"" << mesh.SubmeshNames[i] << "\"" << endl;
+    }
+    return true;
+}
+
+}
+
+int main(int argc, char **argv)
+{
+    vector<const char *> files(argv + 1, argv + argc);
+    if (files.empty())
+        files.assign(begin(museum_models), end(museum_models));
+
+    bool all_ok = true;
+    for (const char *file_name : files)
+    {
+        all_ok = BakeModel(file_name) && all_ok;
+    }
+    return all_ok ? 0 : 1;
+}
@@ -0,0 +1,169 @@
+// Prints the size of the vertex data and the estimated number of vertex shader invocations of OBJ models,
+// for the de-indexed geometry (glDrawArrays) and the indexed geometry (glDrawElements), and the efficiency
+// of the post-transform vertex cache before and after the triangles are reordered. For the models, it also
+// prints the overdraw before and after OptimizeOverdraw, and the vertex fetch before and after OptimizeVertexFetch.
+//
+// Usage: meshstats [file.obj ...]
+// Build with 'make tools' and run it from the museum directory, all models of the museum and the basic
+// objects are used by default.
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "mappedfile.h"
+#include "objparser.h"
+#include "meshtools.h"
+#include "primitives.h"
+
+using namespace std;
+using namespace PV112;
+
+namespace
+{
+
+const char *const museum_models[] =
+{
+    "./obj_files/lion.obj",
+    "./obj_files/marble_statue.obj",
+    "./obj_files/cup.obj",
+    "./obj_files/bear.obj",
+    "./obj_files/speaker.obj",
+    "./obj_files/statue.obj",
+    "./obj_files/flat_light.obj",
+    "./obj_files/spotlight.obj",
+    "./obj_files/clocks.obj",
+};
+
+// Size of a single vertex, 3 floats of position, 3 of normal, and 2 of texture coordinate
+const size_t vertex_size = sizeof(float) * 8;
+
+// Post-transform cache size used for the estimates
+const unsigned cache_size = 16;
+
+string Percent(double part, double whole)
+{
+    ostringstream s;
+    s << fixed << setprecision(1) << (whole > 0.0 ? 100.0 * (1.0 - part / whole) : 0.0) << " %";
+    return s.str();
+}
+
+// Prints the vertex cache efficiency of the indices as they are, and after OptimizeVertexCache
+void PrintVertexCache(const vector<unsigned int> &triangles, const VertexCacheStats &before, size_t vertex_count)
+{
+    vector<unsigned int> optimized = triangles;
+    OptimizeVertexCache(optimized.data(), optimized.size(), vertex_count, cache_size);
+    const VertexCacheStats after = AnalyzeVertexCache(optimized.data(), optimized.size(), vertex_count, cache_size);
+
+    cout << "  reorder   ACMR " << fixed << setprecision(3) << before.ACMR << " -> " << after.ACMR
+        << ", ATVR " << before.ATVR << " -> " << after.ATVR << ", VS runs " << before.Transformed << " -> " << after.Transformed
+        << ", " << Percent(double(after.Transformed), double(before.Transformed)) << " fewer" << endl;
+}
+
+// Prints the overdraw and the cache efficiency of the cache-optimized indices before and after OptimizeOverdraw,
+// then the vertex fetch efficiency before and after OptimizeVertexFetch
+void PrintOverdrawAndFetch(const vector<glm::vec3> &positions, const vector<glm::vec3> &normals, const vector<glm::vec2> &tex_coords,
+        const vector<unsigned int> &triangles)
+{
+    const size_t vertex_floats = vertex_size / sizeof(float);
+    vector<float> vertices(positions.size() * vertex_floats);
+    for (size_t i = 0; i < positions.size(); i++)
+    {
+        float *vertex = &vertices[i * vertex_floats];
+        vertex[0] = positions[i].x;     vertex[1] = positions[i].y;     vertex[2] = positions[i].z;
+        vertex[3] = normals[i].x;       vertex[4] = normals[i].y;       vertex[5] = normals[i].z;
+        vertex[6] = tex_coords[i].x;    vertex[7] = tex_coords[i].y;
+    }
+
+    vector<unsigned int> indices = triangles;
+    OptimizeVertexCache(indices.data(), indices.size(), positions.size(), cache_size);
+    const VertexCacheStats cache_before = AnalyzeVertexCache(indices.data(), indices.size(), positions.size(), cache_size);
+    const OverdrawStats before = AnalyzeOverdraw(indices.data(), indices.size(), vertices.data(), positions.size(), vertex_floats);
+
+    OptimizeOverdraw(indices.data(), indices.size(), vertices.data(), positions.size(), vertex_floats, 1.05f, cache_size);
+    const VertexCacheStats cache_after = AnalyzeVertexCache(indices.data(), indices.size(), positions.size(), cache_size);
+    const OverdrawStats after = AnalyzeOverdraw(indices.data(), indices.size(), vertices.data(), positions.size(), vertex_floats);
+
+    cout << "  overdraw  " << fixed << setprecision(3) << before.Overdraw << " -> " << after.Overdraw << " (6 views), "
+        << Percent(double(after.Shaded), double(before.Shaded)) << " fewer fragments, ACMR " << cache_before.ACMR << " -> " << cache_after.ACMR << endl;
+
+    const VertexFetchStats fetch_before = AnalyzeVertexFetch(indices.data(), indices.size(), positions.size(), &vertex_size, 1, cache_size);
+    const size_t vertex_count = OptimizeVertexFetch(indices.data(), indices.size(), vertices.data(), positions.size(), vertex_floats);
+    const VertexFetchStats fetch_after = AnalyzeVertexFetch(indices.data(), indices.size(), vertex_count, &vertex_size, 1, cache_size);
+
+    cout << "  fetch     " << fetch_before.BytesFetched / 1024 << " KB -> " << fetch_after.BytesFetched / 1024 << " KB, overfetch "
+        << fetch_before.Overfetch << " -> " << fetch_after.Overfetch << endl;
+}
+
+// The tables are in the order the basic objects are drawn, the reorder shows what OptimizeVertexCache would
+// still gain
+void PrintBasicObject(const char *name, const PrimitiveTables &tables)
+{
+    const vector<unsigned int> triangles(tables.Indices, tables.Indices + tables.IndexCount);
+    const VertexCacheStats before = AnalyzeVertexCache(triangles.data(), triangles.size(), tables.VertexCount, cache_size);
+
+    cout << name << endl;
+    cout << "  triangles " << triangles.size() / 3 << ", vertices " << tables.VertexCount << endl;
+    PrintVertexCache(triangles, before, tables.VertexCount);
+}
+
+bool PrintModel(const char *file_name)
+{
+    MappedFile file;
+    OBJData obj;
+    if (!file.Open(file_name) || !ParseOBJData(file.Data(), file.Size(), obj))
+    {
+        cout << "Cannot read OBJ file " << file_name << endl;
+        return false;
+    }
+
+    vector<glm::vec3> vertices, normals;
+    vector<glm::vec2> tex_coords;
+    vector<unsigned int> indices;
+    if (!IndexOBJTriangles(obj, vertices, normals, tex_coords, indices))
+    {
+        cout << "Invalid indices in OBJ file " << file_name << endl;
+        return false;
+    }
+
+    // Without indices, every corner of every triangle is a separate vertex, and each is transformed
+    const size_t corners = indices.size();
+    const size_t arrays_bytes = corners * vertex_size;
+    const size_t elements_bytes = vertices.size() * vertex_size + indices.size() * sizeof(unsigned int);
+    const VertexCacheStats cache = AnalyzeVertexCache(indices.data(), indices.size(), vertices.size(), cache_size);
+
+    cout << file_name << endl;
+    cout << "  triangles " << corners / 3 << ", vertices " << corners << " -> " << vertices.size() << endl;
+    cout << "  buffers   " << arrays_bytes / 1024 << " KB -> " << elements_bytes / 1024 << " KB (vertices + indices), "
+        << Percent(double(elements_bytes), double(arrays_bytes)) << " smaller" << endl;
+    cout << "  VS runs   " << corners << " -> " << cache.Transformed << " (FIFO " << cache_size << ", ACMR "
+        << fixed << setprecision(3) << cache.ACMR << "), " << Percent(double(cache.Transformed), double(corners)) << " fewer" << endl;
+    PrintVertexCache(indices, cache, vertices.size());
+    PrintOverdrawAndFetch(vertices, normals, tex_coords, indices);
+    return true;
+}
+
+}
+
+int main(int argc, char **argv)
+{
+    vector<const char *> files(argv + 1, argv + argc);
+    if (files.empty())
+    {
+        files.assign(begin(museum_models), end(museum_models));
+        PrintBasicObject("cube", GetCubeTables());
+        for (int level = 0; level < sphere_tessellation_levels; level++)
+            PrintBasicObject(("sphere " + to_string(level)).c_str(), GetSphereTables(level));
+        PrintBasicObject("teapot", GetTeapotTables());
+        PrintBasicObject("rectangle", GetRectangleTables());
+    }
+
+    bool all_ok = true;
+    for (const char *file_name : files)
+    {
+        all_ok = PrintModel(file_name) && all_ok;
+    }
+    return all_ok ? 0 : 1;
+}
@@ -0,0 +1,98 @@
+// Measures the throughput of the OBJ parser with every number parsing kernel the CPU supports.
+//
+// Usage: objbench [file.obj] [repetitions]
+// Build with 'make tools' and run it from the museum directory, lion.obj is parsed by default.
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+#include "mappedfile.h"
+#include "objparser.h"
+
+using namespace std;
+using namespace PV112;
+
+namespace
+{
+
+const char *KernelName(OBJParserKernel kernel)
+{
+    switch (kernel)
+    {
+    case OBJParserKernel::SSE41:    return "SSE4.1";
+    case OBJParserKernel::AVX2:     return "AVX2";
+    default:                        return "scalar";
+    }
+}
+
+template <typename T>
+bool SameBytes(const std::vector<T> &a, const std::vector<T> &b)
+{
+    return a.size() == b.size() && (a.empty() || memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0);
+}
+
+bool SameData(const OBJData &a, const OBJData &b)
+{
+    return SameBytes(a.Vertices, b.Vertices) && SameBytes(a.Normals, b.Normals) &&
+        SameBytes(a.TexCoords, b.TexCoords) && SameBytes(a.Triangles, b.Triangles);
+}
+
+}
+
+int main(int argc, char **argv)
+{
+    const char *file_name = (argc > 1) ? argv[1] : "./obj_files/lion.obj";
+    const int repetitions = (argc > 2) ? max(1, atoi(argv[2])) : 20;
+
+    MappedFile file;
+    if (!file.Open(file_name))
+    {
+        cout << "Cannot open OBJ file " << file_name << endl;
+        return 1;
+    }
+    const double megabytes = double(file.Size()) / (1024.0 * 1024.0);
+    cout << file_name << ": " << fixed << setprecision(2) << megabytes << " MB, best of " << repetitions << " runs" << endl;
+
+    OBJData reference;
+    const OBJParserKernel kernels[] = { OBJParserKernel::Scalar, OBJParserKernel::SSE41, OBJParserKernel::AVX2 };
+    for (OBJParserKernel kernel : kernels)
+    {
+        if (!SetOBJParserKernel(kernel))
+        {
+            cout << setw(8) << KernelName(kernel) << ": not supported by this CPU" << endl;
+            continue;
+        }
+
+        OBJData data;
+        double best = 1e30;
+        for (int i = 0; i < repetitions; i++)
+        {
+            const auto start = chrono::steady_clock::now();
+            const bool ok = ParseOBJData(file.Data(), file.Size(), data);
+            const chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+            if (!ok)
+            {
+                cout << "The file is not a valid OBJ file" << endl;
+                return 1;
+            }
+            best = min(best, elapsed.count());
+        }
+
+        // All kernels must give exactly the same result as the scalar code
+        bool same = true;
+        if (kernel == OBJParserKernel::Scalar)
+            reference = data;
+        else
+            same = SameData(data, reference);
+
+        cout << setw(8) << KernelName(kernel) << ": " << setw(8) << best * 1000.0 << " ms, "
+            << setw(8) << megabytes / best << " MB/s" << (same ? "" : "  (DIFFERENT RESULT)") << endl;
+        if (!same)
+            return 1;
+    }
+
+    return 0;
+}
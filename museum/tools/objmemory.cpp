@@ -0,0 +1,110 @@
+// Measures the peak memory of importing an OBJ file into vertex data, the way ParseOBJFile does it (the
+// mapped file and all expanded vertices at once), the way LoadOBJ does it before building the mesh (the
+// mapped file and the indexed vertices), and the way LoadOBJStreaming does it (a block at a time).
+//
+// Usage: objmemory [file.obj] [expanded|indexed|blocks]
+// Build with 'make tools' and run it from the museum directory, lion.obj is imported in blocks by default.
+// The peak of a process never goes down, so every run measures only one way.
+
+#include <iostream>
+#include <iomanip>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "mappedfile.h"
+#include "objparser.h"
+#include "memoryusage.h"
+
+using namespace std;
+using namespace PV112;
+
+namespace
+{
+
+double Megabytes(size_t bytes)
+{
+    return double(bytes) / (1024.0 * 1024.0);
+}
+
+void PrintPeak(const char *step)
+{
+    cout << "  peak after " << setw(10) << left << step << right << setw(9) << Megabytes(GetPeakMemoryUsage()) << " MB" << endl;
+}
+
+}
+
+int main(int argc, char **argv)
+{
+    const char *file_name = (argc > 1) ? argv[1] : "./obj_files/lion.obj";
+    const char *mode = (argc > 2) ? argv[2] : "blocks";
+    if (strcmp(mode, "expanded") != 0 && strcmp(mode, "indexed") != 0 && strcmp(mode, "blocks") != 0)
+    {
+        cout << "Unknown mode " << mode << ", use expanded, indexed, or blocks" << endl;
+        return 1;
+    }
+
+    cout << fixed << setprecision(1);
+    PrintPeak("start");
+
+    const bool blocks = strcmp(mode, "blocks") == 0;
+    MappedFile file;
+    OBJData obj;
+    bool ok = file.Open(file_name);
+    if (ok && blocks)
+    {
+        // Like LoadOBJStreaming, the mapping is only used for the size of the file, ParseOBJFile and LoadOBJ
+        // parse the mapping
+        FILE *stream = fopen(file_name, "rb");
+        ok = stream != nullptr && ParseOBJStream(stream, 1024 * 1024, obj);
+        if (stream != nullptr)
+            fclose(stream);
+    }
+    else if (ok)
+    {
+        ok = ParseOBJData(file.Data(), file.Size(), obj);
+    }
+    if (!ok)
+    {
+        cout << "Cannot read OBJ file " << file_name << endl;
+        return 1;
+    }
+    cout << file_name << ": " << Megabytes(file.Size()) << " MB, " << obj.Triangles.size() << " triangles, " << mode << endl;
+    PrintPeak("parsing");
+    file.Close();
+
+    size_t vertex_data_size = 0;
+    if (strcmp(mode, "expanded") == 0)
+    {
+        vector<glm::vec3> vertices, normals;
+        vector<glm::vec2> tex_coords;
+        ok = ExpandOBJTriangles(obj, vertices, normals, tex_coords);
+        vertex_data_size = vertices.size() * sizeof(float) * obj_block_vertex_floats;
+    }
+    else if (strcmp(mode, "indexed") == 0)
+    {
+        vector<glm::vec3> vertices, normals;
+        vector<glm::vec2> tex_coords;
+        vector<unsigned int> indices;
+        ok = IndexOBJTriangles(obj, vertices, normals, tex_coords, indices);
+        vertex_data_size = vertices.size() * sizeof(float) * obj_block_vertex_floats + indices.size() * sizeof(unsigned int);
+    }
+    else
+    {
+        // The blocks are only counted, LoadOBJStreaming gives them to glBufferSubData
+        vector<float> block(64 * 1024);
+        ok = ExpandOBJTrianglesInBlocks(obj, block.data(), block.size(), [&](const float *, size_t, size_t count)
+        {
+            vertex_data_size += count * sizeof(float) * obj_block_vertex_floats;
+            return true;
+        });
+    }
+    if (!ok)
+    {
+        cout << "The file has indices out of range" << endl;
+        return 1;
+    }
+    PrintPeak(mode);
+    cout << "  vertex data         " << setw(9) << Megabytes(vertex_data_size) << " MB" << endl;
+    return 0;
+}
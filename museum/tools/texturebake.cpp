@@ -0,0 +1,92 @@
+// Creates the .ktx caches of the textures ahead of time, so that even the first run of the museum uploads
+// compressed textures with their mip chains without decoding, filtering, and compressing the images.
+//
+// Usage: texturebake [image ...]
+// Build with 'make tools' and run it from the museum directory, all textures of the museum are used by default.
+// CreateAndLoadTextureAsync creates the same caches when they are missing or out of date, this only moves
+// the work offline. Only PNG, JPEG, and TGA images are supported, the museum decodes the rest with DevIL.
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "mappedfile.h"
+#include "imagedecode.h"
+#include "texturecache.h"
+#include "texturecompress.h"
+
+using namespace std;
+using namespace PV112;
+
+namespace
+{
+
+const char *const museum_textures[] =
+{
+    "./textures/wall.jpg",
+    "./textures/paving.jpg",
+    "./textures/mona_lisa.jpg",
+    "./textures/painting_frame.png",
+    "./textures/bronze.jpg",
+    "./textures/night_watch_rembrandt.jpg",
+    "./textures/school_of_athens_raphael.jpg",
+    "./textures/fall_of_icarus.jpg",
+    "./textures/water_lilies.jpg",
+    "./textures/wood.jpg",
+    "./textures/cup_tex.jpg",
+    "./textures/glass2.png",
+    "./textures/door.jpg",
+    "./textures/statue_tex.tga",
+    "./textures/ceiling.jpg",
+    "./textures/spotlight_texture.jpg",
+    "./textures/speaker.jpg",
+    "./textures/bear_wood.jpg",
+};
+
+bool BakeTexture(const char *file_name)
+{
+    const auto start = chrono::steady_clock::now();
+
+    MappedFile file;
+    DecodedImage image;
+    if (!file.Open(file_name) ||
+            !DecodeImage(reinterpret_cast<const unsigned char *>(file.Data()), file.Size(), image))
+    {
+        cout << "Cannot read image " << file_name << endl;
+        return false;
+    }
+
+    CompressedTexture texture;
+    CompressTexture(image.Pixels.data(), image.Width, image.Height, image.Channels, texture);
+
+    const string cache_name = GetTextureCacheFileName(file_name);
+    if (!WriteTextureCache(cache_name.c_str(), GetSourceStamp(file), texture))
+    {
+        cout << "Cannot write texture cache " << cache_name << endl;
+        return false;
+    }
+
+    const double milliseconds = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    cout << cache_name << " (" << fixed << setprecision(1) << milliseconds << " ms)" << endl;
+    cout << "  " << image.Width << "x" << image.Height << ", " << (texture.Format == BlockFormat::BC3 ? "BC3" : "BC1")
+        << ", " << texture.Levels.size() << " levels, " << texture.Data.size() << " bytes" << endl;
+    return true;
+}
+
+}
+
+int main(int argc, char **argv)
+{
+    vector<const char *> files(argv + 1, argv + argc);
+    if (files.empty())
+        files.assign(begin(museum_textures), end(museum_textures));
+
+    bool all_ok = true;
+    for (const char *file_name : files)
+    {
+        all_ok = BakeTexture(file_name) && all_ok;
+    }
+    return all_ok ? 0 : 1;
+}
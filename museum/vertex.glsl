@@ -10,16 +10,47 @@ uniform mat3 normal_matrix;
 uniform float tex_repeat_factor_x;
 uniform float tex_repeat_factor_y;
 
+// Decoding of quantized geometries (see SetVertexDecodeUniforms), the defaults leave other vertices as they are
+uniform vec3 position_scale = vec3(1.0);
+uniform vec3 position_offset = vec3(0.0);
+uniform bool octahedral_normal = false;
+
+// Instanced drawing (see renderRectangles): instance gl_InstanceID takes its model matrix and the layer of
+// the texture array from these arrays, 'model_matrix', 'PVM_matrix', and 'normal_matrix' are not used then
+const int max_instances = 8;
+uniform bool instanced = false;
+uniform mat4 PV_matrix;
+uniform mat4 instance_model_matrices[max_instances];
+uniform int instance_layers[max_instances];
+
 out vec3 VS_normal_ws;
 out vec3 VS_position_ws;
 out vec2 VS_tex_coord;
+flat out int VS_layer;
+
+// Unfolds a normal stored in the octahedral encoding in the xy components
+vec3 decode_octahedral(vec2 encoded)
+{
+    vec3 n = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+    float t = max(-n.z, 0.0);
+    n.x += (n.x >= 0.0) ? -t : t;
+    n.y += (n.y >= 0.0) ? -t : t;
+    return n;
+}
 
 void main()
 {
     VS_tex_coord = vec2(tex_repeat_factor_x *  tex_coord.x,
       tex_repeat_factor_y * tex_coord.y);
 
-    VS_position_ws = vec3(model_matrix * position);
-    VS_normal_ws = normalize(normal_matrix * normal);
-    gl_Position = PVM_matrix * position;
+    vec4 model_position = vec4(position.xyz * position_scale + position_offset, position.w);
+    vec3 model_normal = octahedral_normal ? decode_octahedral(normal.xy) : normal;
+
+    mat4 instance_model_matrix = instanced ? instance_model_matrices[gl_InstanceID] : model_matrix;
+    mat3 instance_normal_matrix = instanced ? inverse(transpose(mat3(instance_model_matrix))) : normal_matrix;
+    VS_layer = instanced ? instance_layers[gl_InstanceID] : 0;
+
+    VS_position_ws = vec3(instance_model_matrix * model_position);
+    VS_normal_ws = normalize(instance_normal_matrix * model_normal);
+    gl_Position = instanced ? PV_matrix * (instance_model_matrix * model_position) : PVM_matrix * model_position;
 }
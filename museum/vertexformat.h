@@ -0,0 +1,145 @@
+#pragma once
+#ifndef INCLUDED_VERTEXFORMAT_H
+#define INCLUDED_VERTEXFORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+
+#define GLEW_STATIC
+#include <GL/glew.h>
+
+#include "meshtools.h"
+
+namespace PV112
+{
+
+/// One attribute of an interleaved vertex, as glVertexAttribPointer takes it. 'Size' is the number of
+/// bytes the attribute takes in the vertex, which may be more than the components need (padding).
+template <GLint Components, GLenum Type, GLboolean Normalized, size_t Size>
+struct VertexAttribute
+{
+    static constexpr GLint components = Components;
+    static constexpr GLenum type = Type;
+    static constexpr GLboolean normalized = Normalized;
+    static constexpr size_t size = Size;
+};
+
+typedef VertexAttribute<3, GL_FLOAT, GL_FALSE, 3 * sizeof(float)> Float3Attribute;
+typedef VertexAttribute<2, GL_FLOAT, GL_FALSE, 2 * sizeof(float)> Float2Attribute;
+typedef VertexAttribute<2, GL_HALF_FLOAT, GL_FALSE, 2 * sizeof(uint16_t)> Half2Attribute;
+typedef VertexAttribute<2, GL_SHORT, GL_TRUE, 2 * sizeof(int16_t)> Short2NormAttribute;
+// Three components in four values, the shader gets w = 1
+typedef VertexAttribute<3, GL_UNSIGNED_SHORT, GL_TRUE, 4 * sizeof(uint16_t)> UShort3PaddedNormAttribute;
+// All four components are needed by OpenGL, the shaders use only xyz
+typedef VertexAttribute<4, GL_INT_2_10_10_10_REV, GL_TRUE, sizeof(uint32_t)> Int2101010NormAttribute;
+
+namespace detail
+{
+
+template <typename... Attributes>
+struct AttributeSizeSum;
+
+template <>
+struct AttributeSizeSum<>
+{
+    static constexpr size_t value = 0;
+};
+
+template <typename First, typename... Rest>
+struct AttributeSizeSum<First, Rest...>
+{
+    static constexpr size_t value = First::size + AttributeSizeSum<Rest...>::value;
+};
+
+template <size_t Index, typename... Attributes>
+struct AttributeAt;
+
+template <typename First, typename... Rest>
+struct AttributeAt<0, First, Rest...>
+{
+    typedef First Type;
+    static constexpr size_t offset = 0;
+};
+
+template <size_t Index, typename First, typename... Rest>
+struct AttributeAt<Index, First, Rest...>
+{
+    typedef typename AttributeAt<Index - 1, Rest...>::Type Type;
+    static constexpr size_t offset = First::size + AttributeAt<Index - 1, Rest...>::offset;
+};
+
+}
+
+/// Interleaved vertex with the given attributes in this order, without any gaps between them. The stride
+/// and the offsets are computed by the compiler, so setting up the attributes of a format (see
+/// SetVertexFormatAttributes) needs no layout tables at run time.
+///
+/// The attributes are position, normal, and texture coordinate, in the order of the locations the
+/// functions of PV112.h take. A format may have fewer of them.
+template <typename... Attributes>
+struct VertexFormat
+{
+    static constexpr size_t attribute_count = sizeof...(Attributes);
+    static constexpr size_t stride = detail::AttributeSizeSum<Attributes...>::value;
+
+    /// Attribute<I>::Type is the VertexAttribute, Attribute<I>::offset its offset in bytes
+    template <size_t Index>
+    struct Attribute : detail::AttributeAt<Index, Attributes...>
+    {
+    };
+};
+
+/// The formats of VertexLayout
+typedef VertexFormat<Float3Attribute, Float3Attribute, Float2Attribute> FloatVertexFormat;
+typedef VertexFormat<Float3Attribute, Int2101010NormAttribute, Half2Attribute> PackedVertexFormat;
+typedef VertexFormat<UShort3PaddedNormAttribute, Short2NormAttribute, Half2Attribute> QuantizedVertexFormat;
+
+static_assert(FloatVertexFormat::stride == 8 * sizeof(float), "The float format must match the basic objects");
+static_assert(PackedVertexFormat::stride == sizeof(PackedVertex) &&
+        PackedVertexFormat::Attribute<1>::offset == offsetof(PackedVertex, Normal) &&
+        PackedVertexFormat::Attribute<2>::offset == offsetof(PackedVertex, TexCoord), "The packed format must match PackedVertex");
+static_assert(QuantizedVertexFormat::stride == sizeof(QuantizedVertex) &&
+        QuantizedVertexFormat::Attribute<1>::offset == offsetof(QuantizedVertex, Normal) &&
+        QuantizedVertexFormat::Attribute<2>::offset == offsetof(QuantizedVertex, TexCoord), "The quantized format must match QuantizedVertex");
+
+namespace detail
+{
+
+template <typename Format, size_t Index, size_t Count>
+struct AttributeSetter
+{
+    static void Set(const GLint *locations)
+    {
+        typedef typename Format::template Attribute<Index> Attribute;
+        typedef typename Attribute::Type Type;
+        if (locations[Index] >= 0)
+        {
+            glEnableVertexAttribArray(locations[Index]);
+            glVertexAttribPointer(locations[Index], Type::components, Type::type, Type::normalized, GLsizei(Format::stride),
+                    (const void *)Attribute::offset);
+        }
+        AttributeSetter<Format, Index + 1, Count>::Set(locations);
+    }
+};
+
+template <typename Format, size_t Count>
+struct AttributeSetter<Format, Count, Count>
+{
+    static void Set(const GLint *)
+    {
+    }
+};
+
+}
+
+/// Enables and sets the attributes of 'Format' at 'locations' (one per attribute, -1 skips it) for the
+/// vertex buffer bound to GL_ARRAY_BUFFER. The VAO must be bound.
+template <typename Format>
+void SetVertexFormatAttributes(const GLint *locations)
+{
+    detail::AttributeSetter<Format, 0, Format::attribute_count>::Set(locations);
+}
+
+}
+
+#endif	// INCLUDED_VERTEXFORMAT_H